@@ -3,8 +3,11 @@
 #include <limits>
 #include <numeric>
 #include <algorithm>
+#include <cstdint>
+#include <bit>
 
 #include "misc_utilities/int_type_selection.h"
+#include "misc_utilities/spin_lock.h"
 #include "array_utilities/SectorPackedArray/shared_virtual_memory_types.h"
 
 namespace ArrayUtilities
@@ -38,12 +41,38 @@ namespace ArrayUtilities
 		//how many pages are there left 
 		constexpr page_index_type remaining_page_count() const;
 
+		//number of pages handed out and returned since the last reset, for tracking allocation churn
+		constexpr uint64_t get_allocation_count() const;
+		constexpr uint64_t get_free_count() const;
+
+		//call page_func(page index) for every page handed out or returned since the last call and forget them
+		//lets code that copies or compares the paged data only look at the pages that moved between owners
+		template<typename Tpage_func>
+		void take_changed_pages(Tpage_func&& page_func);
+
+		//call lock_func(lock) on the page lock, it is not page state so code that copies the raw bytes of the header has to go around it
+		template<typename Tlock_func>
+		void for_each_lock(Tlock_func&& lock_func) const;
+
 	private:
 
 		//list of all the memory pages that are not in use 
 		page_index_type free_page_count;
 		std::array<page_index_type, Inumber_of_pages> free_pages;
 
+		//only changed while holding the page lock
+		uint64_t allocation_count;
+		uint64_t free_count;
+
+		//one bit per page set when it is handed out or returned, only changed while holding the page lock
+		std::array<uint64_t, (Inumber_of_pages + 63) / 64> changed_page_bits;
+
+		void mark_page_changed(page_index_type page_index);
+
+		//sectors updated on different worker threads share the same page pool
+		//mutable so the lock can be handed out from a const header
+		mutable MiscUtilities::spin_lock page_lock;
+
 	};
 
 	template<size_t Inumber_of_pages>
@@ -57,26 +86,57 @@ namespace ArrayUtilities
 	{
 		free_page_count = free_pages.size();
 		std::iota(free_pages.rbegin(), free_pages.rend(), 0);
+
+		allocation_count = 0;
+		free_count = 0;
+
+		changed_page_bits.fill(0);
+	}
+
+	template<size_t Inumber_of_pages>
+	inline void paged_memory_header<Inumber_of_pages>::mark_page_changed(page_index_type page_index)
+	{
+		changed_page_bits[page_index / 64] |= uint64_t(1) << (page_index % 64);
 	}
 
 	template<size_t Inumber_of_pages>
 	inline  paged_memory_header<Inumber_of_pages>::page_handle_type paged_memory_header<Inumber_of_pages>::allocate()
 	{
+		MiscUtilities::scoped_spin_lock lock(page_lock);
+
 		//check that there are still pages to create 
 		assert(free_page_count != 0);
 
-		return page_handle(free_pages[--free_page_count]);
+		++allocation_count;
+
+		--free_page_count;
+
+		mark_page_changed(free_pages[free_page_count]);
+
+		return page_handle(free_pages[free_page_count]);
 	}
 
 	template<size_t Inumber_of_pages>
 	inline paged_memory_header<Inumber_of_pages>::page_handle_type paged_memory_header<Inumber_of_pages>::branchless_allocate(bool do_allocation)
 	{
+		//most calls dont need a page, skip the lock and the shared free list entirely for those
+		if (!do_allocation)
+		{
+			return page_handle_type::invalid_page();
+		}
+
+		MiscUtilities::scoped_spin_lock lock(page_lock);
+
 		//check that there are still pages to create 
 		assert(free_page_count != 0 || !do_allocation);
 
 		//optionally decrement the number of free pages 
 		free_page_count -= do_allocation;
 
+		allocation_count += do_allocation;
+
+		mark_page_changed(free_pages[free_page_count]);
+
 		//returns the page if do_allocation is true otherwise it reutns an invalid address 
 		return page_handle(free_pages[free_page_count]);
 	}
@@ -87,6 +147,8 @@ namespace ArrayUtilities
 		//check that the page is valid 
 		assert(default_handle_type.is_valid());
 
+		MiscUtilities::scoped_spin_lock lock(page_lock);
+
 		//check that the page is in the expected range
 		assert(default_handle_type.get_page() < Inumber_of_pages);
 
@@ -98,6 +160,10 @@ namespace ArrayUtilities
 
 		free_pages[free_page_count++] = default_handle_type.get_page();
 
+		++free_count;
+
+		mark_page_changed(default_handle_type.get_page());
+
 		//make the handle invalid 
 		default_handle_type.destroy();
 	}
@@ -108,6 +174,14 @@ namespace ArrayUtilities
 		//check that the page is valid 
 		assert(default_handle_type.is_valid());
 
+		//nothing to return, dont touch the shared free list
+		if (!do_free)
+		{
+			return;
+		}
+
+		MiscUtilities::scoped_spin_lock lock(page_lock);
+
 		//check we have not retuned to many pages 
 		assert(free_page_count <= Inumber_of_pages);
 
@@ -118,6 +192,10 @@ namespace ArrayUtilities
 
 		free_page_count += do_free;
 
+		free_count += do_free;
+
+		mark_page_changed(default_handle_type.get_page());
+
 		//make the handle invalid 
 		default_handle_type.branchless_destroy(do_free);
 	}
@@ -126,4 +204,42 @@ namespace ArrayUtilities
 	{
 		return free_page_count;
 	}
+
+	template<size_t Inumber_of_pages>
+	inline constexpr uint64_t paged_memory_header<Inumber_of_pages>::get_allocation_count() const
+	{
+		return allocation_count;
+	}
+
+	template<size_t Inumber_of_pages>
+	inline constexpr uint64_t paged_memory_header<Inumber_of_pages>::get_free_count() const
+	{
+		return free_count;
+	}
+
+	template<size_t Inumber_of_pages>
+	template<typename Tpage_func>
+	inline void paged_memory_header<Inumber_of_pages>::take_changed_pages(Tpage_func&& page_func)
+	{
+		for (size_t word_index = 0; word_index < changed_page_bits.size(); ++word_index)
+		{
+			uint64_t word = changed_page_bits[word_index];
+
+			while (word)
+			{
+				page_func(static_cast<page_index_type>((word_index * 64) + std::countr_zero(word)));
+
+				word &= word - 1;
+			}
+		}
+
+		changed_page_bits.fill(0);
+	}
+
+	template<size_t Inumber_of_pages>
+	template<typename Tlock_func>
+	inline void paged_memory_header<Inumber_of_pages>::for_each_lock(Tlock_func&& lock_func) const
+	{
+		lock_func(page_lock);
+	}
 }
\ No newline at end of file
@@ -116,7 +116,7 @@ namespace ArrayUtilities
 			}
 
 			//postfix plus
-			virtual_address& operator++(int)
+			virtual_address operator++(int)
 			{
 				virtual_address temp{ address };
 
@@ -125,9 +125,9 @@ namespace ArrayUtilities
 				return temp;
 			}
 
-			virtual_address& operator--(int)
+			virtual_address operator--(int)
 			{
-				virtual_address_value_type temp{ address };
+				virtual_address temp{ address };
 
 				--address;
 
@@ -33,18 +33,18 @@ namespace ArrayUtilities
 			}
 
 			//postfix plus
-			virtual_address<Taddress_type>& operator++(int)
+			virtual_address<Taddress_type> operator++(int)
 			{
-				Taddress_type temp{ address };
+				virtual_address<Taddress_type> temp{ address };
 
 				++address;
 
 				return temp;
 			}
 
-			virtual_address<Taddress_type>& operator--(int)
+			virtual_address<Taddress_type> operator--(int)
 			{
-				Taddress_type temp{ address };
+				virtual_address<Taddress_type> temp{ address };
 
 				--address;
 
@@ -2,6 +2,7 @@
 #include <assert.h>
 #include <array>
 #include <limits>
+#include <algorithm>
 #include "misc_utilities/int_type_selection.h"
 #include "../base_types_definition.h"
 #include "vector_2d_math_utils/byte_vector_2d.h"
@@ -91,13 +92,28 @@ namespace ArrayUtilities
 	
 		//the start of any unused nodes 
 		TLinkType free_list_start;
+
+		//number of nodes from the start of the array that have ever been handed out
+		//returned nodes are reused first so everything past this is still how the free list setup left it
+		uint32 node_high_water_mark;
 	
 		//all the nodes 
 		std::array<wide_node<node_width, TLinkType, TDataType>, node_count > nodes;
+
+		//a range of bytes from the start of the list
+		struct byte_range
+		{
+			size_t start;
+			size_t size;
+		};
 	
 		//constructor
 		constexpr wide_node_linked_list();
 
+		//the parts of the list that can be different to a freshly reset list, the nodes up to and just past the high water mark
+		//and the last node which closes the free loop and has its links rewritten as nodes are taken and returned
+		std::array<byte_range, 2> get_written_byte_ranges() const;
+
 		//reset the state to of the linked list
 		void reset();
 
@@ -194,6 +210,19 @@ namespace ArrayUtilities
 		reset();
 	}
 
+	template<size_t root_node_count, typename TLinkType, size_t node_count, size_t node_width, typename TDataType>
+	inline std::array<typename wide_node_linked_list<root_node_count, TLinkType, node_count, node_width, TDataType>::byte_range, 2> wide_node_linked_list<root_node_count, TLinkType, node_count, node_width, TDataType>::get_written_byte_ranges() const
+	{
+		size_t nodes_start = static_cast<size_t>(reinterpret_cast<const char*>(nodes.data()) - reinterpret_cast<const char*>(this));
+
+		//taking the node at the high water mark rewrites the parent link of the one after it
+		size_t written_node_count = std::min<size_t>(static_cast<size_t>(node_high_water_mark) + 1, node_count);
+
+		return {
+			byte_range{ 0, nodes_start + (written_node_count * sizeof(nodes[0])) },
+			byte_range{ nodes_start + ((node_count - 1) * sizeof(nodes[0])), sizeof(nodes[0]) } };
+	}
+
 	template<size_t root_node_count, typename TLinkType, size_t node_count, size_t node_width, typename TDataType>
 	inline void wide_node_linked_list<root_node_count, TLinkType, node_count, node_width, TDataType>::reset()
 	{
@@ -230,6 +259,8 @@ namespace ArrayUtilities
 		//nodes are organized in a loop so removing a node is the same even if its the first or last node
 		free_list_start = 0;
 
+		node_high_water_mark = 0;
+
 		//do the first node
 		nodes[0].free_node_data.node_links.child_node = 1;
 		nodes[0].free_node_data.node_links.parent_node = node_count - 1;
@@ -355,6 +386,8 @@ namespace ArrayUtilities
 	
 		//store the free node
 		TLinkType free_node = free_list_start;
+
+		node_high_water_mark = std::max<uint32>(node_high_water_mark, static_cast<uint32>(free_node) + 1);
 	
 		//update the free list start
 		free_list_start = nodes[free_node].free_node_data.node_links.child_node;
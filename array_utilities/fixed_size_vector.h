@@ -2,6 +2,7 @@
 
 
 #include <array>
+#include <algorithm>
 #include <assert.h>
 #include "misc_utilities/int_type_selection.h"
 
@@ -19,6 +20,13 @@ namespace ArrayUtilities
         using iterator = typename std::array<Tdata_type, Isize>::iterator;
         using const_iterator = typename std::array<Tdata_type, Isize>::const_iterator;
 
+        //a range of bytes from the start of the list
+        struct byte_range
+        {
+            std::size_t start;
+            std::size_t size;
+        };
+
         // Constructors
         fixed_size_vector_array() = default;
         fixed_size_vector_array(std::initializer_list<Tdata_type> initList) 
@@ -91,6 +99,18 @@ namespace ArrayUtilities
             size_ = 0;
         }
 
+        //the bytes holding the first entry_count entries and the bytes holding the size
+        //lets code that copies or compares the list skip the entries that are not in use
+        //the entry after the last one is included as the optional push backs write to it without adding it
+        std::array<byte_range, 2> get_byte_ranges(std::size_t entry_count) const
+        {
+            std::size_t size_start = static_cast<std::size_t>(reinterpret_cast<const char*>(&size_) - reinterpret_cast<const char*>(this));
+
+            return {
+                byte_range{ static_cast<std::size_t>(reinterpret_cast<const char*>(data_.data()) - reinterpret_cast<const char*>(this)), std::min(entry_count + 1, Isize) * sizeof(Tdata_type) },
+                byte_range{ size_start, sizeof(*this) - size_start } };
+        }
+
 
     private:
         std::array<Tdata_type, Isize> data_;
@@ -45,6 +45,9 @@ namespace ArrayUtilities
 		// the address type we use to translate a handle index to a index in the packed arrays
 		using virtual_combined_node_adderss_type = paged_array_type::virtual_combined_node_adderss_type;
 
+		// the address of an item inside a single y axis
+		using virtual_y_axis_node_adderss_type = paged_array_type::virtual_y_axis_node_adderss_type;
+
 		//max possible entries needed by the system to support the paged array setup
 		static constexpr size_t max_total_entries = paged_array_type::max_total_entries;
 
@@ -72,6 +75,13 @@ namespace ArrayUtilities
 
 		const tight_packed_array_type& get_tight_packed_data() const { return tight_packed_data; };
 
+		//raw array for one of the fields in the reference struct, the field index is its position in get_as_tuple
+		template<size_t Ifield_index>
+		auto& get_field_array() { return std::get<Ifield_index>(tight_packed_data.get_packed_data().tuple_of_arrays); };
+
+		//find where the data for a handle currently lives
+		real_address_type get_real_address(Thandle_type handle) const;
+
 		address_return_type insert(Thandle_type handle, x_axis_type x_index_to_add_to);
 
 		//change where a handle is pointing to and get a ref struct so the data can be overwritten;
@@ -90,10 +100,21 @@ namespace ArrayUtilities
 		//used when moving data arround instead of adding or removing 
 		void update_handle_address(Thandle_type handle, virtual_combined_node_adderss_type address);
 
+		//swap the data and handles of 2 items in the same y axis and repoint both handles
+		void swap_in_axis(x_axis_type x_index, virtual_y_axis_node_adderss_type y_address_a, virtual_y_axis_node_adderss_type y_address_b);
+
 		reference_tuple_type get_ref_tuple(auto address);
 
 		handle_reference_wrapper get(auto address);
 
+		//call range_func(start pointer, byte count) for every part of this container that can have been written since the last call
+		template<typename Trange_func>
+		void take_written_byte_ranges(Trange_func&& range_func);
+
+		//call lock_func(lock) on every lock in the container
+		template<typename Tlock_func>
+		void for_each_lock(Tlock_func&& lock_func) const;
+
 #pragma region Iterators
 
 #pragma endregion
@@ -205,6 +226,33 @@ namespace ArrayUtilities
 
 	}
 
+	template<typename Thandle_type, size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Treference_struct>
+	inline void handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::swap_in_axis(x_axis_type x_index, virtual_y_axis_node_adderss_type y_address_a, virtual_y_axis_node_adderss_type y_address_b)
+	{
+		handle_reference_wrapper ref_a = get(tight_packed_data.resolve_address(x_index, y_address_a));
+		handle_reference_wrapper ref_b = get(tight_packed_data.resolve_address(x_index, y_address_b));
+
+		//the tuples hold references so this swaps the underlying data including the handles
+		auto tuple_a = ref_a.get_as_tuple();
+		auto tuple_b = ref_b.get_as_tuple();
+
+		tuple_a.swap(tuple_b);
+
+		//point the handles at their new homes
+		handle_to_data_lookup[ref_a.handle.get_index()] = paged_array_type::convert_from_y_axis_to_combined_virtual_address(x_index, y_address_a);
+		handle_to_data_lookup[ref_b.handle.get_index()] = paged_array_type::convert_from_y_axis_to_combined_virtual_address(x_index, y_address_b);
+	}
+
+	template<typename Thandle_type, size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Treference_struct>
+	inline handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::real_address_type
+		handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::get_real_address(Thandle_type handle) const
+	{
+		//lookup the address of the data
+		virtual_combined_node_adderss_type virtual_address = handle_to_data_lookup[handle.get_index()];
+
+		return tight_packed_data.resolve_address(virtual_address);
+	}
+
 	template<typename Thandle_type, size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Treference_struct>
 	inline handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::reference_tuple_type 
 		handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::get_ref_tuple(auto address)
@@ -232,4 +280,21 @@ namespace ArrayUtilities
 		return  struct_of_arrays_helper<handle_reference_wrapper>::create_ref_struct_from_tuple(get_ref_tuple(address));
 	}
 
+	template<typename Thandle_type, size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Treference_struct>
+	template<typename Trange_func>
+	inline void handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::take_written_byte_ranges(Trange_func&& range_func)
+	{
+		//the handle lookup is indexed by handle so any entry can change, it is small enough to always hand out whole
+		range_func(static_cast<const void*>(&handle_to_data_lookup), sizeof(handle_to_data_lookup));
+
+		tight_packed_data.take_written_byte_ranges(range_func);
+	}
+
+	template<typename Thandle_type, size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Treference_struct>
+	template<typename Tlock_func>
+	inline void handle_tracked_2d_paged_array<Thandle_type, Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Treference_struct>::for_each_lock(Tlock_func&& lock_func) const
+	{
+		tight_packed_data.for_each_lock(lock_func);
+	}
+
 }
\ No newline at end of file
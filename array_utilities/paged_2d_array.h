@@ -139,6 +139,15 @@ namespace ArrayUtilities
 
 		//clear all items in the entire array
 		void clear_all_axis();
+
+		//call range_func(first real address, item count) for every run of addresses that can have been written since the last call
+		//that is every item each y axis has held since then that still has a page and every page handed out or returned since then
+		template<typename Trange_func>
+		void take_written_address_ranges(Trange_func&& range_func);
+
+		//call lock_func(lock) on every lock in the header
+		template<typename Tlock_func>
+		void for_each_lock(Tlock_func&& lock_func) const;
 		
 		//the maximum number of items neede for all pages 
 		static constexpr size_t max_total_entries = max_pages * Ipage_size;
@@ -153,6 +162,9 @@ namespace ArrayUtilities
 		//todo make private 
 		std::array<y_axis_count_type, Inumber_of_x_axis_items> y_axis_count = {};
 
+		//the most items each y axis has held since take_written_address_ranges was last called
+		std::array<y_axis_count_type, Inumber_of_x_axis_items> y_axis_high_water = {};
+
 		const std::array<y_axis_virtual_memory_map_type, Inumber_of_x_axis_items>& get_y_axis_memory_map() const;
 	private:
 		combined_address_virtual_memory_map_type& get_all_axis_memory_map_internal();
@@ -593,7 +605,7 @@ namespace ArrayUtilities
 
 				//doing this because visual studio cant assert :(
 				if (page_address_and_count.page_start_address.address >= max_total_entries ||
-					page_address_and_count.items_in_page >= Ipage_size ||
+					page_address_and_count.items_in_page > Ipage_size ||
 					page_address_and_count.virtual_page_start_address.address >= combined_address_virtual_memory_map_type::max_virtual_address
 					)
 				{
@@ -816,6 +828,8 @@ namespace ArrayUtilities
 		//increment the axis count
 		y_axis_count[x_axis_index]++;
 
+		y_axis_high_water[x_axis_index] = std::max(y_axis_high_water[x_axis_index], y_axis_count[x_axis_index]);
+
 		//check we have not exceeded the y axis count limit
 		assert(new_y_address.address < Imax_y_items);
 
@@ -847,6 +861,8 @@ namespace ArrayUtilities
 		//increment the address count
 		++y_axis_count[x_axis_index];
 
+		y_axis_high_water[x_axis_index] = std::max(y_axis_high_water[x_axis_index], y_axis_count[x_axis_index]);
+
 		//convert to combined 
 		auto combined_address_to_push_to = convert_from_y_axis_to_combined_virtual_address(x_axis_index, y_address_to_push_to);
 		
@@ -928,6 +944,8 @@ namespace ArrayUtilities
 
 		//can now safely set the new axis size 
 		y_axis_count[x_axis_index] = new_y_axis_count;
+
+		y_axis_high_water[x_axis_index] = std::max(y_axis_high_water[x_axis_index], new_y_axis_count);
 	}
 
 	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size>
@@ -984,6 +1002,45 @@ namespace ArrayUtilities
 		}
 	}
 
+	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size>
+	template<typename Trange_func>
+	inline void paged_2d_array_header<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size>::take_written_address_ranges(Trange_func&& range_func)
+	{
+		for (x_axis_count_type ix = 0; ix < y_axis_count.size(); ++ix)
+		{
+			//only the pages the axis still has can be looked up, the ones it gave back are in the changed pages below
+			size_t page_count = (static_cast<size_t>(y_axis_count[ix]) + (Ipage_size - 1)) / Ipage_size;
+
+			for (size_t ipage = 0; ipage < page_count; ++ipage)
+			{
+				size_t page_start = ipage * Ipage_size;
+
+				if (page_start >= y_axis_high_water[ix])
+				{
+					break;
+				}
+
+				real_node_address_type first_address = virtual_memory_lookup[ix].resolve_address(virtual_y_axis_node_adderss_type{ static_cast<decltype(virtual_y_axis_node_adderss_type::address)>(page_start) });
+
+				range_func(first_address, std::min<size_t>(Ipage_size, y_axis_high_water[ix] - page_start));
+			}
+
+			y_axis_high_water[ix] = y_axis_count[ix];
+		}
+
+		paged_memory_tracker.take_changed_pages([&](auto page_index)
+			{
+				range_func(real_node_address_type{ static_cast<typename real_node_address_type::address_value_type>(static_cast<size_t>(page_index) * Ipage_size) }, static_cast<size_t>(Ipage_size));
+			});
+	}
+
+	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size>
+	template<typename Tlock_func>
+	inline void paged_2d_array_header<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size>::for_each_lock(Tlock_func&& lock_func) const
+	{
+		paged_memory_tracker.for_each_lock(lock_func);
+	}
+
 	
 	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size>
 	inline const std::array<typename paged_2d_array_header<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size>::y_axis_virtual_memory_map_type, Inumber_of_x_axis_items>& 
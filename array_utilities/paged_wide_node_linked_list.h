@@ -315,8 +315,13 @@ namespace ArrayUtilities
 		//list of active nodes in each root group
 		std::array< active_root_group_nodes_tracker, number_of_root_groups> active_root_node_tracker;
 
+		//set when a node in the page is written, a page only ever belongs to one root group so root groups on different threads never share a flag
+		std::array<bool, total_pages> is_page_written;
+
 #pragma endregion
 
+		void mark_node_page_written(node_link_type node_address);
+
 
 		void add_root_node_to_active_nodes(root_entry_group_address_type root_group, root_entry_address_type root_node_index);
 
@@ -349,6 +354,18 @@ namespace ArrayUtilities
 
 		constexpr page_handle_with_root_value_type empty_page_count() const;
 
+		//the pool the node pages come from
+		constexpr const paged_memory_header<total_pages>& get_page_header() const;
+
+		//call range_func(start pointer, byte count) for every part of the list that can have been written since the last call
+		//only the pages of nodes that were written are handed out, everything else is small enough to hand out whole
+		template<typename Trange_func>
+		void take_written_byte_ranges(Trange_func&& range_func);
+
+		//call lock_func(lock) on every lock in the list
+		template<typename Tlock_func>
+		void for_each_lock(Tlock_func&& lock_func) const;
+
 
 		struct itterator
 		{
@@ -640,6 +657,8 @@ namespace ArrayUtilities
 		//this can probably be stripped out in shipping
 		nodes[address_of_node_to_return].mark_as_free();
 
+		mark_node_page_written(address_of_node_to_return);
+
 		//get the page the node is in
 		page_handle_with_root_nodes_type return_node_page(address_of_node_to_return >> node_page_bitshift);
 
@@ -844,6 +863,9 @@ namespace ArrayUtilities
 		//the memory page header is setup by default but we are resetting it in case we are resetting the entire date structure mid sim
 		page_header.reset();
 
+		//every node was just written
+		is_page_written.fill(true);
+
 		//reset all the root node pointers
 		std::for_each(root_node_ptrs.begin(), root_node_ptrs.end(), [&](auto& root_ptr)
 			{
@@ -903,6 +925,8 @@ namespace ArrayUtilities
 		//copy across the data
 		nodes[root_node_data.write_node].active_node_data.data[index_in_node] = data;
 
+		mark_node_page_written(root_node_data.write_node);
+
 		//update the write index
 		root_node_data.write_index = index_in_node;
 	}
@@ -933,6 +957,8 @@ namespace ArrayUtilities
 				//copy across lead value
 				nodes[active_node].active_node_data.data[active_node_read_index] = nodes[write_node_index].active_node_data.data[first_node_entry_index];
 
+				mark_node_page_written(active_node);
+
 				//check if write node is empty 
 				if (!first_node_entry_index)
 				{
@@ -1050,6 +1076,49 @@ namespace ArrayUtilities
 		return page_header.remaining_page_count();
 	}
 
+	template<typename Tdatatype, size_t Iroot_entries_count, size_t Inode_width, size_t Imax_entries_per_root, size_t Imax_entries_per_root_group, size_t Imax_global_entries, size_t Ipage_size, size_t Iroot_node_group_size>
+	inline constexpr const paged_memory_header<paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, Iroot_node_group_size>::total_pages>&
+		paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, Iroot_node_group_size>::get_page_header() const
+	{
+		return page_header;
+	}
+
+	template<typename Tdatatype, size_t Iroot_entries_count, size_t Inode_width, size_t Imax_entries_per_root, size_t Imax_entries_per_root_group, size_t Imax_global_entries, size_t Ipage_size, size_t Iroot_node_group_size>
+	inline void paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, Iroot_node_group_size>::mark_node_page_written(node_link_type node_address)
+	{
+		is_page_written[node_address >> node_page_bitshift] = true;
+	}
+
+	template<typename Tdatatype, size_t Iroot_entries_count, size_t Inode_width, size_t Imax_entries_per_root, size_t Imax_entries_per_root_group, size_t Imax_global_entries, size_t Ipage_size, size_t Iroot_node_group_size>
+	template<typename Trange_func>
+	inline void paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, Iroot_node_group_size>::take_written_byte_ranges(Trange_func&& range_func)
+	{
+		//pages handed back to the pool had their last node written when it was returned so they are already flagged
+		page_header.take_changed_pages([](auto) {});
+
+		for (size_t ipage = 0; ipage < total_pages; ++ipage)
+		{
+			if (is_page_written[ipage])
+			{
+				range_func(static_cast<const void*>(&nodes[ipage * Ipage_size]), Ipage_size * sizeof(wide_node));
+			}
+		}
+
+		is_page_written.fill(false);
+
+		range_func(static_cast<const void*>(&page_meta_linked_list), sizeof(page_meta_linked_list));
+		range_func(static_cast<const void*>(&page_header), sizeof(page_header));
+		range_func(static_cast<const void*>(&root_node_ptrs), sizeof(root_node_ptrs));
+		range_func(static_cast<const void*>(&active_root_node_tracker), sizeof(active_root_node_tracker));
+	}
+
+	template<typename Tdatatype, size_t Iroot_entries_count, size_t Inode_width, size_t Imax_entries_per_root, size_t Imax_entries_per_root_group, size_t Imax_global_entries, size_t Ipage_size, size_t Iroot_node_group_size>
+	template<typename Tlock_func>
+	inline void paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, Iroot_node_group_size>::for_each_lock(Tlock_func&& lock_func) const
+	{
+		page_header.for_each_lock(lock_func);
+	}
+
 	template<typename Tdatatype, size_t Iroot_entries_count, size_t Inode_width, size_t Imax_entries_per_root, size_t Imax_entries_per_root_group, size_t Imax_global_entries, size_t Ipage_size, size_t Iroot_node_group_size>
 	inline paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, 
 		Iroot_node_group_size>::itterator paged_wide_node_linked_list<Tdatatype, Iroot_entries_count, Inode_width, Imax_entries_per_root, Imax_entries_per_root_group, Imax_global_entries, Ipage_size, Iroot_node_group_size>::get_root_node_start(root_entry_address_type root_node_index)
@@ -72,6 +72,9 @@ namespace ArrayUtilities
 		//get a const version of the paged array for external access 
 		const paged_array_type& get_array_header() const { return paged_array_header; };
 
+		//get the raw arrays so batched code can work directly on the struct of arrays
+		container_type& get_packed_data() { return packed_data; };
+
 		//add an item to the paged array
 		address_return_type add_item_to_paged_array_unsafe(x_axis_type x_index_to_add_to);
 
@@ -99,6 +102,14 @@ namespace ArrayUtilities
 		//move data from one x address to another 
 		address_return_type move(x_axis_type x_index_move_to, auto address);
 
+		//call range_func(start pointer, byte count) for the header and every part of the packed arrays that can have been written since the last call
+		template<typename Trange_func>
+		void take_written_byte_ranges(Trange_func&& range_func);
+
+		//call lock_func(lock) on every lock in the container
+		template<typename Tlock_func>
+		void for_each_lock(Tlock_func&& lock_func) const;
+
 	};
 	
 	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size,typename Tcontainer>
@@ -180,15 +191,19 @@ namespace ArrayUtilities
 	inline tight_packed_paged_2d_array_manager<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Tcontainer>::real_address_type 
 		tight_packed_paged_2d_array_manager<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Tcontainer>::remove_item_from_paged_array(x_axis_type x_index_to_remove_from, real_address_type address_to_remove)
 	{
-		//reduce the number of elelments in the list and get the address of the last entry
-		auto replacment_element_address = paged_array_header.pop_back_and_return_address(x_index_to_remove_from);
+		//get the address of the last entry
+		real_address_type replacment_element_address = paged_array_header.find_address(x_index_to_remove_from, virtual_y_axis_node_adderss_type(paged_array_header.y_axis_count[x_index_to_remove_from] - 1));
 
 		//use iterators to get the last and first addresses
-		replace_remove_internal(packed_data, std::get<0>(replacment_element_address), address_to_remove);
+		//copy before the pop, the pop can hand the last page back to the shared pool where another sector updating on a different thread can take it
+		replace_remove_internal(packed_data, replacment_element_address, address_to_remove);
+
+		//reduce the number of elelments in the list
+		paged_array_header.pop_back(x_index_to_remove_from);
 
 		//return the address of the items moved 
 		//this is so other systems can update the index of tracked data
-		return std::get<0>(replacment_element_address);
+		return replacment_element_address;
 	}
 
 	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Tcontainer>
@@ -254,5 +269,28 @@ namespace ArrayUtilities
 		return address_of_new_data;
 	}
 
+	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Tcontainer>
+	template<typename Trange_func>
+	inline void tight_packed_paged_2d_array_manager<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Tcontainer>::take_written_byte_ranges(Trange_func&& range_func)
+	{
+		paged_array_header.take_written_address_ranges([&](real_address_type first_address, size_t item_count)
+			{
+				std::apply([&](auto&... arrays)
+					{
+						(range_func(static_cast<const void*>(&arrays[first_address.address]), item_count * sizeof(arrays[0])), ...);
+					}, packed_data.tuple_of_arrays);
+			});
+
+		//the take above changes the tracking in the header so it is handed out last
+		range_func(static_cast<const void*>(&paged_array_header), sizeof(paged_array_header));
+	}
+
+	template<size_t Inumber_of_x_axis_items, size_t Imax_y_items, size_t Imax_total_y_items, size_t Ipage_size, typename Tcontainer>
+	template<typename Tlock_func>
+	inline void tight_packed_paged_2d_array_manager<Inumber_of_x_axis_items, Imax_y_items, Imax_total_y_items, Ipage_size, Tcontainer>::for_each_lock(Tlock_func&& lock_func) const
+	{
+		paged_array_header.for_each_lock(lock_func);
+	}
+
 	
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 //
 
 #include <iostream>
-#include "misc_utilities/delata_time_util.h"
+#include <cstdlib>
 
 //#include "array_utilities/WideNodeLinkedList/UnitTests/wide_node_linked_list_unit_tests.h"
 //#include "array_utilities/UnitTests/unit_test_manager.h"
@@ -13,44 +13,77 @@
 #include "continuous_collision_library/2d_physics_main.h"
 
 #include "continuous_collision_library/UnitTests/PhysicsMain/phyisics_2d_main_unit_test.h"
-
-int main()
+#include "continuous_collision_library/Benchmarks/runtime_world_benchmark.h"
+#include "continuous_collision_library/Benchmarks/k_nearest_benchmark.h"
+#include "continuous_collision_library/Benchmarks/scenario_generator.h"
+#include "continuous_collision_library/Benchmarks/phase_timing_benchmark.h"
+
+//usage: continious_collision_prototype_headless [scenario name] [seed] [measured steps] [json output path] [trace output path]
+//the trace is only written when built with ENABLE_PROFILE_ZONES
+int main(int argc, char* argv[])
 {
     std::cout << "Starting Test!\n";
 
-    std::cout << "Making Physics System\n";
     using physics_main_type = ContinuousCollisionLibrary::phyisics_2d_main<std::numeric_limits<ContinuousCollisionLibrary::uint16>::max() - 1,16>;
     //using physics_main_type = phyisics_2d_main<254, 16>;
 
-   
-    std::unique_ptr<physics_main_type> physics_main = std::make_unique<physics_main_type>();
-
     //std::cout << "Running Tests\n";
     //test the physics system
     //ContinuousCollisionLibrary::phyisics_2d_main_unit_test::run_test();
 
+    //check the runtime sized world steps as fast as the templated one
+    //ContinuousCollisionLibrary::runtime_world_benchmark::run_benchmark();
+
+    //check the spiral k nearest search against brute force
+    //ContinuousCollisionLibrary::k_nearest_benchmark::run_benchmark();
+
+    //pick the scene from the command line so runs can be repeated exactly
+    ContinuousCollisionLibrary::phase_timing_benchmark::benchmark_settings settings;
+
+    settings.scenario.collider_count = std::numeric_limits<ContinuousCollisionLibrary::uint16>::max() - 1;
+
+    if (argc > 1 && !ContinuousCollisionLibrary::scenario_generator::try_get_type_from_name(argv[1], settings.scenario.type))
+    {
+        std::cout << "Unknown scenario " << argv[1] << ", options are:\n";
+
+        for (std::string_view name : ContinuousCollisionLibrary::scenario_generator::scenario_names)
+        {
+            std::cout << "    " << name << "\n";
+        }
 
-    //setup the physics library 
-    //setup_physics_main();
+        return 1;
+    }
 
-    std::cout << "Spawning all items\n";
-    //setup physics 
-    physics_main->setup_physics_random(std::numeric_limits<ContinuousCollisionLibrary::uint16>::max() - 1, 200);
+    if (argc > 2)
+    {
+        settings.scenario.seed = static_cast<ContinuousCollisionLibrary::uint32>(std::strtoul(argv[2], nullptr, 10));
+    }
+
+    if (argc > 3)
+    {
+        settings.measured_steps = static_cast<ContinuousCollisionLibrary::uint32>(std::strtoul(argv[3], nullptr, 10));
+    }
 
-    static constexpr int itterations = 100;
+    const char* json_path = argc > 4 ? argv[4] : "phase_timings.json";
 
-    std::cout << "Starting Stepping System\n";
+    //step the scene and write the min, median and p99 of each phase
+    bool was_written = ContinuousCollisionLibrary::phase_timing_benchmark::run_benchmark<physics_main_type>(settings, json_path);
 
-    //run in loop for x number of steps
-    for (int i = 0; i < itterations; ++i)
+    if (argc > 5)
     {
-        std::cout << "calculatingStep! " << i << " \n";
-        //update the physics 
-        physics_main->update_physics();
+#if defined(ENABLE_PROFILE_ZONES)
+        //the rings only hold the last few steps, which is what the timeline needs
+        was_written &= MiscUtilities::profile_zone_recorder::write_chrome_trace(argv[5]);
+
+        std::cout << "Wrote trace " << argv[5] << "\n";
+#else
+        std::cout << "Build with ENABLE_PROFILE_ZONES to write a trace\n";
+#endif
     }
 
     std::cout << "TestFinished!\n";
 
+    return was_written ? 0 : 1;
 }
 
 // Run program: Ctrl + F5 or Debug > Start Without Debugging menu
@@ -3,6 +3,16 @@
 #include <algorithm>
 #include <tuple>
 #include <set>
+#include <span>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <vector>
 
 #include "vector_2d_math_utils/rect_types.h"
 #include "vector_2d_math_utils/rect_template.h"
@@ -14,8 +24,16 @@
 #include "misc_utilities/bits_needed_for_unsigned_int.h"
 #include "misc_utilities/grid_function_helper.h"
 #include "misc_utilities/grid_utilities.h"
+#include "misc_utilities/parallel_job_scheduler.h"
+#include "misc_utilities/profile_zones.h"
+#include "misc_utilities/spin_lock.h"
 
+#include "continuous_collision_library/physics_numeric_policy.h"
+#include "continuous_collision_library/physics_stats.h"
 #include "continuous_collision_library/overlap_tracking_grid.h"
+#include "continuous_collision_library/swept_circle_time_of_impact.h"
+#include "continuous_collision_library/collider_integration_kernel.h"
+#include "continuous_collision_library/spiral_indexing_lookup_table.h"
 #include "array_utilities/fixed_free_list.h"
 #include "array_utilities/paged_2d_array.h"
 #include "array_utilities/handle_tracked_2d_paged_array.h"
@@ -33,12 +51,21 @@
 
 namespace ContinuousCollisionLibrary
 {
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	class physics_rollback_buffer;
+
+	//Tnumeric_policy picks the number type the colliders are stored and stepped with, see physics_numeric_policy.h
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy = float_numeric_policy>
 	class phyisics_2d_main
 	{
-		using phyisics_2d_main_type = phyisics_2d_main<Imax_objects, Iworld_sector_x_count>;
+		using phyisics_2d_main_type = phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>;
 		
 	public:
+		//number type used for positions, velocities and radii
+		using scalar_type = typename Tnumeric_policy::scalar_type;
+
+		using scalar_vec2d = math_2d_util::template_vector_2d<scalar_type>;
+
 		//definition of the target dimensions of the grid system
 		using grid_dimension_type = SectorGrid::sector_grid_dimensions<Iworld_sector_x_count, 16>;
 	private:
@@ -60,7 +87,7 @@ namespace ContinuousCollisionLibrary
 
 		static constexpr size_t bits_needed_to_store_handle_count = MiscUtilities::bits_needed_to_represent_number(Imax_objects);
 		
-		float time_step = 1.0f / 60.0f;
+		scalar_type time_step = Tnumeric_policy::from_float(1.0f / 60.0f);
 
 	public:
 		//temp handle type definition
@@ -73,20 +100,28 @@ namespace ContinuousCollisionLibrary
 		//the system to manage all the handles and data lookup addresses 
 		handle_data_lookup_system_type handle_manager;
 
+		//set when a handle is handed out and cleared when it goes back to the free list, indexed by handle index
+		//the handle lookup keeps the old address of removed colliders so this is what stops a stale handle being used
+		std::array<bool, Imax_objects> is_handle_index_live = {};
+
 		struct collision_data_ref
 		{
-			float& x;
-			float& y;
+			scalar_type& x;
+			scalar_type& y;
 			
-			float& velocity_x;
-			float& velocity_y;
+			scalar_type& velocity_x;
+			scalar_type& velocity_y;
+
+			//impulse gathered by the solver, this is added to the velocity and cleared at the end of every solver iteration
+			scalar_type& impulse_x;
+			scalar_type& impulse_y;
 						
-			float& radius;
+			scalar_type& radius;
 
 
 			auto get_as_tuple()
 			{
-				return std::tie(x, y, velocity_x, velocity_y, radius);
+				return std::tie(x, y, velocity_x, velocity_y, impulse_x, impulse_y, radius);
 			}
 
 			//auto get_as_tuple()
@@ -105,6 +140,41 @@ namespace ContinuousCollisionLibrary
 		//data for all the items in the grid
 		collision_data_container_type collision_data_container;
 
+		//index of each value in collision_data_ref::get_as_tuple, used to get the raw arrays for the batched functions
+		enum class collision_data_field : size_t
+		{
+			X,
+			Y,
+			VELOCITY_X,
+			VELOCITY_Y,
+			IMPULSE_X,
+			IMPULSE_Y,
+			RADIUS,
+			HANDLE //added on the end by the handle tracked array
+		};
+
+		template<collision_data_field Ifield>
+		std::span<scalar_type> get_collision_data_field()
+		{
+			return collision_data_container.template get_field_array<static_cast<size_t>(Ifield)>();
+		}
+
+		std::span<handle_type> get_collision_data_handles()
+		{
+			return collision_data_container.template get_field_array<static_cast<size_t>(collision_data_field::HANDLE)>();
+		}
+
+		//the queries, setup and debug draw work in floats, these move values in and out of the simulation number type
+		static scalar_vec2d to_scalar_vector(math_2d_util::fvec2d value)
+		{
+			return scalar_vec2d(Tnumeric_policy::from_float(value.x), Tnumeric_policy::from_float(value.y));
+		}
+
+		static math_2d_util::fvec2d to_float_vector(scalar_type x, scalar_type y)
+		{
+			return math_2d_util::fvec2d(Tnumeric_policy::to_float(x), Tnumeric_policy::to_float(y));
+		}
+
 	public:
 
 		//buffer for new data to add to the grid
@@ -118,11 +188,11 @@ namespace ContinuousCollisionLibrary
 			handle_type owner;
 
 		public:
-			math_2d_util::fvec2d position;
+			scalar_vec2d position;
 
-			math_2d_util::fvec2d velocity;
+			scalar_vec2d velocity;
 
-			float radius;
+			scalar_type radius;
 
 			auto get_as_tuple()
 			{
@@ -132,7 +202,7 @@ namespace ContinuousCollisionLibrary
 			new_collider_data() {}
 
 		private:
-			new_collider_data(handle_type _owner, math_2d_util::fvec2d _position, math_2d_util::fvec2d _velocity, float _radius) :owner(_owner), position(_position), velocity(_velocity), radius(_radius)
+			new_collider_data(handle_type _owner, scalar_vec2d _position, scalar_vec2d _velocity, scalar_type _radius) :owner(_owner), position(_position), velocity(_velocity), radius(_radius)
 			{
 
 			}
@@ -144,17 +214,277 @@ namespace ContinuousCollisionLibrary
 		//buffer to hold all data being added to the grid 
 		using new_collider_header_type = ArrayUtilities::paged_2d_array_header < sector_count, Imax_objects, Imax_objects, page_size_for_collider_data>;
 
-		using new_collider_data_containter_type = std::array<new_collider_data, new_collider_header_type::max_total_entries>;
+		//colliders waiting to be added bucketed by the sector they are going into
+		struct new_collider_buffer
+		{
+			new_collider_header_type header;
+			std::array<new_collider_data, new_collider_header_type::max_total_entries> data;
+
+			//call range_func(start pointer, byte count) for every part of the buffer that can have been written since the last call
+			template<typename Trange_func>
+			void take_written_byte_ranges(Trange_func&& range_func)
+			{
+				header.take_written_address_ranges([&](auto first_address, size_t item_count)
+					{
+						range_func(static_cast<const void*>(&data[first_address.address]), item_count * sizeof(new_collider_data));
+					});
+
+				//the take above changes the tracking in the header so it is handed out last
+				range_func(static_cast<const void*>(&header), sizeof(header));
+			}
+
+			//call lock_func(lock) on every lock in the buffer
+			template<typename Tlock_func>
+			void for_each_lock(Tlock_func&& lock_func) const
+			{
+				header.for_each_lock(lock_func);
+			}
+		};
 
-		new_collider_header_type collider_to_add_header;
-		new_collider_data_containter_type colliders_to_add_data;
+		new_collider_buffer colliders_to_add;
 		
 		//which sectors have items queued to be added into the game
 		//the extra +1 is because we are using branchless write and need that extra space for writes we are discarding
 		ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1> sectors_with_queued_items;
 
-		//sector_count_type number_of_active_sectors;
-		//std::array<sector_count_type, max_sectors_internal> active_sectors;
+		//handles of colliders queued to be removed, the sector is only looked up once the adds have run
+		//so colliders queued to be added in the same update can be removed as well
+		ArrayUtilities::fixed_size_vector_array<handle_type, Imax_objects> queued_removals;
+
+		//the queued removals bucketed by the sector they are in, only filled and used inside remove_items_from_all_sectors
+		new_collider_header_type collider_to_remove_header;
+		std::array<handle_type, new_collider_header_type::max_total_entries> colliders_to_remove_data;
+
+		//which sectors have items queued to be removed
+		//the extra +1 is because we are using branchless write and need that extra space for writes we are discarding
+		ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1> sectors_with_queued_removals;
+
+		//stops the same collider getting queued for removal twice, indexed by handle index
+		std::array<bool, Imax_objects> is_queued_for_removal = {};
+
+	public:
+
+		enum class motion_command_type : uint8_t
+		{
+			SET_VELOCITY,
+			ADD_FORCE
+		};
+
+		//a velocity or force change for a collider queued from game logic
+		struct motion_command
+		{
+			handle_type handle;
+			motion_command_type type;
+			scalar_type x;
+			scalar_type y;
+		};
+
+		//most motion commands that can be queued between updates, enough for 2 commands per collider
+		static constexpr uint32_t max_motion_commands = Imax_objects * 2;
+
+	private:
+
+		ArrayUtilities::fixed_size_vector_array<motion_command, max_motion_commands> queued_motion_commands;
+
+		//a queued command with the address of the collider it applies to, sorting by address turns the writes into a sweep through memory
+		struct resolved_motion_command
+		{
+			uint32_t address;
+			uint32_t command_index;
+
+			bool operator<(const resolved_motion_command& other) const
+			{
+				//commands for the same collider keep the order they were queued in
+				return (address < other.address) || ((address == other.address) && (command_index < other.command_index));
+			}
+		};
+
+		std::array<resolved_motion_command, max_motion_commands> resolved_motion_commands;
+
+		//where the commands for each sector start in the resolved command array
+		std::array<uint32_t, grid_dimension_type::sector_grid_count + 1> motion_command_sector_start;
+
+		//sectors with at least one motion command this update
+		ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1> sectors_with_motion_commands;
+
+		//sort the queued commands by sector then address
+		void sort_motion_commands();
+
+		//apply the sorted commands for a sector and wake any sleeping colliders they touched
+		void apply_motion_commands_in_sector(sector_count_type sector_index);
+
+		//apply all the queued motion commands
+		void apply_all_motion_commands();
+
+	public:
+
+		//most long range transfers that can be queued between updates, enough to move every collider once
+		static constexpr uint32_t max_long_range_transfers = Imax_objects;
+
+	private:
+
+		//a collider being moved to anywhere in the world, the normal sector transfers can only move things one sector over
+		struct long_range_transfer
+		{
+			handle_type handle;
+			scalar_vec2d position;
+		};
+
+		ArrayUtilities::fixed_size_vector_array<long_range_transfer, max_long_range_transfers> queued_long_range_transfers;
+
+		//stops the same collider getting queued twice, cleared when a queued collider is removed before it can be moved, indexed by handle index
+		std::array<bool, Imax_objects> is_queued_for_long_range_transfer = {};
+
+		//a collider waiting to be moved to another sector outside of the sector transfer buffers
+		struct pending_sector_move
+		{
+			handle_type handle;
+
+			//the tile the collider is held under in the tile tracker, not always the tile it is in now
+			math_2d_util::ivec2d from_tile;
+
+			scalar_vec2d to_position;
+		};
+
+		//every collider can only be moved once per pass so this can never fill up
+		static constexpr uint32_t max_pending_sector_moves = Imax_objects;
+
+		//shared by the long range transfer queue and the colliders that spill out of a full sector transfer buffer
+		//workers add to it at the same time by bumping the count, it is empty again once apply_pending_sector_moves has run
+		std::array<pending_sector_move, max_pending_sector_moves> pending_sector_moves;
+		std::atomic<uint32_t> pending_sector_move_count = 0;
+
+		//safe to call from any worker
+		void push_pending_sector_move(const pending_sector_move& move);
+
+		//the colliders leaving each sector, bucketed by the sector they are in now
+		std::array<pending_sector_move, max_pending_sector_moves> sector_moves_by_source;
+		std::array<uint32_t, grid_dimension_type::sector_grid_count + 1> sector_move_source_start;
+
+		//the data for the colliders entering each sector, bucketed by the sector they are moving to
+		std::array<new_collider_data, max_pending_sector_moves> sector_moves_by_destination;
+		std::array<uint32_t, grid_dimension_type::sector_grid_count + 1> sector_move_destination_start;
+
+		//sectors with at least one collider leaving or entering through a pending move
+		ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1> sectors_with_move_departures;
+		ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1> sectors_with_move_arrivals;
+
+		//copy the pending moves into the source and destination buckets
+		void sort_pending_sector_moves(uint32_t move_count);
+
+		//take the colliders leaving the sector out of its data and tiles, their handles are kept
+		void remove_move_departures_from_sector(sector_count_type sector_index, uint32_t worker_index);
+
+		//write all the colliders entering the sector into one block of space at the end of it
+		void add_move_arrivals_to_sector(sector_count_type sector_index, uint32_t worker_index);
+
+		//move every pending collider in one batched pass and empty the pool, returns the number moved
+		//sets the active state of the sectors it touched but leaves the active sector lists for the caller to refresh
+		uint32_t apply_pending_sector_moves();
+
+		//move all the queued long range transfers in one batched pass
+		void apply_all_long_range_transfers();
+
+	public:
+
+		//a circle to find colliders in
+		struct circle_query
+		{
+			math_2d_util::fvec2d center;
+			float radius = 0.0f;
+		};
+
+		//most queries sorted at once by the batched queries, bigger batches get split into chunks this size
+		static constexpr uint32_t max_queries_per_batch = 8192;
+
+		//the first collider a ray hit, the handle is invalid if nothing was hit
+		struct raycast_hit
+		{
+			handle_type handle = handle_type::get_invalid_index();
+			float distance = 0.0f;
+		};
+
+		//a line from start to end swept with a radius, the ignored collider is skipped so colliders can cast from their own center
+		struct segment_query
+		{
+			math_2d_util::fvec2d start;
+			math_2d_util::fvec2d end;
+			float radius = 0.0f;
+			handle_type ignore_handle = handle_type::get_invalid_index();
+		};
+
+		//most neighbours a single k nearest query can return
+		static constexpr uint32_t max_k_nearest = 64;
+
+		//how many rings of tiles out from the query point the k nearest search looks before giving up
+		static constexpr uint32_t k_nearest_max_ring = 32;
+
+		//a point to find the nearest colliders to, the ignored collider is skipped so colliders can search around themselves
+		struct k_nearest_query
+		{
+			math_2d_util::fvec2d point;
+			handle_type ignore_handle = handle_type::get_invalid_index();
+		};
+
+	private:
+
+		//tile offsets around the query tile sorted by ring so the k nearest search walks outwards
+		using k_nearest_spiral_type = spiral_offset_lookup_table<k_nearest_max_ring>;
+
+		//query indexes of the current batch chunk sorted by the sector the query starts in
+		std::array<uint32_t, max_queries_per_batch> sorted_query_indexes;
+
+		//where the queries for each sector start in the sorted query array
+		std::array<uint32_t, grid_dimension_type::sector_grid_count + 1> query_sector_start;
+
+		//sectors with at least one query in the current batch chunk
+		ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1> sectors_with_queries;
+
+		//walk all the tiles a query rect could touch and call the test on the colliders in them, tiles are rejected using the overlap grid bounds
+		//so empty tiles and tiles whose colliders dont reach the query never touch the collider data
+		template<typename Tcollider_test>
+		uint32_t query_tiles(const math_2d_util::frect& query_bounds, std::span<handle_type> out_handles, Tcollider_test&& is_touching);
+
+		//walk the tiles along a ray with a dda and return the closest hit within max distance, the direction must be normalized
+		//each visited tile tests the colliders of the nearby tiles whose bounds reach into it so big colliders centred off the ray are still hit
+		raycast_hit cast_ray(math_2d_util::fvec2d origin, math_2d_util::fvec2d direction, float max_distance, float radius, handle_type ignore_handle);
+
+		//sort a batch of queries by the sector their position is in and run them in parallel, each query only writes to its own slice of the output
+		template<typename Tget_query_position, typename Trun_query>
+		void run_query_batch(uint32_t query_count, Tget_query_position&& get_query_position, Trun_query&& run_query);
+
+		//bitmap of all the sectors with colliders in them, only updated from the main thread between the parallel passes
+		static constexpr uint32_t active_sector_bitmap_word_count = (max_sectors_internal + 63) / 64;
+
+		using sector_bitmap_type = std::array<uint64_t, active_sector_bitmap_word_count>;
+
+		sector_bitmap_type active_sector_bitmap = {};
+
+		//the active sectors as a list, rebuilt from the bitmap after anything that can change it
+		sector_count_type number_of_active_sectors = 0;
+		std::array<sector_count_type, max_sectors_internal> active_sectors;
+
+		//active sectors split up by colour so the coloured passes dont need to visit empty sectors
+		std::array<ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1>, 9> active_sectors_by_colour;
+
+		//the active sectors and every sector next to them, these are the only sectors that can have something transfered into them
+		sector_count_type number_of_active_and_neighbouring_sectors = 0;
+		std::array<sector_count_type, max_sectors_internal> active_and_neighbouring_sectors;
+
+		//set or clear the bit for a sector
+		static void set_sector_bit(sector_bitmap_type& bitmap, uint32_t sector_index, bool value);
+
+		//write the index of every set bit to the out array and return how many there were
+		static uint32_t sector_bitmap_to_list(const sector_bitmap_type& bitmap, sector_count_type* out_sectors);
+
+		//set the bit for a sector and every sector next to it
+		static void set_sector_and_neighbour_bits(sector_bitmap_type& bitmap, uint32_t sector_index);
+
+		//mark the sector as active or inactive based on if it has any colliders in it
+		void update_sector_active_state(sector_count_type sector_index);
+
+		//rebuild the active sector lists from the bitmap
+		void refresh_active_sector_lists();
 
 		using overlap_tracking_grid_type = overlap_tracking_grid<grid_dimension_type>;
 
@@ -173,6 +503,27 @@ namespace ContinuousCollisionLibrary
 		//agent lookup
 		per_tile_collider_list_type colliders_in_tile_tracker;
 
+		//one bit per tile in the same order as the tile tracker, set when the bounds of the tile might have changed so the bounds pass only looks at these
+		//a sector owns whole words so the per sector passes can set bits in their own sector without locking
+		static constexpr uint32_t dirty_tile_bitmap_word_count = (grid_dimension_type::tile_count + 63) / 64;
+
+		static_assert((grid_dimension_type::sector_tile_count % 64) == 0, "each sector needs to own whole words of the dirty tile bitmap");
+
+		std::array<uint64_t, dirty_tile_bitmap_word_count> dirty_tile_bitmap = {};
+
+		//the swept bounds each collider had the last time its tile bounds were worked out
+		//the integration pass checks against these to find the tiles that need their bounds worked out again
+		std::array<math_2d_util::irect, Imax_objects> swept_bounds_per_collider;
+
+		//flag the tile bounds to be worked out again in the next bounds pass
+		void mark_tile_bounds_dirty(uint32_t world_tile_index);
+
+		//after loading or rolling back the bounds caches dont match the colliders any more so work everything out again
+		void mark_all_tile_bounds_dirty();
+
+		//the tiles a collider covers over its next step, the same integer bounds the tile bounds are built from
+		math_2d_util::irect calculate_swept_bounds(scalar_type x, scalar_type y, scalar_type velocity_x, scalar_type velocity_y, scalar_type radius) const;
+
 
 		//transfer buffer types for each sector
 		enum class transfer_buffer_types : uint8_t
@@ -189,6 +540,7 @@ namespace ContinuousCollisionLibrary
 		static constexpr uint32_t number_of_transfer_buffers = grid_dimension_type::sector_grid_count * static_cast<uint32_t>(transfer_buffer_types::COUNT);
 
 		//node width, assuming average unit is the size of a tile the worst case for a single frame is 16 units  
+		//kept small so the buffers stay in cache, anything past this in a frame spills into pending_sector_moves
 		static constexpr uint32_t transfer_buffer_size = grid_dimension_type::sector_w * 2;
 
 		//transfer buffers per sector
@@ -202,6 +554,9 @@ namespace ContinuousCollisionLibrary
 			//maximum number of object that can be transfered into a single sector normally
 			static constexpr uint32_t max_item_transfer = static_cast<uint32_t>(transfer_buffer_types::COUNT) * transfer_buffer_size;
 
+			//a sector can take a full buffer from every neighbour, the 4 diagonal neighbours each send from their other buffer
+			static constexpr uint32_t max_items_entering = static_cast<uint32_t>(MiscUtilities::grid_directions::COUNT) * transfer_buffer_size;
+
 			template<transfer_buffer_types buffer>
 			ArrayUtilities::fixed_size_vector_array<new_collider_data, transfer_buffer_size>& get_ref_to_buffer()
 			{
@@ -262,11 +617,11 @@ namespace ContinuousCollisionLibrary
 		//temp buffer for moving objects from one sector to another 
 		std::array<sector_transfer_buffers, grid_dimension_type::sector_grid_count> sector_transfer_buffer_groups;
 
-		//temp buffer 
+		//temp buffer, holds the addresses of the items leaving and then any space reserved for items entering so has to fit the larger of the two
 		std::array<
 			ArrayUtilities::fixed_size_vector_array<
 				std::tuple<typename collision_data_container_type::real_address_type, typename collision_data_container_type::virtual_combined_node_adderss_type>,
-				sector_transfer_buffers::max_item_transfer >, 
+				std::max(sector_transfer_buffers::max_item_transfer, sector_transfer_buffers::max_items_entering) >, 
 			grid_dimension_type::sector_grid_count> sector_transfer_removal_address_groups;
 
 
@@ -275,384 +630,3229 @@ namespace ContinuousCollisionLibrary
 		using tile_change_tuple_type = std::tuple<handle_type, math_2d_util::ivec2d, math_2d_util::ivec2d>;
 
 
-		ArrayUtilities::fixed_size_vector_array< sector_change_tuple_type, collision_data_container_type::paged_array_type::page_size> items_exiting_sector;
-		ArrayUtilities::fixed_size_vector_array< tile_change_tuple_type, collision_data_container_type::paged_array_type::page_size> items_changing_tile;
+		//scratch buffers used while moving a sector, one set per worker so sectors can be moved in parallel
+		struct sector_update_scratch_buffers
+		{
+			//these are filled and emptied one page at a time so can never hold more than a page of colliders
+			ArrayUtilities::fixed_size_vector_array< sector_change_tuple_type, collision_data_container_type::paged_array_type::page_size> items_exiting_sector;
+			ArrayUtilities::fixed_size_vector_array< tile_change_tuple_type, collision_data_container_type::paged_array_type::page_size> items_changing_tile;
 
+			//per collider values for the page being moved, indexed by the offset in the page
+			//the tile the collider was in before this pass moved it
+			std::array<uint32, collision_data_container_type::paged_array_type::page_size> old_tile_x_in_page;
+			std::array<uint32, collision_data_container_type::paged_array_type::page_size> old_tile_y_in_page;
 
-		public:
+			//offsets from the first awake collider in the page of the colliders that changed tile, the integration kernel writes whole registers so it needs some room past the end
+			std::array<uint32, collision_data_container_type::paged_array_type::page_size + collider_integration_kernel::simd_width> changed_tile_in_page;
 
-		//try add a handle to the simulation
-		handle_type try_queue_item_to_add( new_collider_data&& data_for_new_collider);
+			//fraction of a full step the collider moves this pass, 0 if it has already done all its sub steps
+			std::array<scalar_type, collision_data_container_type::paged_array_type::page_size> move_fraction_in_page;
 
-		private:
+			//1 / the number of sub steps the collider is split into
+			std::array<scalar_type, collision_data_container_type::paged_array_type::page_size> sub_step_fraction_in_page;
 
-		//add all the queued items for a sector into the physics system 
-		void add_items_from_sector(sector_count_type sector_index);
+			//counters this worker has added up during the step, summed into the step stats at the end
+			physics_stats step_stats;
+		};
 
-		void add_collider_data_to_sector_data(const new_collider_data& data_to_add, sector_count_type sector_index);
+	public:
+		//the most worker threads the per sector update can be split across
+		static constexpr uint32_t max_worker_count = 32;
 
-		void add_collider_handle_to_tile_tracker(const new_collider_data& data_to_add);
+		//the parts of update_physics that are timed separately
+		enum class update_phase : uint8_t
+		{
+			ADD,
+			MOTION_COMMANDS,
+			TIME_OF_IMPACT,
+			REMOVE,
+			LONG_RANGE_TRANSFER,
+			INTEGRATE, //moving colliders and finding the ones changing tile or sector
+			TRANSFER, //moving colliders between sectors, any extra sub step passes and refreshing the active sector lists
+			BOUNDS,
+			PAIRS,
+			SOLVE,
+			SLEEP,
+			COUNT
+		};
 
-		//add all the new items 
-		void add_items_from_all_sectors();
+		static constexpr uint32_t update_phase_count = static_cast<uint32_t>(update_phase::COUNT);
 
-		//update the grid overlap system
-		void update_bounds_in_sector(sector_count_type sector_index);
+		using update_phase_times = std::array<std::chrono::steady_clock::duration, update_phase_count>;
 
-		//update the bounds in all sectors 
-		void update_bounds_in_all_sectors();
+	private:
 
-		//move all objects in sector 
-		void update_positions_in_sector(sector_count_type sector_index);
+		std::array<sector_update_scratch_buffers, max_worker_count> per_worker_scratch_buffers;
 
-		//copy all objects that have left the sector to the sector transfer buffer
-		template<typename Tedge_info>
-		void transfer_items_between_sectors(sector_count_type sector_index);
+		//worker pool used to run the per sector update functions
+		MiscUtilities::parallel_job_scheduler job_scheduler;
 
-		//move all objects in the world
-		void update_all_positions();
+		//how long each phase of the last update took
+		update_phase_times last_update_phase_times = {};
 
-		public:
-		//add queued items 
-		void update_physics();
+		//when the phase currently running started
+		std::chrono::steady_clock::time_point phase_start_time;
 
-		//debug draw tool
-		void draw_debug(debug_draw_interface& draw_interface);
+		//store the time since the last phase ended as the time this phase took
+		void end_update_phase(update_phase phase);
 
+		//the stats from the last update
+		physics_stats last_step_stats;
 
-		//do a simple setup of the physics
-		void setup_physics_simple();
+		//add the overlap changes from one tile bounds update to the workers stats
+		void add_bounds_update_to_stats(uint32_t worker_index, const typename overlap_tracking_grid_type::bounds_update_counts& counts);
 
-		//do a more complicated random setup
-		void setup_physics_random(uint32_t number_to_spawn, float max_velocity);
+		//grid direction of the move from one sector to its neighbour
+		static uint32_t get_sector_transfer_direction(const math_2d_util::ivec2d& from_tile, const math_2d_util::ivec2d& to_tile);
 
+		//total pages handed out and returned by the collider data and tile tracker page pools
+		uint64_t get_page_allocation_count() const;
+		uint64_t get_page_free_count() const;
 
-	};
+		//sum the per worker counters and measure the sectors into last_step_stats
+		void gather_step_stats(uint64_t page_allocations_at_start, uint64_t page_frees_at_start);
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void ContinuousCollisionLibrary::phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::setup_physics_simple()
-	{
-		new_collider_data colider_to_add01;
+		//sectors are coloured in a 3x3 pattern, sectors with the same colour are never neighbours and never share a neighbour
+		//so anything that only writes to its own sector and the sectors directly around it can be run on all sectors of one colour at once
+		static constexpr uint32_t sector_colour_stride = 3;
+		static constexpr uint32_t sector_colour_count = sector_colour_stride * sector_colour_stride;
 
-		colider_to_add01.position = math_2d_util::fvec2d(0.9f);
-		colider_to_add01.velocity = math_2d_util::fvec2d(0.0f);
+		static_assert(sector_colour_count == std::tuple_size<decltype(active_sectors_by_colour)>::value);
 
-		colider_to_add01.radius = 0.5f;
+		static uint32_t get_sector_colour(sector_count_type sector_index);
 
-		new_collider_data colider_to_add02;
+		//run func(sector_index, worker_index) on every sector in the list, only use for functions that dont write to neighbouring sectors
+		template<typename Tsector_func>
+		void run_on_sectors(std::span<const sector_count_type> sectors, Tsector_func&& sector_func);
 
+		//run func(sector_index, worker_index) on every sector with colliders in it
+		template<typename Tsector_func>
+		void run_on_active_sectors(Tsector_func&& sector_func);
 
-		colider_to_add02.position = math_2d_util::fvec2d(16.1f);
-		colider_to_add02.velocity = math_2d_util::fvec2d(-69.0f);
+		//run func(sector_index, worker_index) on every sector with colliders in it one colour at a time
+		template<typename Tsector_func>
+		void run_on_active_sectors_coloured(Tsector_func&& sector_func);
 
-		colider_to_add02.radius = 1.0f;
+		//run func(sector_index, worker_index) on every sector in the list one colour at a time, for lists that are not the active sectors
+		template<typename Tsector_func>
+		void run_on_sectors_coloured(std::span<const sector_count_type> sectors, Tsector_func&& sector_func);
 
-		//queue up a new item 
-		auto colider_handle01 = try_queue_item_to_add(std::move(colider_to_add01));
-		auto colider_handle02 = try_queue_item_to_add(std::move(colider_to_add02));
-	}
+	public:
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void ContinuousCollisionLibrary::phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::setup_physics_random(uint32_t number_to_spawn, float max_velocity)
-	{
-		for (uint32_t i = 0; i < number_to_spawn; ++i)
+		//two colliders that are touching or close enough that they could touch during the next step
+		struct collider_pair
 		{
-			new_collider_data colider_to_add;
-
-			constexpr float big_unit_percent = 0.75f;
+			handle_type collider_a;
+			handle_type collider_b;
+		};
 
-			constexpr float unit_min = 0.5f;
-			
-			constexpr float small_unit_max = 1.5f;
+		//max number of collider pairs stored per sector per step, any more than this get counted but dropped
+		static constexpr uint32_t max_collider_pairs_per_sector = 4096;
 
-			constexpr float big_unit_max = 5;
+		//the extra +1 is because we are using branchless write and need that extra space for writes we are discarding
+		using collider_pair_buffer_type = ArrayUtilities::fixed_size_vector_array<collider_pair, max_collider_pairs_per_sector + 1>;
 
-			//choose if its a small or big unit
-			bool is_big = (static_cast<float>(rand()) / RAND_MAX) > 0.75f;
+	private:
 
-			float rand_size_scale = is_big ? big_unit_max - unit_min : small_unit_max - unit_min;
+		//most colliders from a single tile cached at once when generating pairs, bigger tiles are split into chunks this size
+		static constexpr uint32_t max_colliders_per_tile_for_pairs = 64;
 
-			// Generate a random float value between 0 and 1 for radius
-			float random_radius = static_cast<float>(rand()) / RAND_MAX;
+		//all the colliders that could touch found in each sector last step
+		//a pair is only ever stored in one sector, the sector holding the tile with the lower tile index
+		std::array<collider_pair_buffer_type, grid_dimension_type::sector_grid_count> collider_pairs_per_sector;
 
-			colider_to_add.radius = (random_radius * rand_size_scale) + unit_min;
+		//number of touching pairs found in each sector including any that did not fit in the pair buffer
+		std::array<uint32_t, grid_dimension_type::sector_grid_count> collider_pairs_found_per_sector = {};
 
-			// Generate a random float value between 0 and 1 for radius
-			float random_pos_x = static_cast<float>(rand()) / RAND_MAX;
-			float random_pos_y = static_cast<float>(rand()) / RAND_MAX;
+		//the pairs for a sector converted to collider addresses so the time of impact can be calculated in one batch
+		struct time_of_impact_scratch_buffers
+		{
+			std::array<uint32, max_collider_pairs_per_sector> address_a;
+			std::array<uint32, max_collider_pairs_per_sector> address_b;
+			std::array<scalar_type, max_collider_pairs_per_sector> time_of_impact;
+		};
 
-			float radius_negative_padding = (grid_dimension_type::tile_w - (colider_to_add.radius * 2));
+		std::array<time_of_impact_scratch_buffers, max_worker_count> per_worker_time_of_impact_scratch_buffers;
 
-			colider_to_add.position = math_2d_util::fvec2d(
-				(random_pos_x * radius_negative_padding) + colider_to_add.radius,
-				(random_pos_y * radius_negative_padding) + colider_to_add.radius);
+		//how far through the step each collider can move before it hits something, indexed by handle index
+		std::array<scalar_type, Imax_objects> time_of_impact_per_collider;
 
-			float random_vel_x = (static_cast<float>(rand()) / RAND_MAX) - 0.5f;
-			float random_vel_y = (static_cast<float>(rand()) / RAND_MAX) - 0.5f;
+		//number of times the solver runs over all the pairs each step
+		uint32_t solver_iterations = 4;
 
-			colider_to_add.velocity = math_2d_util::fvec2d(random_vel_x * max_velocity, random_vel_y * max_velocity);
+		//fraction of the overlap the solver tries to push out each step
+		static constexpr scalar_type solver_separation_stiffness = Tnumeric_policy::from_float(0.2f);
 
-			auto colider_handle02 = try_queue_item_to_add(std::move(colider_to_add));
-		}
-	}
-	
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::handle_type 
-		phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::try_queue_item_to_add(new_collider_data&& data_for_new_collider)
-	{
-		//try and get a free handle 
-		typename handle_data_lookup_system_type::index_type index = handle_manager.get_free_element();
+		//furthest the solver can push a collider in a step, the overlap grid only looks this many tiles out from each tile
+		static constexpr uint32_t max_solved_tiles_per_step = overlap_tracking_grid_type::tile_overlap_max_width / 2;
 
-		//check that index is valid 
-		if (!handle_data_lookup_system_type::is_valid_index(index))
+		//impulse for a collider that is in a different sector to the pair that created it
+		struct boundary_impulse
 		{
-			//if the handle is invalid dont queue data and just return an invalid handle
-			return handle_type::get_invalid_index();
-		}
+			typename collision_data_container_type::real_address_type address;
+			sector_count_type target_sector;
+			scalar_type impulse_x;
+			scalar_type impulse_y;
+		};
 
-		//create the handle 
-		handle_type handle = handle_type(index);
+		//the extra +1 is because we are using branchless write and need that extra space for writes we are discarding
+		using boundary_impulse_buffer_type = ArrayUtilities::fixed_size_vector_array<boundary_impulse, max_collider_pairs_per_sector + 1>;
 
-		//convert from position to sector and tile 
+		//impulses each sector created for colliders in its neighbours, these get added in by the neighbours in the fix up pass 
+		//so no two sectors ever write to the same collider at the same time
+		std::array<boundary_impulse_buffer_type, grid_dimension_type::sector_grid_count> boundary_impulses_per_sector;
 
-		//convert to tile
-		math_2d_util::ivec2d tile_xy = static_cast<math_2d_util::ivec2d>(data_for_new_collider.position);
+		//colliders moving slower than this count as resting, sleeping colliders pushed faster than this wake up
+		static constexpr scalar_type sleep_velocity_threshold = Tnumeric_policy::from_float(0.5f);
 
-		//use grid helper to get sector
-		uint32 sector_index = grid_helper.to_sector_index(tile_xy);
+		//number of resting steps before a collider is put to sleep, 0 = never sleep
+		uint16_t sleep_step_count = 60;
 
-		//sanity check that the tile is in that sector
-		{
-			math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
+		//how many steps in a row each collider has been resting, capped at sleep_step_count, indexed by handle index
+		std::array<uint16_t, Imax_objects> steps_at_rest_per_collider;
 
-			bool is_in_sector_x = (sector_bounds.min.x <= tile_xy.x) && (sector_bounds.max.x > tile_xy.x);
-			bool is_in_sector_y = (sector_bounds.min.y <= tile_xy.y) && (sector_bounds.max.y > tile_xy.y);
+		//sleeping colliders are kept at the start of each sectors data so the integration loops can skip straight past them
+		std::array<uint32_t, grid_dimension_type::sector_grid_count> sleeping_colliders_per_sector = {};
 
-			if ((is_in_sector_x && is_in_sector_y) == false)
-			{
-				assert(is_in_sector_x && is_in_sector_y);
-			}
-		}
+		//most passes the movement in one step can be split into, 1 = sub stepping is off
+		uint32_t max_sub_steps = 1;
 
-		//check if this is the first item in this sector
-		bool is_first_in_sector = !collider_to_add_header.y_axis_count[sector_index];
+		//colliders moving further than this many tiles in a step have their move split into sub steps
+		scalar_type sub_step_max_move = Tnumeric_policy::from_float(0.5f);
 
-		//check that index is less than max number of sectors in world
-		assert(sector_index < max_sectors_internal);
+		//the most sub steps any collider in the sector needed the last time it was moved, each sector only writes its own entry
+		std::array<uint32_t, grid_dimension_type::sector_grid_count> sub_steps_per_sector = {};
 
-		//validate that this item is not already in the list
-		auto existing_entry_it = std::find(sectors_with_queued_items.begin(), sectors_with_queued_items.end(), sector_index);
+		//sectors moved in the current sub step pass, the ones with fast colliders and their neighbours
+		sector_count_type number_of_sub_step_sectors = 0;
+		std::array<sector_count_type, max_sectors_internal> sub_step_sectors;
 
-		assert(existing_entry_it == sectors_with_queued_items.end() || (is_first_in_sector == false));
+		//the sub step sectors and their neighbours, these are the only sectors that can have something transfered into them during the pass
+		sector_count_type number_of_sub_step_transfer_sectors = 0;
+		std::array<sector_count_type, max_sectors_internal> sub_step_transfer_sectors;
 
-		//double check that there are no duplicates
-		std::set<sector_count_type> seen;
+		bool is_sleeping(handle_type handle) const;
 
-		for (sector_count_type value : sectors_with_queued_items)
-		{
-			if (!seen.insert(value).second) 
-			{
-				//duplicate found
-				assert(false);
-			}
-		}
+		//wake a collider when we already know which sector it is in
+		void wake_collider_in_sector(handle_type handle, sector_count_type sector_index);
 
+		//swap 2 colliders in a sectors data, the index is the position in the sector not the real address
+		void swap_colliders_in_sector(sector_count_type sector_index, uint32_t index_a, uint32_t index_b);
 
-		//if this is the first in the sector add to the active sector list
-		sectors_with_queued_items.push_back(sector_index, is_first_in_sector);
+		//put resting colliders to sleep and wake anything that was pushed
+		void update_sleep_state_in_sector(sector_count_type sector_index);
 
-		//alocate space in the in buffer for the data 
-		auto address_to_add_item_at = collider_to_add_header.push_back(sector_index);
+		void update_sleep_state_in_all_sectors();
 
-		//store the data about the new item to add 
-		colliders_to_add_data[address_to_add_item_at.address] = std::move(data_for_new_collider);
 
-		//update the handle 
-		colliders_to_add_data[address_to_add_item_at.address].owner = handle;
+		public:
 
-		return handle;
-	}
+		//try add a handle to the simulation
+		handle_type try_queue_item_to_add( new_collider_data&& data_for_new_collider);
+
+		//queue a collider to be removed at the start of the next update, the handle is freed once it is removed
+		//colliders still queued to be added can be removed too, they are added and removed in the same update
+		//returns false if the collider is already queued or the handle has already been freed
+		bool try_queue_item_to_remove(handle_type handle);
+
+		//true from when try_queue_item_to_add hands the handle out until the update that removes the collider
+		bool is_handle_live(handle_type handle) const;
+
+		private:
+
+		//add all the queued items for a sector into the physics system 
+		void add_items_from_sector(sector_count_type sector_index);
+
+		void add_collider_data_to_sector_data(const new_collider_data& data_to_add, sector_count_type sector_index);
+
+		void add_collider_handle_to_tile_tracker(const new_collider_data& data_to_add);
+
+		//add all the new items 
+		void add_items_from_all_sectors();
+
+		//position of a collider in its sectors data
+		uint32_t get_index_in_sector(handle_type handle, sector_count_type sector_index) const;
+
+		//sector a collider is stored in, this only reads the handle lookup not the collider data
+		sector_count_type get_sector_of_collider(handle_type handle) const;
+
+		//take a collider out of the sector data and its tile without freeing the handle, this also clears the overlaps of its tile if it is left empty
+		//tile_xy is the tile it is held under in the tile tracker
+		void detach_collider_from_sector(handle_type handle, const math_2d_util::ivec2d& tile_xy, sector_count_type sector_index, uint32_t worker_index);
+
+		//remove all the queued items for a sector, this also clears the overlaps of any tiles left empty
+		void remove_items_from_sector(sector_count_type sector_index, uint32_t worker_index);
+
+		//remove all the queued items and free their handles
+		void remove_items_from_all_sectors();
+
+		//update the grid overlap system for the tiles in the sector that have been marked as dirty
+		void update_bounds_in_sector(sector_count_type sector_index, uint32_t worker_index);
+
+		//update the bounds in all sectors 
+		void update_bounds_in_all_sectors();
+
+		//move all objects in sector, colliders split into sub steps only move if they have a step left for this pass
+		void update_positions_in_sector(sector_count_type sector_index, uint32_t worker_index, uint32_t sub_step_index);
+
+		//copy all objects that have left the sector to the sector transfer buffer
+		template<typename Tedge_info>
+		void transfer_items_between_sectors(sector_count_type sector_index);
+
+		//pull the items in the neighbouring transfer buffers into each sector then clear the buffers
+		void transfer_items_into_sectors(std::span<const sector_count_type> sectors);
+
+		//move the colliders that still have sub steps left, only sectors with fast colliders and their neighbours are visited
+		void update_sub_step_positions();
+
+		//move all objects in the world
+		void update_all_positions();
+
+		//find all touching colliders in a sector using the tile overlap pairs
+		void generate_pairs_in_sector(sector_count_type sector_index, uint32_t worker_index);
+
+		//find all touching colliders in the world
+		void generate_pairs_in_all_sectors();
+
+		//find the earliest time of impact for all the colliders in the sectors pairs
+		void calculate_time_of_impact_in_sector(sector_count_type sector_index, uint32_t worker_index);
+
+		//find the earliest time of impact for every collider
+		void calculate_time_of_impact_in_all_sectors();
+
+		//add the separation impulse for every pair in the sector to the colliders in the sector and
+		//store the impulse for colliders in other sectors in the sectors boundary buffer
+		void accumulate_impulses_in_sector(sector_count_type sector_index);
+
+		//add the impulses the neighbouring sectors created for this sector then apply all the impulses to the velocity
+		void apply_impulses_in_sector(sector_count_type sector_index);
+
+		//push all the overlapping colliders apart
+		void solve_collisions_in_all_sectors();
+
+		//written at the start of every snapshot so a file from a different build or physics type is rejected
+		struct snapshot_header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t max_objects;
+			uint64_t world_sector_x_count;
+			uint64_t scalar_size;
+			uint64_t scalar_one_bits; //bits of 1 in the scalar type, tells float and the fixed point formats apart
+			uint64_t state_size;
+		};
+
+		static constexpr uint32_t snapshot_magic = 0x50324443; //"CD2P"
+
+		static constexpr uint32_t snapshot_version = 5;
+
+		//per sector blocks are arrays indexed by sector, a step only writes to the entries for the sectors it touches
+		//the overlap lists are also per sector but are only written when the overlap grid flags them as changed
+		//whole blocks that track their own writes or are fixed size lists let the rollback buffer skip the parts that cant have changed
+		enum class snapshot_block_layout : uint8_t
+		{
+			WHOLE,
+			PER_SECTOR,
+			PER_SECTOR_OVERLAP_LIST
+		};
+
+		//call func(member, layout) on every member that carries state from one update to the next
+		//the per worker scratch, transfer, boundary and removal bucket buffers are cleared before they are used so they are left out
+		//the dirty tile bitmap and swept bounds caches are left out too, they are rebuilt by marking every tile dirty
+		template<typename Tself, typename Tblock_func>
+		static void for_each_snapshot_block(Tself& self, Tblock_func&& block_func);
+
+		//header for a snapshot of this physics type
+		snapshot_header create_snapshot_header() const;
+
+		//call range_func(byte offset, byte count) for the bytes of a snapshot block with its locks cut out
+		//the locks only guard the page pools while a step is running, they are not simulation state so they are never written or read as raw bytes
+		template<typename Tblock, typename Trange_func>
+		static void for_each_plain_byte_range(const Tblock& block, Trange_func&& range_func);
+
+		//the rollback buffer diffs the same blocks the snapshot writes
+		template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+		friend class physics_rollback_buffer;
+
+		public:
+		//add queued items 
+		void update_physics();
+
+		//how many threads to split the per sector work across, 0 = all hardware threads
+		void set_worker_count(uint32_t worker_count);
+
+		uint32_t get_worker_count() const;
+
+		//how long each phase of the last update_physics took, indexed by update_phase
+		const update_phase_times& get_last_update_phase_times() const;
+
+		//counters for the work done in the last update_physics, all zero when the stats are compiled out
+		const physics_stats& get_last_step_stats() const;
+
+		//touching colliders found in the sector during the last step
+		const collider_pair_buffer_type& get_collider_pairs_in_sector(sector_count_type sector_index) const;
+
+		//number of touching pairs found in the sector during the last step, this can be larger than the pair buffer if it overflowed
+		uint32_t get_collider_pair_count_in_sector(sector_count_type sector_index) const;
+
+		//fraction of the last step the collider moved before hitting something, 1 = it did the full move
+		scalar_type get_time_of_impact(handle_type handle) const;
+
+		//number of solver passes over the collider pairs each step, more iterations = stiffer crowds
+		void set_solver_iterations(uint32_t iterations);
+
+		uint32_t get_solver_iterations() const;
+
+		//most passes the movement in a step can be split into, 1 = off
+		//colliders moving further than the max sub step move are moved in several smaller steps so they never cross more than one sector
+		//edge per pass and the sector transfer buffers are emptied between passes, sectors with only slow colliders still move once
+		void set_max_sub_steps(uint32_t sub_steps);
+
+		uint32_t get_max_sub_steps() const;
+
+		//distance in tiles a collider can move in one sub step
+		void set_sub_step_max_move(float tiles);
+
+		float get_sub_step_max_move() const;
+
+		//number of steps a collider has to be resting before it goes to sleep, 0 = never sleep
+		void set_sleep_step_count(uint16_t step_count);
+
+		uint16_t get_sleep_step_count() const;
+
+		//true if the collider is asleep and is being skipped by the integration and bounds updates
+		bool is_collider_sleeping(handle_type handle) const;
+
+		//number of sleeping colliders in the sector
+		uint32_t get_sleeping_collider_count_in_sector(sector_count_type sector_index) const;
+
+		//wake up a sleeping collider, only call this between steps for colliders already in the simulation
+		void wake_collider(handle_type handle);
+
+		//set the velocity of a collider and wake it up, only call this between steps for colliders already in the simulation
+		//speed limits, these apply to every way a velocity gets into the simulation:
+		//- the solver never pushes a collider faster than 3 tiles a step (180 tiles a second at 60hz) but leaves faster velocities set by the game alone
+		//- colliders moving more than 3 tiles a step can pass through colliders that were further away than that at the start of the step
+		//- a collider has to move less than a sector (16 tiles) per integration pass, with sub steps on that is per sub step not per step
+		void set_velocity(handle_type handle, scalar_vec2d velocity);
+
+		//queue a new velocity for a collider, all queued commands are applied in one sorted pass at the start of the next update
+		//returns false if the command buffer is full or the handle has been freed, see set_velocity for the speed limits
+		bool queue_velocity_command(handle_type handle, scalar_vec2d velocity);
+
+		//queue a force for a collider, the force is applied for one step to a collider with a mass of 1
+		//returns false if the command buffer is full or the handle has been freed, see set_velocity for the speed limits
+		bool queue_force_command(handle_type handle, scalar_vec2d force);
+
+		//queue a collider to be moved to anywhere in the world keeping its handle and velocity, for teleports and respawns
+		//all the queued transfers are moved in one pass bucketed by sector at the start of the next update
+		//returns false if the queue is full, the handle has been freed or the collider is already queued to move or to be removed
+		bool queue_long_range_transfer(handle_type handle, scalar_vec2d position);
+
+		//find all colliders touching a circle, returns the number found, only as many as fit are written to out_handles
+		uint32_t query_circle(math_2d_util::fvec2d center, float radius, std::span<handle_type> out_handles);
+
+		//find all colliders touching a rect, returns the number found, only as many as fit are written to out_handles
+		uint32_t query_aabb(const math_2d_util::frect& rect, std::span<handle_type> out_handles);
+
+		//run a batch of circle queries, the results for query i are written to out_handles starting at i * max_results_per_query
+		//out_result_counts gets the number found for each query, this can be more than max_results_per_query
+		void query_circles(std::span<const circle_query> queries, uint32_t max_results_per_query, std::span<handle_type> out_handles, std::span<uint32_t> out_result_counts);
+
+		//run a batch of rect queries, the output is laid out the same as query_circles
+		void query_aabbs(std::span<const math_2d_util::frect> queries, uint32_t max_results_per_query, std::span<handle_type> out_handles, std::span<uint32_t> out_result_counts);
+
+		//first collider hit by a ray, the direction does not need to be normalized
+		raycast_hit raycast(math_2d_util::fvec2d origin, math_2d_util::fvec2d direction, float max_distance, handle_type ignore_handle = handle_type::get_invalid_index());
+
+		//first collider hit by a swept segment, zero length segments hit nothing
+		raycast_hit segment_cast(const segment_query& segment);
+
+		//first collider hit by each segment, segments are grouped by the sector they start in and run in parallel
+		void segment_casts(std::span<const segment_query> segments, std::span<raycast_hit> out_hits);
+
+		//find the k colliders with centers closest to a point, nearest first, returns the number found
+		//tiles are visited in spiral order and the search stops once the next ring is further away than the kth best
+		uint32_t query_k_nearest(math_2d_util::fvec2d point, uint32_t k, std::span<handle_type> out_handles, handle_type ignore_handle = handle_type::get_invalid_index());
+
+		//run a batch of k nearest queries, the results for query i are written to out_handles starting at i * k
+		//and out_result_counts gets the number found for each query
+		void query_k_nearest_batch(std::span<const k_nearest_query> queries, uint32_t k, std::span<handle_type> out_handles, std::span<uint32_t> out_result_counts);
+
+		//position of a collider, only call this between steps for colliders already in the simulation
+		math_2d_util::fvec2d get_position(handle_type handle);
+
+		//write the whole simulation state to a file as raw blocks, returns false if the file could not be written
+		//queued adds, removals and motion commands are saved too so the next update runs the same as it would have here
+		//the page pool locks are written as zeros, only call this between updates
+		bool save_snapshot(const std::filesystem::path& path) const;
+
+		//replace the simulation state with a snapshot written by save_snapshot, nothing is rebuilt so the time taken only depends on the file size
+		//the whole file is read into a staging buffer and checked before any state is touched, so this needs as much free memory as the file is big
+		//there is no memory mapped path, the blocks are always copied out of the staging buffer
+		//returns false and leaves the state untouched if the file is missing, cant be read or was saved by a physics type with a different layout
+		bool load_snapshot(const std::filesystem::path& path);
+
+		//debug draw tool
+		void draw_debug(debug_draw_interface& draw_interface);
+
+
+		//do a simple setup of the physics
+		void setup_physics_simple();
+
+		//do a more complicated random setup
+		void setup_physics_random(uint32_t number_to_spawn, float max_velocity);
+
+
+	};
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void ContinuousCollisionLibrary::phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::setup_physics_simple()
+	{
+		new_collider_data colider_to_add01;
+
+		colider_to_add01.position = to_scalar_vector(math_2d_util::fvec2d(0.9f));
+		colider_to_add01.velocity = to_scalar_vector(math_2d_util::fvec2d(0.0f));
+
+		colider_to_add01.radius = Tnumeric_policy::from_float(0.5f);
+
+		new_collider_data colider_to_add02;
+
+
+		colider_to_add02.position = to_scalar_vector(math_2d_util::fvec2d(16.1f));
+		colider_to_add02.velocity = to_scalar_vector(math_2d_util::fvec2d(-69.0f));
+
+		colider_to_add02.radius = Tnumeric_policy::from_float(1.0f);
+
+		//queue up a new item 
+		auto colider_handle01 = try_queue_item_to_add(std::move(colider_to_add01));
+		auto colider_handle02 = try_queue_item_to_add(std::move(colider_to_add02));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void ContinuousCollisionLibrary::phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::setup_physics_random(uint32_t number_to_spawn, float max_velocity)
+	{
+		for (uint32_t i = 0; i < number_to_spawn; ++i)
+		{
+			new_collider_data colider_to_add;
+
+			constexpr float big_unit_percent = 0.75f;
+
+			constexpr float unit_min = 0.5f;
+			
+			constexpr float small_unit_max = 1.5f;
+
+			constexpr float big_unit_max = 5;
+
+			//choose if its a small or big unit
+			bool is_big = (static_cast<float>(rand()) / RAND_MAX) > 0.75f;
+
+			float rand_size_scale = is_big ? big_unit_max - unit_min : small_unit_max - unit_min;
+
+			// Generate a random float value between 0 and 1 for radius
+			float random_radius = static_cast<float>(rand()) / RAND_MAX;
+
+			float radius = (random_radius * rand_size_scale) + unit_min;
+
+			colider_to_add.radius = Tnumeric_policy::from_float(radius);
+
+			// Generate a random float value between 0 and 1 for radius
+			float random_pos_x = static_cast<float>(rand()) / RAND_MAX;
+			float random_pos_y = static_cast<float>(rand()) / RAND_MAX;
+
+			float radius_negative_padding = (grid_dimension_type::tile_w - (radius * 2));
+
+			colider_to_add.position = to_scalar_vector(math_2d_util::fvec2d(
+				(random_pos_x * radius_negative_padding) + radius,
+				(random_pos_y * radius_negative_padding) + radius));
+
+			float random_vel_x = (static_cast<float>(rand()) / RAND_MAX) - 0.5f;
+			float random_vel_y = (static_cast<float>(rand()) / RAND_MAX) - 0.5f;
+
+			colider_to_add.velocity = to_scalar_vector(math_2d_util::fvec2d(random_vel_x * max_velocity, random_vel_y * max_velocity));
+
+			auto colider_handle02 = try_queue_item_to_add(std::move(colider_to_add));
+		}
+	}
+	
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::handle_type 
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::try_queue_item_to_add(new_collider_data&& data_for_new_collider)
+	{
+		//try and get a free handle 
+		typename handle_data_lookup_system_type::index_type index = handle_manager.get_free_element();
+
+		//check that index is valid 
+		if (!handle_data_lookup_system_type::is_valid_index(index))
+		{
+			//if the handle is invalid dont queue data and just return an invalid handle
+			return handle_type::get_invalid_index();
+		}
+
+		//create the handle 
+		handle_type handle = handle_type(index);
+
+		is_handle_index_live[handle.get_index()] = true;
+
+		//convert from position to sector and tile 
+
+		//convert to tile
+		math_2d_util::ivec2d tile_xy = static_cast<math_2d_util::ivec2d>(data_for_new_collider.position);
+
+		//use grid helper to get sector
+		uint32 sector_index = grid_helper.to_sector_index(tile_xy);
+
+		//sanity check that the tile is in that sector
+		{
+			math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
+
+			bool is_in_sector_x = (sector_bounds.min.x <= tile_xy.x) && (sector_bounds.max.x > tile_xy.x);
+			bool is_in_sector_y = (sector_bounds.min.y <= tile_xy.y) && (sector_bounds.max.y > tile_xy.y);
+
+			if ((is_in_sector_x && is_in_sector_y) == false)
+			{
+				assert(is_in_sector_x && is_in_sector_y);
+			}
+		}
+
+		//check if this is the first item in this sector
+		bool is_first_in_sector = !colliders_to_add.header.y_axis_count[sector_index];
+
+		//check that index is less than max number of sectors in world
+		assert(sector_index < max_sectors_internal);
+
+		//validate that this item is not already in the list
+		auto existing_entry_it = std::find(sectors_with_queued_items.begin(), sectors_with_queued_items.end(), sector_index);
+
+		assert(existing_entry_it == sectors_with_queued_items.end() || (is_first_in_sector == false));
+
+		//double check that there are no duplicates
+		std::set<sector_count_type> seen;
+
+		for (sector_count_type value : sectors_with_queued_items)
+		{
+			if (!seen.insert(value).second) 
+			{
+				//duplicate found
+				assert(false);
+			}
+		}
+
+
+		//if this is the first in the sector add to the active sector list
+		sectors_with_queued_items.push_back(sector_index, is_first_in_sector);
+
+		//alocate space in the in buffer for the data 
+		auto address_to_add_item_at = colliders_to_add.header.push_back(sector_index);
+
+		//store the data about the new item to add 
+		colliders_to_add.data[address_to_add_item_at.address] = std::move(data_for_new_collider);
+
+		//update the handle 
+		colliders_to_add.data[address_to_add_item_at.address].owner = handle;
+
+		return handle;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::try_queue_item_to_remove(handle_type handle)
+	{
+		//removing a freed handle would remove whatever collider took its old slot and free the index a second time
+		if (!is_handle_live(handle))
+		{
+			return false;
+		}
+
+		bool& is_queued = is_queued_for_removal[handle.get_index()];
+
+		if (is_queued)
+		{
+			return false;
+		}
+
+		is_queued = true;
+
+		//the collider may only be queued to be added so its data cant be read yet, the sector is found when the removals run
+		queued_removals.push_back(handle);
+
+		return true;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::is_handle_live(handle_type handle) const
+	{
+		//the invalid handle and out of range indexes are past the end of the array
+		return (handle.get_index() < Imax_objects) && is_handle_index_live[handle.get_index()];
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::add_items_from_sector(sector_count_type sector_index)
+	{
+		PROFILE_ZONE("add_items_from_sector");
+
+		//get index iterator from the item add header 
+		std::for_each(colliders_to_add.header.begin(sector_index), colliders_to_add.header.end(sector_index), [&](auto real_address_to_add)
+			{
+				//get a ref struct to the existing data
+				const new_collider_data& existing_data = colliders_to_add.data[real_address_to_add.address];
+
+				add_collider_data_to_sector_data(existing_data, sector_index);
+
+			});
+
+		//inject the handle into the per tile trakcer
+		std::for_each(colliders_to_add.header.begin(sector_index), colliders_to_add.header.end(sector_index), [&](auto real_address_to_add)
+			{
+				//get a ref struct to the existing data
+				const new_collider_data& existing_data = colliders_to_add.data[real_address_to_add.address];
+
+				add_collider_handle_to_tile_tracker(existing_data);
+			});
+
+		//clear all queued items for sector
+		colliders_to_add.header.clear_axis(sector_index);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::add_collider_data_to_sector_data(const new_collider_data& data_for_new_collider, sector_count_type sector_index)
+	{
+		//make sure the data getting added is valid 
+		assert(data_for_new_collider.radius > scalar_type(0.0f));
+
+		//add to the target sector 
+		auto [destination__real_address, _, __] = collision_data_container.insert(data_for_new_collider.owner, sector_index);
+
+		//get the ref struct to the data we are writing to
+		auto data_ref = collision_data_container.get(destination__real_address);
+
+		//copy across the values (could maybe make a meta function for this)
+		data_ref.x = data_for_new_collider.position.x;
+		data_ref.y = data_for_new_collider.position.y;
+
+		data_ref.velocity_x = data_for_new_collider.velocity.x;
+		data_ref.velocity_y = data_for_new_collider.velocity.y;
+
+		data_ref.impulse_x = scalar_type(0.0f);
+		data_ref.impulse_y = scalar_type(0.0f);
+
+		data_ref.radius = data_for_new_collider.radius;
+
+		//new colliders start awake
+		steps_at_rest_per_collider[data_for_new_collider.owner.get_index()] = 0;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::add_collider_handle_to_tile_tracker(const new_collider_data& data_for_new_collider)
+	{
+		//get the handle 
+		auto handle = data_for_new_collider.owner;
+
+		//convert to tile
+		math_2d_util::ivec2d tile_xy = static_cast<math_2d_util::ivec2d>(data_for_new_collider.position);
+
+		//use grid helper to get sector
+		auto sector_index = grid_helper.from_xy(tile_xy);
+
+		//inject the handle into the grid structure 
+		colliders_in_tile_tracker.add(sector_index.index, handle);
+
+		mark_tile_bounds_dirty(sector_index.index);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::add_items_from_all_sectors()
+	{
+		PROFILE_ZONE("add_items_from_all_sectors");
+
+		//adding only touches the target sector so all queued sectors can be done at once
+		job_scheduler.parallel_for(sectors_with_queued_items.size(), [&](uint32_t job_index, uint32_t worker_index)
+			{
+				add_items_from_sector(sectors_with_queued_items[job_index]);
+			});
+
+		//all the sectors we added to now have colliders in them
+		std::for_each(sectors_with_queued_items.begin(), sectors_with_queued_items.end(), [&](sector_count_type sector_index)
+			{
+				set_sector_bit(active_sector_bitmap, sector_index, true);
+			});
+
+		refresh_active_sector_lists();
+
+		sectors_with_queued_items.clear();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_index_in_sector(handle_type handle, sector_count_type sector_index) const
+	{
+		using paged_array_type = typename collision_data_container_type::paged_array_type;
+
+		auto sector_start_address = paged_array_type::convert_from_y_axis_to_combined_virtual_address(sector_index, typename collision_data_container_type::virtual_y_axis_node_adderss_type(0));
+
+		return static_cast<uint32_t>(collision_data_container.handle_to_data_lookup[handle.get_index()].address - sector_start_address.address);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::sector_count_type 
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_sector_of_collider(handle_type handle) const
+	{
+		using paged_array_type = typename collision_data_container_type::paged_array_type;
+
+		return static_cast<sector_count_type>(paged_array_type::convert_from_combined_virtual_address_to_x(collision_data_container.handle_to_data_lookup[handle.get_index()]));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::detach_collider_from_sector(handle_type handle, const math_2d_util::ivec2d& tile_xy, sector_count_type sector_index, uint32_t worker_index)
+	{
+		using virtual_y_axis_address_type = typename collision_data_container_type::virtual_y_axis_node_adderss_type;
+
+		uint32_t& sleeping_count = sleeping_colliders_per_sector[sector_index];
+
+		//take it out of the tile tracker
+		auto tile = grid_helper.from_xy(tile_xy);
+
+		colliders_in_tile_tracker.remove(tile.index, handle);
+
+		mark_tile_bounds_dirty(tile.index);
+
+		//if that was the last collider in the tile its overlaps are no longer needed
+		bool is_tile_empty = colliders_in_tile_tracker.get_root_node_start(tile.index) == colliders_in_tile_tracker.end();
+
+		//tiles that have never had their bounds set have no overlaps to clear
+		if (is_tile_empty && overlap_grid.has_bounds(tile))
+		{
+			add_bounds_update_to_stats(worker_index, overlap_grid.update_bounds(tile_xy, tile, math_2d_util::irect::inverse_max_size_rect()));
+		}
+
+		uint32_t index_in_sector = get_index_in_sector(handle, sector_index);
+
+		//move sleeping colliders to the end of the sleeping block first so the block stays packed
+		if (index_in_sector < sleeping_count)
+		{
+			--sleeping_count;
+
+			swap_colliders_in_sector(sector_index, index_in_sector, sleeping_count);
+
+			index_in_sector = sleeping_count;
+		}
+
+		//swap to the end of the sector and drop it
+		uint32_t last_index = collision_data_container.get_tight_packed_data().get_array_header().y_axis_count[sector_index] - 1;
+
+		swap_colliders_in_sector(sector_index, index_in_sector, last_index);
+
+		auto last_real_address = collision_data_container.get_tight_packed_data().resolve_address(sector_index, virtual_y_axis_address_type(last_index));
+
+		collision_data_container.remove_without_updating_handle(sector_index, last_real_address);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::remove_items_from_sector(sector_count_type sector_index, uint32_t worker_index)
+	{
+		PROFILE_ZONE("remove_items_from_sector");
+
+		std::for_each(collider_to_remove_header.begin(sector_index), collider_to_remove_header.end(sector_index), [&](auto real_address_to_remove)
+			{
+				handle_type handle = colliders_to_remove_data[real_address_to_remove.address];
+
+				auto ref_struct = collision_data_container.get(handle);
+
+				detach_collider_from_sector(handle, static_cast<math_2d_util::ivec2d>(scalar_vec2d(ref_struct.x, ref_struct.y)), sector_index, worker_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::remove_items_from_all_sectors()
+	{
+		PROFILE_ZONE("remove_items_from_all_sectors");
+
+		if (queued_removals.size() == 0)
+		{
+			return;
+		}
+
+		//the adds have run so every queued collider is in the simulation, only the handle lookup is read to find its sector
+		std::for_each(queued_removals.begin(), queued_removals.end(), [&](handle_type handle)
+			{
+				sector_count_type sector_index = get_sector_of_collider(handle);
+
+				//if this is the first in the sector add to the list of sectors to remove from
+				bool is_first_in_sector = !collider_to_remove_header.y_axis_count[sector_index];
+
+				sectors_with_queued_removals.push_back(sector_index, is_first_in_sector);
+
+				auto address_to_add_item_at = collider_to_remove_header.push_back(sector_index);
+
+				colliders_to_remove_data[address_to_add_item_at.address] = handle;
+			});
+
+		queued_removals.clear();
+
+		//clearing the overlaps of empty tiles writes to the neighbouring sectors so run it one colour at a time
+		//every sector with something to remove is active so only the sectors with queued removals do any work
+		run_on_active_sectors_coloured([&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				remove_items_from_sector(sector_index, worker_index);
+			});
+
+		//the handle free list is not thread safe so return the handles here
+		std::for_each(sectors_with_queued_removals.begin(), sectors_with_queued_removals.end(), [&](sector_count_type sector_index)
+			{
+				std::for_each(collider_to_remove_header.begin(sector_index), collider_to_remove_header.end(sector_index), [&](auto real_address_to_remove)
+					{
+						handle_type handle = colliders_to_remove_data[real_address_to_remove.address];
+
+						is_queued_for_removal[handle.get_index()] = false;
+
+						//a removed collider can not be moved as well
+						is_queued_for_long_range_transfer[handle.get_index()] = false;
+
+						is_handle_index_live[handle.get_index()] = false;
+
+						handle_manager.return_to_free_list(handle.get_index());
+					});
+
+				collider_to_remove_header.clear_axis(sector_index);
+
+				update_sector_active_state(sector_index);
+			});
+
+		refresh_active_sector_lists();
+
+		sectors_with_queued_removals.clear();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::mark_tile_bounds_dirty(uint32_t world_tile_index)
+	{
+		dirty_tile_bitmap[world_tile_index / 64] |= uint64_t(1) << (world_tile_index % 64);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::mark_all_tile_bounds_dirty()
+	{
+		dirty_tile_bitmap.fill(~uint64_t(0));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline math_2d_util::irect phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::calculate_swept_bounds(scalar_type x, scalar_type y, scalar_type velocity_x, scalar_type velocity_y, scalar_type radius) const
+	{
+		//where the collider will be at the end of the next step
+		scalar_type end_x = x + (velocity_x * time_step);
+		scalar_type end_y = y + (velocity_y * time_step);
+
+		//the bounds cover the whole move so fast colliders still find what they will hit
+		math_2d_util::irect bounds;
+
+		bounds.min.x = static_cast<int32>(std::min<scalar_type>(x, end_x) - radius);
+		bounds.max.x = static_cast<int32>(std::max<scalar_type>(x, end_x) + radius);
+
+		bounds.min.y = static_cast<int32>(std::min<scalar_type>(y, end_y) - radius);
+		bounds.max.y = static_cast<int32>(std::max<scalar_type>(y, end_y) + radius);
+
+		return bounds;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_bounds_in_sector(sector_count_type sector_index, uint32_t worker_index)
+	{
+		PROFILE_ZONE("update_bounds_in_sector");
+
+		//get the iterators for the sector
+		auto begin_itr = colliders_in_tile_tracker.get_active_nodes_in_group_start(sector_index);
+		auto end_itr = colliders_in_tile_tracker.get_active_nodes_in_group_end(sector_index);
+
+		//sector offset 
+		auto tile_offset = sector_index * grid_dimension_type::sector_tile_count;
+
+		//loop through all active nodes in the sector
+		std::for_each(begin_itr, end_itr, [&](auto root_index)
+			{
+				//convert from subtile to global tile 
+				auto world_tile = root_index + tile_offset;
+
+				uint64_t& dirty_word = dirty_tile_bitmap[world_tile / 64];
+				uint64_t dirty_bit = uint64_t(1) << (world_tile % 64);
+
+				//nothing in the tile has moved far enough to change its bounds
+				if (!(dirty_word & dirty_bit))
+				{
+					return;
+				}
+
+				//the integration pass marks the tile again when a collider in it changes its swept bounds
+				dirty_word &= ~dirty_bit;
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					++per_worker_scratch_buffers[worker_index].step_stats.tile_bounds_walks;
+				}
+
+				//get the iterator for the tile
+				auto tile_start = colliders_in_tile_tracker.get_root_node_start(world_tile);
+				auto tile_end = colliders_in_tile_tracker.end();
+
+				//the rect for the tile
+				math_2d_util::irect new_bounds = math_2d_util::irect::inverse_max_size_rect();
+
+				//tiles where everything is asleep have not moved so their overlaps stay frozen
+				bool has_awake_collider = false;
+
+				using sector_type_type = typename sector_grid_helper_type::sector_tile_index_type;
+
+				//check for overflow
+				assert(world_tile < std::numeric_limits<sector_type_type::combined_index>::max());
+
+				//convert to a tile type
+				sector_type_type tile = sector_type_type{ static_cast<sector_type_type::combined_index>( world_tile )};
+
+				//get the tils coordinate
+				math_2d_util::ivec2d tile_coordinate = grid_helper.to_xy<math_2d_util::ivec2d>(tile);
+
+				//calculate the bounds for each agent
+				std::for_each(tile_start, tile_end,
+					[&](auto handle)
+					{
+						//get ref struct 
+						typename collision_data_container_type::handle_reference_wrapper ref_struct = collision_data_container.get(handle);
+
+						math_2d_util::irect collider_bounds = calculate_swept_bounds(ref_struct.x, ref_struct.y, ref_struct.velocity_x, ref_struct.velocity_y, ref_struct.radius);
+
+						//keep what this collider added so the integration pass can tell if it has changed
+						swept_bounds_per_collider[handle.get_index()] = collider_bounds;
+
+						new_bounds.min.x = std::min(new_bounds.min.x, collider_bounds.min.x);
+						new_bounds.max.x = std::max(new_bounds.max.x, collider_bounds.max.x);
+
+						new_bounds.min.y = std::min(new_bounds.min.y, collider_bounds.min.y);
+						new_bounds.max.y = std::max(new_bounds.max.y, collider_bounds.max.y);
+
+						has_awake_collider |= !is_sleeping(handle);
+					});
+
+				//the bounds the grid has for the tile cover everything that was awake in it so they are kept as they are
+				//when a collider wakes up and moves its swept bounds change and the tile is marked dirty again
+				if (!has_awake_collider)
+				{
+					return;
+				}
+
+				//the overlap grid can only track tiles a few tiles away and inside the world so clamp the bounds to that
+				{
+					constexpr int32 max_tile_reach = overlap_tracking_grid_type::tile_overlap_max_width / 2;
+					constexpr int32 max_tile = grid_dimension_type::tile_w - 1;
+
+					math_2d_util::irect reachable_tiles(
+						{ std::max(tile_coordinate.x - max_tile_reach, 0), std::max(tile_coordinate.y - max_tile_reach, 0) },
+						{ std::min(tile_coordinate.x + max_tile_reach, max_tile), std::min(tile_coordinate.y + max_tile_reach, max_tile) });
+
+					new_bounds.min = math_2d_util::rect_2d_math::clamp_to_rect(reachable_tiles, new_bounds.min);
+					new_bounds.max = math_2d_util::rect_2d_math::clamp_to_rect(reachable_tiles, new_bounds.max);
+				}
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					++per_worker_scratch_buffers[worker_index].step_stats.tile_bounds_updates;
+				}
+
+				//jittering in place often lands on the same whole tiles so there are no flags to change
+				if (overlap_grid.has_bounds(tile) && overlap_grid.get_world_bounds(tile_coordinate, tile) == new_bounds)
+				{
+					return;
+				}
+
+				//update the bounds of the tile
+				add_bounds_update_to_stats(worker_index, overlap_grid.update_bounds(tile_coordinate, tile, new_bounds));
+
+			});
+	}
+
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_bounds_in_all_sectors()
+	{
+		PROFILE_ZONE("update_bounds_in_all_sectors");
+
+		//updating the bounds writes overlap flags and pairs into the neighbouring sectors so run it one colour at a time
+		run_on_active_sectors_coloured([&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				update_bounds_in_sector(sector_index, worker_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_sector_colour(sector_count_type sector_index)
+	{
+		uint32_t sector_x = sector_index % grid_dimension_type::sectors_grid_w;
+		uint32_t sector_y = sector_index / grid_dimension_type::sectors_grid_w;
+
+		return (sector_x % sector_colour_stride) + ((sector_y % sector_colour_stride) * sector_colour_stride);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tsector_func>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::run_on_sectors(std::span<const sector_count_type> sectors, Tsector_func&& sector_func)
+	{
+		job_scheduler.parallel_for(static_cast<uint32_t>(sectors.size()), [&](uint32_t job_index, uint32_t worker_index)
+			{
+				sector_func(sectors[job_index], worker_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tsector_func>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::run_on_active_sectors(Tsector_func&& sector_func)
+	{
+		run_on_sectors(std::span<const sector_count_type>(active_sectors.data(), number_of_active_sectors), std::forward<Tsector_func>(sector_func));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tsector_func>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::run_on_active_sectors_coloured(Tsector_func&& sector_func)
+	{
+		for (uint32_t colour = 0; colour < sector_colour_count; ++colour)
+		{
+			const auto& sectors_of_colour = active_sectors_by_colour[colour];
+
+			run_on_sectors(std::span<const sector_count_type>(sectors_of_colour.begin(), sectors_of_colour.end()), sector_func);
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tsector_func>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::run_on_sectors_coloured(std::span<const sector_count_type> sectors, Tsector_func&& sector_func)
+	{
+		std::array<ArrayUtilities::fixed_size_vector_array<sector_count_type, max_sectors_internal + 1>, sector_colour_count> sectors_by_colour;
+
+		std::for_each(sectors.begin(), sectors.end(), [&](sector_count_type sector_index)
+			{
+				sectors_by_colour[get_sector_colour(sector_index)].push_back(sector_index);
+			});
+
+		for (uint32_t colour = 0; colour < sector_colour_count; ++colour)
+		{
+			const auto& sectors_of_colour = sectors_by_colour[colour];
+
+			run_on_sectors(std::span<const sector_count_type>(sectors_of_colour.begin(), sectors_of_colour.end()), sector_func);
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_sector_bit(sector_bitmap_type& bitmap, uint32_t sector_index, bool value)
+	{
+		uint64_t& word = bitmap[sector_index / 64];
+		uint64_t bit = uint64_t(1) << (sector_index % 64);
+
+		word = (word & ~bit) | (value ? bit : 0);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::sector_bitmap_to_list(const sector_bitmap_type& bitmap, sector_count_type* out_sectors)
+	{
+		uint32_t count = 0;
+
+		for (uint32_t iword = 0; iword < active_sector_bitmap_word_count; ++iword)
+		{
+			//pop each set bit off the bottom of the word
+			for (uint64_t word = bitmap[iword]; word != 0; word &= word - 1)
+			{
+				out_sectors[count++] = static_cast<sector_count_type>((iword * 64) + std::countr_zero(word));
+			}
+		}
+
+		return count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_sector_active_state(sector_count_type sector_index)
+	{
+		bool has_colliders = collision_data_container.get_tight_packed_data().get_array_header().y_axis_count[sector_index] != 0;
+
+		bool was_active = (active_sector_bitmap[sector_index / 64] >> (sector_index % 64)) & 1;
+
+		//inactive sectors are skipped by every pass so clear out anything a neighbour or the user could still read
+		if (was_active && !has_colliders)
+		{
+			collider_pairs_per_sector[sector_index].clear();
+			collider_pairs_found_per_sector[sector_index] = 0;
+			boundary_impulses_per_sector[sector_index].clear();
+
+			assert(sleeping_colliders_per_sector[sector_index] == 0);
+		}
+
+		set_sector_bit(active_sector_bitmap, sector_index, has_colliders);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_sector_and_neighbour_bits(sector_bitmap_type& bitmap, uint32_t sector_index)
+	{
+		constexpr int32 max_sector = grid_dimension_type::sectors_grid_w - 1;
+
+		int32 sector_x = sector_index % grid_dimension_type::sectors_grid_w;
+		int32 sector_y = sector_index / grid_dimension_type::sectors_grid_w;
+
+		for (int32 iy = std::max(sector_y - 1, 0); iy <= std::min(sector_y + 1, max_sector); ++iy)
+		{
+			for (int32 ix = std::max(sector_x - 1, 0); ix <= std::min(sector_x + 1, max_sector); ++ix)
+			{
+				set_sector_bit(bitmap, (iy * grid_dimension_type::sectors_grid_w) + ix, true);
+			}
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::refresh_active_sector_lists()
+	{
+		number_of_active_sectors = static_cast<sector_count_type>(sector_bitmap_to_list(active_sector_bitmap, active_sectors.data()));
+
+		std::for_each(active_sectors_by_colour.begin(), active_sectors_by_colour.end(), [](auto& sectors_of_colour) { sectors_of_colour.clear(); });
+
+		//every sector touching an active sector
+		sector_bitmap_type neighbour_bitmap = {};
+
+		for (uint32_t i = 0; i < number_of_active_sectors; ++i)
+		{
+			sector_count_type sector_index = active_sectors[i];
+
+			active_sectors_by_colour[get_sector_colour(sector_index)].push_back(sector_index);
+
+			set_sector_and_neighbour_bits(neighbour_bitmap, sector_index);
+		}
+
+		number_of_active_and_neighbouring_sectors = static_cast<sector_count_type>(sector_bitmap_to_list(neighbour_bitmap, active_and_neighbouring_sectors.data()));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::generate_pairs_in_sector(sector_count_type sector_index, uint32_t worker_index)
+	{
+		PROFILE_ZONE("generate_pairs_in_sector");
+
+		auto& pair_buffer = collider_pairs_per_sector[sector_index];
+
+		pair_buffer.clear();
+
+		uint32_t pairs_found = 0;
+
+		//get the iterators for the sector
+		auto begin_itr = colliders_in_tile_tracker.get_active_nodes_in_group_start(sector_index);
+		auto end_itr = colliders_in_tile_tracker.get_active_nodes_in_group_end(sector_index);
+
+		//sector offset 
+		auto tile_offset = sector_index * grid_dimension_type::sector_tile_count;
+
+		//list of the tiles each tile in this sector overlaps with
+		auto& sector_overlap_pairs = overlap_grid.overlap_pairs[sector_index];
+
+		//the offset to get to the top left corner of the tile pair window
+		const auto window_offset = math_2d_util::byte_vector_2d::center_as<math_2d_util::ivec2d>();
+
+		using sector_type_type = typename sector_grid_helper_type::sector_tile_index_type;
+
+		//copy of the colliders in the tile we are generating pairs for so we are not jumping through the handle lookup for every test
+		std::array<handle_type, max_colliders_per_tile_for_pairs> tile_handles;
+		std::array<scalar_type, max_colliders_per_tile_for_pairs> tile_x;
+		std::array<scalar_type, max_colliders_per_tile_for_pairs> tile_y;
+		std::array<scalar_type, max_colliders_per_tile_for_pairs> tile_radius;
+		std::array<bool, max_colliders_per_tile_for_pairs> tile_is_sleeping;
+
+		//radius plus the distance the collider will move next step
+		auto get_swept_radius = [&](const auto& ref_struct)
+			{
+				scalar_type move_x = ref_struct.velocity_x * time_step;
+				scalar_type move_y = ref_struct.velocity_y * time_step;
+
+				return ref_struct.radius + Tnumeric_policy::length(move_x, move_y);
+			};
+
+		//test a collider against everything in the tile cache starting at start index
+		auto test_against_tile = [&](uint32_t start_index, uint32_t tile_count, handle_type other_handle, scalar_type other_x, scalar_type other_y, scalar_type other_radius, bool other_is_sleeping)
+			{
+				for (uint32_t i = start_index; i < tile_count; ++i)
+				{
+					scalar_type dif_x = tile_x[i] - other_x;
+					scalar_type dif_y = tile_y[i] - other_y;
+
+					scalar_type combined_radius = tile_radius[i] + other_radius;
+
+					//discrete sphere check using the swept radius so anything that could touch during the next step is included
+					//2 sleeping colliders cant push each other so they dont need a pair
+					bool is_touching = Tnumeric_policy::is_shorter_than(dif_x, dif_y, combined_radius) && !(tile_is_sleeping[i] && other_is_sleeping);
+
+					//keep counting even when the buffer is full so the budget can be sized
+					bool has_room = pair_buffer.size() < max_collider_pairs_per_sector;
+
+					pair_buffer.push_back(collider_pair{ tile_handles[i], other_handle }, is_touching && has_room);
+
+					pairs_found += is_touching;
+				}
+			};
+
+		//loop through all active tiles in the sector
+		std::for_each(begin_itr, end_itr, [&](auto root_index)
+			{
+				//convert from subtile to global tile 
+				auto world_tile = root_index + tile_offset;
+
+				//convert to a tile type
+				sector_type_type tile = sector_type_type{ static_cast<sector_type_type::combined_index>(world_tile) };
+
+				//get the tils coordinate
+				math_2d_util::ivec2d tile_coordinate = grid_helper.to_xy<math_2d_util::ivec2d>(tile);
+
+				//number of colliders in the whole tile, only known after the first chunk has been gathered
+				uint32_t tile_collider_count = 0;
+
+				//a packed tile can hold more colliders than the cache so it is done a chunk at a time
+				//each chunk is tested against itself, the rest of the tile after it and the overlapping tiles so every pair is still found once
+				for (uint32_t chunk_start = 0; (chunk_start == 0) || (chunk_start < tile_collider_count); chunk_start += max_colliders_per_tile_for_pairs)
+				{
+					//gather the colliders in this chunk of the tile
+					uint32_t tile_count = 0;
+					uint32_t index_in_tile = 0;
+
+					std::for_each(colliders_in_tile_tracker.get_root_node_start(world_tile), colliders_in_tile_tracker.end(),
+						[&](auto handle)
+						{
+							bool is_in_chunk = (index_in_tile >= chunk_start) && (tile_count < max_colliders_per_tile_for_pairs);
+
+							++index_in_tile;
+
+							if (!is_in_chunk)
+							{
+								return;
+							}
+
+							typename collision_data_container_type::handle_reference_wrapper ref_struct = collision_data_container.get(handle);
+
+							tile_handles[tile_count] = handle;
+							tile_x[tile_count] = ref_struct.x;
+							tile_y[tile_count] = ref_struct.y;
+							tile_radius[tile_count] = get_swept_radius(ref_struct);
+							tile_is_sleeping[tile_count] = is_sleeping(handle);
+
+							++tile_count;
+						});
+
+					tile_collider_count = index_in_tile;
+
+					//pairs inside the chunk, each collider only tests the ones after it
+					for (uint32_t i = 0; i < tile_count; ++i)
+					{
+						test_against_tile(i + 1, tile_count, tile_handles[i], tile_x[i], tile_y[i], tile_radius[i], tile_is_sleeping[i]);
+					}
+
+					//pairs with the colliders in the later chunks of the same tile, these are read through the handles
+					if (chunk_start + tile_count < tile_collider_count)
+					{
+						if constexpr (is_physics_stats_enabled)
+						{
+							per_worker_scratch_buffers[worker_index].step_stats.oversized_pair_tiles += chunk_start == 0;
+						}
+
+						uint32_t other_index_in_tile = 0;
+
+						std::for_each(colliders_in_tile_tracker.get_root_node_start(world_tile), colliders_in_tile_tracker.end(),
+							[&](auto other_handle)
+							{
+								if (other_index_in_tile++ < chunk_start + tile_count)
+								{
+									return;
+								}
+
+								typename collision_data_container_type::handle_reference_wrapper other_ref_struct = collision_data_container.get(other_handle);
+
+								test_against_tile(0, tile_count, other_handle, other_ref_struct.x, other_ref_struct.y, get_swept_radius(other_ref_struct), is_sleeping(other_handle));
+							});
+					}
+
+					//the top left corner of the window the overlapping tiles are stored relative to
+					const auto overlap_pair_top_left_corner = tile_coordinate - window_offset;
+
+					//pairs with all the tiles this tile overlaps 
+					std::for_each(sector_overlap_pairs.get_root_node_start(grid_helper.to_sub_sector_index(tile)), sector_overlap_pairs.end(),
+						[&](const math_2d_util::byte_vector_2d& offset_to_other_tile)
+						{
+							math_2d_util::ivec2d other_tile_coordinate = overlap_pair_top_left_corner + static_cast<math_2d_util::ivec2d>(offset_to_other_tile);
+
+							auto other_tile = grid_helper.from_xy(other_tile_coordinate);
+
+							//tile overlaps are stored on both tiles, only the tile with the lower index creates the pairs
+							if (other_tile.index <= tile.index)
+							{
+								return;
+							}
+
+							std::for_each(colliders_in_tile_tracker.get_root_node_start(other_tile.index), colliders_in_tile_tracker.end(),
+								[&](auto other_handle)
+								{
+									typename collision_data_container_type::handle_reference_wrapper other_ref_struct = collision_data_container.get(other_handle);
+
+									test_against_tile(0, tile_count, other_handle, other_ref_struct.x, other_ref_struct.y, get_swept_radius(other_ref_struct), is_sleeping(other_handle));
+								});
+						});
+				}
+			});
+
+		collider_pairs_found_per_sector[sector_index] = pairs_found;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::generate_pairs_in_all_sectors()
+	{
+		PROFILE_ZONE("generate_pairs_in_all_sectors");
+
+		//pair generation only reads from the neighbouring sectors and only writes to its own pair buffer
+		run_on_active_sectors([&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				generate_pairs_in_sector(sector_index, worker_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::calculate_time_of_impact_in_sector(sector_count_type sector_index, uint32_t worker_index)
+	{
+		PROFILE_ZONE("calculate_time_of_impact_in_sector");
+
+		auto& pair_buffer = collider_pairs_per_sector[sector_index];
+
+		auto& scratch = per_worker_time_of_impact_scratch_buffers[worker_index];
+
+		uint32 pair_count = pair_buffer.size();
+
+		//convert the handles to addresses in the collider arrays
+		for (uint32 ipair = 0; ipair < pair_count; ++ipair)
+		{
+			scratch.address_a[ipair] = static_cast<uint32>(collision_data_container.get_real_address(pair_buffer[ipair].collider_a).address);
+			scratch.address_b[ipair] = static_cast<uint32>(collision_data_container.get_real_address(pair_buffer[ipair].collider_b).address);
+		}
+
+		swept_circle_time_of_impact::calculate_for_pairs(
+			get_collision_data_field<collision_data_field::X>(),
+			get_collision_data_field<collision_data_field::Y>(),
+			get_collision_data_field<collision_data_field::VELOCITY_X>(),
+			get_collision_data_field<collision_data_field::VELOCITY_Y>(),
+			get_collision_data_field<collision_data_field::RADIUS>(),
+			std::span<const uint32>(scratch.address_a.data(), pair_count),
+			std::span<const uint32>(scratch.address_b.data(), pair_count),
+			time_step,
+			std::span<scalar_type>(scratch.time_of_impact.data(), pair_count));
+
+		//keep the earliest hit for each collider
+		for (uint32 ipair = 0; ipair < pair_count; ++ipair)
+		{
+			scalar_type& time_of_impact_a = time_of_impact_per_collider[pair_buffer[ipair].collider_a.get_index()];
+			scalar_type& time_of_impact_b = time_of_impact_per_collider[pair_buffer[ipair].collider_b.get_index()];
+
+			time_of_impact_a = std::min(time_of_impact_a, scratch.time_of_impact[ipair]);
+			time_of_impact_b = std::min(time_of_impact_b, scratch.time_of_impact[ipair]);
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::calculate_time_of_impact_in_all_sectors()
+	{
+		PROFILE_ZONE("calculate_time_of_impact_in_all_sectors");
+
+		//everything gets to do its full move unless it hits something
+		std::fill(time_of_impact_per_collider.begin(), time_of_impact_per_collider.end(), Tnumeric_policy::from_float(swept_circle_time_of_impact::no_impact));
+
+		//pairs can include colliders in the neighbouring sectors so run one colour at a time
+		run_on_active_sectors_coloured([&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				calculate_time_of_impact_in_sector(sector_index, worker_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::scalar_type phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_time_of_impact(handle_type handle) const
+	{
+		return time_of_impact_per_collider[handle.get_index()];
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::accumulate_impulses_in_sector(sector_count_type sector_index)
+	{
+		PROFILE_ZONE("accumulate_impulses_in_sector");
+
+		auto& pair_buffer = collider_pairs_per_sector[sector_index];
+		auto& boundary_buffer = boundary_impulses_per_sector[sector_index];
+
+		//nobody reads the boundary buffer while impulses are being accumulated
+		boundary_buffer.clear();
+
+		auto x = get_collision_data_field<collision_data_field::X>();
+		auto y = get_collision_data_field<collision_data_field::Y>();
+		auto velocity_x = get_collision_data_field<collision_data_field::VELOCITY_X>();
+		auto velocity_y = get_collision_data_field<collision_data_field::VELOCITY_Y>();
+		auto impulse_x = get_collision_data_field<collision_data_field::IMPULSE_X>();
+		auto impulse_y = get_collision_data_field<collision_data_field::IMPULSE_Y>();
+		auto radius = get_collision_data_field<collision_data_field::RADIUS>();
+
+		//scratch value to write impulses we dont want to keep into
+		scalar_type discard_impulse = scalar_type(0.0f);
+
+		for (uint32 ipair = 0; ipair < pair_buffer.size(); ++ipair)
+		{
+			auto address_a = collision_data_container.get_real_address(pair_buffer[ipair].collider_a);
+			auto address_b = collision_data_container.get_real_address(pair_buffer[ipair].collider_b);
+
+			uint32 a = static_cast<uint32>(address_a.address);
+			uint32 b = static_cast<uint32>(address_b.address);
+
+			scalar_type dif_x = x[b] - x[a];
+			scalar_type dif_y = y[b] - y[a];
+
+			scalar_type combined_radius = radius[a] + radius[b];
+
+			bool is_touching = Tnumeric_policy::is_shorter_than(dif_x, dif_y, combined_radius);
+
+			scalar_type distance = Tnumeric_policy::length(dif_x, dif_y);
+
+			//colliders sitting right on top of each other get pushed apart along x
+			bool is_degenerate = distance <= Tnumeric_policy::epsilon;
+
+			scalar_type inverse_distance = is_degenerate ? scalar_type(0.0f) : scalar_type(1.0f) / distance;
+
+			scalar_type normal_x = is_degenerate ? scalar_type(1.0f) : dif_x * inverse_distance;
+			scalar_type normal_y = dif_y * inverse_distance;
+
+			scalar_type overlap = combined_radius - distance;
+
+			//speed a and b are moving towards each other along the normal 
+			scalar_type closing_speed = ((velocity_x[a] - velocity_x[b]) * normal_x) + ((velocity_y[a] - velocity_y[b]) * normal_y);
+
+			//extra speed to push out some of the overlap this step
+			scalar_type separation_speed = (overlap * solver_separation_stiffness) / time_step;
+
+			//all colliders weigh the same so each side takes half
+			scalar_type impulse = is_touching ? std::max(closing_speed + separation_speed, scalar_type(0.0f)) * scalar_type(0.5f) : scalar_type(0.0f);
+
+			//a is always in this sector because the pair was made from a tile in this sector
+			impulse_x[a] -= normal_x * impulse;
+			impulse_y[a] -= normal_y * impulse;
+
+			//b may be in a neighbouring sector
+			math_2d_util::ivec2d tile_b = static_cast<math_2d_util::ivec2d>(scalar_vec2d(x[b], y[b]));
+
+			sector_count_type sector_b = static_cast<sector_count_type>(grid_helper.to_sector_index(tile_b));
+
+			bool is_in_this_sector = sector_b == sector_index;
+
+			scalar_type& write_target_x = is_in_this_sector ? impulse_x[b] : discard_impulse;
+			write_target_x += normal_x * impulse;
+
+			scalar_type& write_target_y = is_in_this_sector ? impulse_y[b] : discard_impulse;
+			write_target_y += normal_y * impulse;
+
+			//there is at most one boundary impulse per pair so this can never overflow
+			boundary_buffer.push_back(boundary_impulse{ address_b, sector_b, normal_x * impulse, normal_y * impulse }, !is_in_this_sector && is_touching);
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::apply_impulses_in_sector(sector_count_type sector_index)
+	{
+		PROFILE_ZONE("apply_impulses_in_sector");
+
+		auto velocity_x = get_collision_data_field<collision_data_field::VELOCITY_X>();
+		auto velocity_y = get_collision_data_field<collision_data_field::VELOCITY_Y>();
+		auto impulse_x = get_collision_data_field<collision_data_field::IMPULSE_X>();
+		auto impulse_y = get_collision_data_field<collision_data_field::IMPULSE_Y>();
+
+		//boundary fix up, pull in the impulses the neighbouring sectors made for colliders in this sector
+		int32 sector_x = sector_index % grid_dimension_type::sectors_grid_w;
+		int32 sector_y = sector_index / grid_dimension_type::sectors_grid_w;
+
+		constexpr int32 max_sector = grid_dimension_type::sectors_grid_w - 1;
+
+		for (int32 iy = std::max(sector_y - 1, 0); iy <= std::min(sector_y + 1, max_sector); ++iy)
+		{
+			for (int32 ix = std::max(sector_x - 1, 0); ix <= std::min(sector_x + 1, max_sector); ++ix)
+			{
+				const auto& neighbour_buffer = boundary_impulses_per_sector[(iy * grid_dimension_type::sectors_grid_w) + ix];
+
+				for (uint32 i = 0; i < neighbour_buffer.size(); ++i)
+				{
+					const boundary_impulse& entry = neighbour_buffer[i];
+
+					//the other sectors next to this buffer are reading it at the same time, even adding 0 to one of their colliders
+					//would be a read and write racing with their own update so entries for other sectors are skipped
+					if (entry.target_sector != sector_index)
+					{
+						continue;
+					}
+
+					impulse_x[entry.address.address] += entry.impulse_x;
+					impulse_y[entry.address.address] += entry.impulse_y;
+				}
+			}
+		}
+
+		//heavily packed colliders can stack up a lot of push out speed, cap what the solver adds so it never pushes anything further in a step
+		//than the overlap grid can see, colliders the game already has moving faster than this keep their speed
+		const scalar_type max_solved_speed = scalar_type(static_cast<int32>(max_solved_tiles_per_step)) / time_step;
+
+		//apply and clear the impulses
+		auto page_begin_itr = collision_data_container.get_tight_packed_data().get_array_header().page_begin(sector_index);
+		auto page_end_itr = collision_data_container.get_tight_packed_data().get_array_header().page_end(sector_index);
+
+		std::for_each(page_begin_itr, page_end_itr, [&](auto& page_address_and_count)
+			{
+				uint32 page_start = static_cast<uint32>(page_address_and_count.page_start_address.address);
+				uint32 page_end = page_start + page_address_and_count.items_in_page;
+
+				for (uint32 i = page_start; i < page_end; ++i)
+				{
+					scalar_type speed_before_impulse = Tnumeric_policy::length(velocity_x[i], velocity_y[i]);
+
+					velocity_x[i] += impulse_x[i];
+					velocity_y[i] += impulse_y[i];
+
+					//colliders with no impulse come out at exactly the speed they went in with so they are never scaled
+					scalar_type speed_limit = std::max(speed_before_impulse, max_solved_speed);
+
+					scalar_type speed = Tnumeric_policy::length(velocity_x[i], velocity_y[i]);
+					scalar_type speed_scale = speed > speed_limit ? speed_limit / speed : scalar_type(1.0f);
+
+					velocity_x[i] *= speed_scale;
+					velocity_y[i] *= speed_scale;
+
+					impulse_x[i] = scalar_type(0.0f);
+					impulse_y[i] = scalar_type(0.0f);
+				}
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::solve_collisions_in_all_sectors()
+	{
+		PROFILE_ZONE("solve_collisions_in_all_sectors");
+
+		for (uint32_t iteration = 0; iteration < solver_iterations; ++iteration)
+		{
+			//each sector only writes to its own colliders and its own boundary buffer
+			run_on_active_sectors([&](sector_count_type sector_index, uint32_t worker_index)
+				{
+					accumulate_impulses_in_sector(sector_index);
+				});
+
+			//each sector only reads the neighbouring boundary buffers and writes to its own colliders
+			run_on_active_sectors([&](sector_count_type sector_index, uint32_t worker_index)
+				{
+					apply_impulses_in_sector(sector_index);
+				});
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_solver_iterations(uint32_t iterations)
+	{
+		solver_iterations = iterations;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_solver_iterations() const
+	{
+		return solver_iterations;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_max_sub_steps(uint32_t sub_steps)
+	{
+		max_sub_steps = std::max<uint32_t>(sub_steps, 1);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_max_sub_steps() const
+	{
+		return max_sub_steps;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_sub_step_max_move(float tiles)
+	{
+		assert(tiles > 0.0f);
+
+		sub_step_max_move = Tnumeric_policy::from_float(tiles);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline float phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_sub_step_max_move() const
+	{
+		return Tnumeric_policy::to_float(sub_step_max_move);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::is_sleeping(handle_type handle) const
+	{
+		return (sleep_step_count != 0) && (steps_at_rest_per_collider[handle.get_index()] >= sleep_step_count);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::swap_colliders_in_sector(sector_count_type sector_index, uint32_t index_a, uint32_t index_b)
+	{
+		using virtual_y_axis_address_type = typename collision_data_container_type::virtual_y_axis_node_adderss_type;
+
+		if (index_a == index_b)
+		{
+			return;
+		}
+
+		collision_data_container.swap_in_axis(sector_index, virtual_y_axis_address_type(index_a), virtual_y_axis_address_type(index_b));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_sleep_state_in_sector(sector_count_type sector_index)
+	{
+		PROFILE_ZONE("update_sleep_state_in_sector");
+
+		using virtual_y_axis_address_type = typename collision_data_container_type::virtual_y_axis_node_adderss_type;
+
+		auto x = get_collision_data_field<collision_data_field::X>();
+		auto y = get_collision_data_field<collision_data_field::Y>();
+		auto velocity_x = get_collision_data_field<collision_data_field::VELOCITY_X>();
+		auto velocity_y = get_collision_data_field<collision_data_field::VELOCITY_Y>();
+		auto handles = get_collision_data_handles();
+
+		uint32_t& sleeping_count = sleeping_colliders_per_sector[sector_index];
+
+		uint32_t sector_item_count = collision_data_container.get_tight_packed_data().get_array_header().y_axis_count[sector_index];
+
+		auto get_address = [&](uint32_t index_in_sector)
+			{
+				return static_cast<uint32_t>(collision_data_container.get_tight_packed_data().resolve_address(sector_index, virtual_y_axis_address_type(index_in_sector)).address);
+			};
+
+		auto is_below_sleep_speed = [&](uint32_t address)
+			{
+				return Tnumeric_policy::is_shorter_than(velocity_x[address], velocity_y[address], sleep_velocity_threshold);
+			};
+
+		//wake anything that got pushed hard enough or was woken from outside
+		//go backwards so the collider swapped into the current slot has already been checked
+		for (uint32_t i = sleeping_count; i > 0;)
+		{
+			--i;
+
+			uint32_t address = get_address(i);
+
+			handle_type handle = handles[address];
+
+			if (!is_below_sleep_speed(address) || !is_sleeping(handle))
+			{
+				steps_at_rest_per_collider[handle.get_index()] = 0;
+
+				swap_colliders_in_sector(sector_index, i, sleeping_count - 1);
+
+				--sleeping_count;
+
+				continue;
+			}
+
+			//not pushed hard enough to wake so stay exactly where we are
+			velocity_x[address] = scalar_type(0.0f);
+			velocity_y[address] = scalar_type(0.0f);
+		}
+
+		if (sleep_step_count == 0)
+		{
+			return;
+		}
+
+		//count how long each awake collider has been resting and move the ones that have rested long enough into the sleeping block
+		for (uint32_t i = sleeping_count; i < sector_item_count; ++i)
+		{
+			uint32_t address = get_address(i);
+
+			uint16_t& steps_at_rest = steps_at_rest_per_collider[handles[address].get_index()];
+
+			bool is_resting = is_below_sleep_speed(address);
+
+			steps_at_rest = is_resting ? std::min(static_cast<uint16_t>(steps_at_rest + 1), sleep_step_count) : 0;
+
+			if (steps_at_rest < sleep_step_count)
+			{
+				continue;
+			}
+
+			velocity_x[address] = scalar_type(0.0f);
+			velocity_y[address] = scalar_type(0.0f);
+
+			//stopping shrinks its swept bounds and sleeping colliders are not checked by the integration pass so mark the tile here
+			mark_tile_bounds_dirty(grid_helper.from_xy(static_cast<math_2d_util::ivec2d>(scalar_vec2d(x[address], y[address]))).index);
+
+			//the collider swapped in from the start of the awake block has already been checked
+			swap_colliders_in_sector(sector_index, i, sleeping_count);
+
+			++sleeping_count;
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_sleep_state_in_all_sectors()
+	{
+		PROFILE_ZONE("update_sleep_state_in_all_sectors");
+
+		//colliders never change sector while sleeping so each sector only touches its own data
+		run_on_active_sectors([&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				update_sleep_state_in_sector(sector_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_sleep_step_count(uint16_t step_count)
+	{
+		//anything that no longer counts as sleeping gets moved out of the sleeping block in the next sleep update
+		sleep_step_count = step_count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint16_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_sleep_step_count() const
+	{
+		return sleep_step_count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::is_collider_sleeping(handle_type handle) const
+	{
+		return is_sleeping(handle);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_sleeping_collider_count_in_sector(sector_count_type sector_index) const
+	{
+		return sleeping_colliders_per_sector[sector_index];
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::wake_collider(handle_type handle)
+	{
+		wake_collider_in_sector(handle, get_sector_of_collider(handle));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::wake_collider_in_sector(handle_type handle, sector_count_type sector_index)
+	{
+		bool was_sleeping = is_sleeping(handle);
+
+		steps_at_rest_per_collider[handle.get_index()] = 0;
+
+		if (!was_sleeping)
+		{
+			return;
+		}
+
+		//move it out of the sleeping block now so it gets integrated next step
+		uint32_t index_in_sector = get_index_in_sector(handle, sector_index);
+
+		uint32_t& sleeping_count = sleeping_colliders_per_sector[sector_index];
+
+		assert(index_in_sector < sleeping_count);
+
+		swap_colliders_in_sector(sector_index, index_in_sector, sleeping_count - 1);
+
+		--sleeping_count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_velocity(handle_type handle, scalar_vec2d velocity)
+	{
+		wake_collider(handle);
+
+		auto ref_struct = collision_data_container.get(handle);
+
+		ref_struct.velocity_x = velocity.x;
+		ref_struct.velocity_y = velocity.y;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::queue_velocity_command(handle_type handle, scalar_vec2d velocity)
+	{
+		bool can_queue = is_handle_live(handle) && (queued_motion_commands.size() < queued_motion_commands.max_size());
+
+		if (can_queue)
+		{
+			queued_motion_commands.push_back(motion_command{ handle, motion_command_type::SET_VELOCITY, velocity.x, velocity.y });
+		}
+
+		return can_queue;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::queue_force_command(handle_type handle, scalar_vec2d force)
+	{
+		bool can_queue = is_handle_live(handle) && (queued_motion_commands.size() < queued_motion_commands.max_size());
+
+		if (can_queue)
+		{
+			queued_motion_commands.push_back(motion_command{ handle, motion_command_type::ADD_FORCE, force.x, force.y });
+		}
+
+		return can_queue;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::sort_motion_commands()
+	{
+		//counting sort by sector, only the handle lookup is read here so this does not touch the collider data at all
+		std::array<uint32_t, grid_dimension_type::sector_grid_count> commands_per_sector = {};
+
+		std::for_each(queued_motion_commands.begin(), queued_motion_commands.end(), [&](const motion_command& command)
+			{
+				++commands_per_sector[get_sector_of_collider(command.handle)];
+			});
+
+		sectors_with_motion_commands.clear();
+
+		uint32_t running_total = 0;
+
+		for (uint32_t isector = 0; isector < grid_dimension_type::sector_grid_count; ++isector)
+		{
+			motion_command_sector_start[isector] = running_total;
+
+			running_total += commands_per_sector[isector];
+
+			sectors_with_motion_commands.push_back(static_cast<sector_count_type>(isector), commands_per_sector[isector] != 0);
+		}
+
+		motion_command_sector_start[grid_dimension_type::sector_grid_count] = running_total;
+
+		//reuse the counts as the write position for each sector
+		std::copy(motion_command_sector_start.begin(), motion_command_sector_start.end() - 1, commands_per_sector.begin());
+
+		for (uint32_t icommand = 0; icommand < queued_motion_commands.size(); ++icommand)
+		{
+			handle_type handle = queued_motion_commands[icommand].handle;
+
+			uint32_t& write_index = commands_per_sector[get_sector_of_collider(handle)];
+
+			resolved_motion_commands[write_index++] = resolved_motion_command{ static_cast<uint32_t>(collision_data_container.get_real_address(handle).address), icommand };
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::apply_motion_commands_in_sector(sector_count_type sector_index)
+	{
+		PROFILE_ZONE("apply_motion_commands_in_sector");
+
+		auto commands_begin = resolved_motion_commands.begin() + motion_command_sector_start[sector_index];
+		auto commands_end = resolved_motion_commands.begin() + motion_command_sector_start[sector_index + 1];
+
+		//a sector only has a few pages so sorting by address walks through them in order
+		std::sort(commands_begin, commands_end);
+
+		auto velocity_x = get_collision_data_field<collision_data_field::VELOCITY_X>();
+		auto velocity_y = get_collision_data_field<collision_data_field::VELOCITY_Y>();
+
+		std::for_each(commands_begin, commands_end, [&](const resolved_motion_command& resolved_command)
+			{
+				const motion_command& command = queued_motion_commands[resolved_command.command_index];
+
+				bool is_set = command.type == motion_command_type::SET_VELOCITY;
+
+				//set = replace the velocity, force = add force * time step
+				scalar_type keep_scale = is_set ? scalar_type(0.0f) : scalar_type(1.0f);
+				scalar_type command_scale = is_set ? scalar_type(1.0f) : time_step;
+
+				velocity_x[resolved_command.address] = (velocity_x[resolved_command.address] * keep_scale) + (command.x * command_scale);
+				velocity_y[resolved_command.address] = (velocity_y[resolved_command.address] * keep_scale) + (command.y * command_scale);
+			});
+
+		//waking swaps colliders around so do it after all the writes that used the resolved addresses
+		std::for_each(commands_begin, commands_end, [&](const resolved_motion_command& resolved_command)
+			{
+				wake_collider_in_sector(queued_motion_commands[resolved_command.command_index].handle, sector_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::apply_all_motion_commands()
+	{
+		PROFILE_ZONE("apply_all_motion_commands");
+
+		if (queued_motion_commands.size() == 0)
+		{
+			return;
+		}
+
+		sort_motion_commands();
+
+		//each sector only writes to its own colliders
+		run_on_sectors(std::span<const sector_count_type>(sectors_with_motion_commands.begin(), sectors_with_motion_commands.end()), [&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				apply_motion_commands_in_sector(sector_index);
+			});
+
+		queued_motion_commands.clear();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::queue_long_range_transfer(handle_type handle, scalar_vec2d position)
+	{
+		//the destination has to be a tile in the world
+		assert(position.x >= scalar_type(0.0f) && position.x < scalar_type(static_cast<int32>(grid_dimension_type::tile_w)));
+		assert(position.y >= scalar_type(0.0f) && position.y < scalar_type(static_cast<int32>(grid_dimension_type::tile_w)));
+
+		if (!is_handle_live(handle))
+		{
+			return false;
+		}
+
+		bool& is_queued = is_queued_for_long_range_transfer[handle.get_index()];
+
+		bool can_queue = !is_queued && !is_queued_for_removal[handle.get_index()] && queued_long_range_transfers.size() < queued_long_range_transfers.max_size();
+
+		if (can_queue)
+		{
+			is_queued = true;
+
+			queued_long_range_transfers.push_back(long_range_transfer{ handle, position });
+		}
+
+		return can_queue;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::push_pending_sector_move(const pending_sector_move& move)
+	{
+		//the workers only ever add so a bump of the count is all the locking needed, the pass barrier makes the writes visible
+		uint32_t move_index = pending_sector_move_count.fetch_add(1, std::memory_order_relaxed);
+
+		assert(move_index < max_pending_sector_moves);
+
+		pending_sector_moves[move_index] = move;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::sort_pending_sector_moves(uint32_t move_count)
+	{
+		//counting sort by both the sector the collider is leaving and the one it is going to
+		std::array<uint32_t, grid_dimension_type::sector_grid_count> moves_per_source = {};
+		std::array<uint32_t, grid_dimension_type::sector_grid_count> moves_per_destination = {};
+
+		auto get_destination_sector = [&](const pending_sector_move& move)
+			{
+				return grid_helper.to_sector_index(static_cast<math_2d_util::ivec2d>(move.to_position));
+			};
+
+		std::for_each(pending_sector_moves.begin(), pending_sector_moves.begin() + move_count, [&](const pending_sector_move& move)
+			{
+				++moves_per_source[get_sector_of_collider(move.handle)];
+				++moves_per_destination[get_destination_sector(move)];
+			});
+
+		sectors_with_move_departures.clear();
+		sectors_with_move_arrivals.clear();
+
+		uint32_t source_total = 0;
+		uint32_t destination_total = 0;
+
+		for (uint32_t isector = 0; isector < grid_dimension_type::sector_grid_count; ++isector)
+		{
+			sector_move_source_start[isector] = source_total;
+			sector_move_destination_start[isector] = destination_total;
+
+			source_total += moves_per_source[isector];
+			destination_total += moves_per_destination[isector];
+
+			sectors_with_move_departures.push_back(static_cast<sector_count_type>(isector), moves_per_source[isector] != 0);
+			sectors_with_move_arrivals.push_back(static_cast<sector_count_type>(isector), moves_per_destination[isector] != 0);
+		}
+
+		sector_move_source_start[grid_dimension_type::sector_grid_count] = source_total;
+		sector_move_destination_start[grid_dimension_type::sector_grid_count] = destination_total;
+
+		//reuse the counts as the write position for each sector
+		std::copy(sector_move_source_start.begin(), sector_move_source_start.end() - 1, moves_per_source.begin());
+		std::copy(sector_move_destination_start.begin(), sector_move_destination_start.end() - 1, moves_per_destination.begin());
+
+		std::for_each(pending_sector_moves.begin(), pending_sector_moves.begin() + move_count, [&](const pending_sector_move& move)
+			{
+				sector_moves_by_source[moves_per_source[get_sector_of_collider(move.handle)]++] = move;
+			});
+
+		//the workers fill the pool in whatever order they get to it but each sector only ever adds in one order
+		//so the arrivals are filled from the source buckets to keep the order they land in the same every run
+		std::for_each(sector_moves_by_source.begin(), sector_moves_by_source.begin() + move_count, [&](const pending_sector_move& move)
+			{
+				//copy the data out now as the departure pass shuffles the source sectors
+				auto ref_struct = collision_data_container.get(move.handle);
+
+				sector_moves_by_destination[moves_per_destination[get_destination_sector(move)]++] = new_collider_data(move.handle, move.to_position, scalar_vec2d(ref_struct.velocity_x, ref_struct.velocity_y), ref_struct.radius);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::remove_move_departures_from_sector(sector_count_type sector_index, uint32_t worker_index)
+	{
+		PROFILE_ZONE("remove_move_departures_from_sector");
+
+		auto departures_begin = sector_moves_by_source.begin() + sector_move_source_start[sector_index];
+		auto departures_end = sector_moves_by_source.begin() + sector_move_source_start[sector_index + 1];
+
+		std::for_each(departures_begin, departures_end, [&](const pending_sector_move& move)
+			{
+				detach_collider_from_sector(move.handle, move.from_tile, sector_index, worker_index);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::add_move_arrivals_to_sector(sector_count_type sector_index, uint32_t worker_index)
+	{
+		PROFILE_ZONE("add_move_arrivals_to_sector");
+
+		using paged_array_type = typename collision_data_container_type::paged_array_type;
+
+		auto arrivals_begin = sector_moves_by_destination.begin() + sector_move_destination_start[sector_index];
+		auto arrivals_end = sector_moves_by_destination.begin() + sector_move_destination_start[sector_index + 1];
+
+		uint32_t arrival_count = static_cast<uint32_t>(std::distance(arrivals_begin, arrivals_end));
+
+		//the new items go on the end of the sector, get the virtual address of the first one before the sector grows
+		auto sector_item_count = collision_data_container.get_tight_packed_data().get_array_header().y_axis_count[sector_index];
+
+		typename collision_data_container_type::virtual_combined_node_adderss_type new_virtual_address = paged_array_type::convert_from_y_axis_to_combined_virtual_address(sector_index, typename collision_data_container_type::virtual_y_axis_node_adderss_type(sector_item_count));
+
+		//grow the sector once for all the arrivals
+		auto [begin_itr, end_itr] = collision_data_container.reserve_space_for_move(sector_index, arrival_count);
+
+		auto arrival_itr = arrivals_begin;
+
+		std::for_each(begin_itr, end_itr, [&](auto real_address)
+			{
+				const new_collider_data& arrival = *arrival_itr;
+
+				++arrival_itr;
+
+				//point the handle at the new space and copy the data in
+				auto ref_struct = collision_data_container.overwrite(arrival.owner, real_address, new_virtual_address++);
+
+				ref_struct.x = arrival.position.x;
+				ref_struct.y = arrival.position.y;
+
+				ref_struct.velocity_x = arrival.velocity.x;
+				ref_struct.velocity_y = arrival.velocity.y;
+
+				ref_struct.impulse_x = scalar_type(0.0f);
+				ref_struct.impulse_y = scalar_type(0.0f);
+
+				ref_struct.radius = arrival.radius;
+
+				//the collider lands awake
+				steps_at_rest_per_collider[arrival.owner.get_index()] = 0;
+
+				add_collider_handle_to_tile_tracker(arrival);
+			});
+
+		assert(arrival_itr == arrivals_end);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::apply_pending_sector_moves()
+	{
+		PROFILE_ZONE("apply_pending_sector_moves");
+
+		uint32_t move_count = pending_sector_move_count.load(std::memory_order_relaxed);
+
+		if (move_count == 0)
+		{
+			return 0;
+		}
+
+		sort_pending_sector_moves(move_count);
+
+		pending_sector_move_count.store(0, std::memory_order_relaxed);
+
+		//clearing the overlaps of empty tiles writes to the neighbouring sectors so run it one colour at a time
+		run_on_sectors_coloured(std::span<const sector_count_type>(sectors_with_move_departures.begin(), sectors_with_move_departures.end()), [&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				remove_move_departures_from_sector(sector_index, worker_index);
+			});
+
+		//arrivals only touch the sector they land in, all the departures are out first so a move inside a sector is safe
+		run_on_sectors(std::span<const sector_count_type>(sectors_with_move_arrivals.begin(), sectors_with_move_arrivals.end()), [&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				add_move_arrivals_to_sector(sector_index, worker_index);
+			});
+
+		std::for_each(sectors_with_move_departures.begin(), sectors_with_move_departures.end(), [&](sector_count_type sector_index)
+			{
+				update_sector_active_state(sector_index);
+			});
+
+		std::for_each(sectors_with_move_arrivals.begin(), sectors_with_move_arrivals.end(), [&](sector_count_type sector_index)
+			{
+				update_sector_active_state(sector_index);
+			});
+
+		return move_count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::apply_all_long_range_transfers()
+	{
+		PROFILE_ZONE("apply_all_long_range_transfers");
+
+		if (queued_long_range_transfers.size() == 0)
+		{
+			return;
+		}
+
+		std::for_each(queued_long_range_transfers.begin(), queued_long_range_transfers.end(), [&](const long_range_transfer& transfer)
+			{
+				bool& is_queued = is_queued_for_long_range_transfer[transfer.handle.get_index()];
+
+				//colliders removed this update have had their flag cleared and are skipped
+				if (!is_queued)
+				{
+					return;
+				}
+
+				is_queued = false;
+
+				auto ref_struct = collision_data_container.get(transfer.handle);
+
+				math_2d_util::ivec2d from_tile = static_cast<math_2d_util::ivec2d>(scalar_vec2d(ref_struct.x, ref_struct.y));
+
+				push_pending_sector_move(pending_sector_move{ transfer.handle, from_tile, transfer.position });
+
+				//the time of impact was worked out at the old position
+				time_of_impact_per_collider[transfer.handle.get_index()] = scalar_type(1.0f);
+			});
+
+		queued_long_range_transfers.clear();
+
+		uint32_t transfer_count = apply_pending_sector_moves();
+
+		if constexpr (is_physics_stats_enabled)
+		{
+			//nothing else is running so count it against the first worker
+			per_worker_scratch_buffers[0].step_stats.long_range_transfers += transfer_count;
+		}
+
+		refresh_active_sector_lists();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tcollider_test>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_tiles(const math_2d_util::frect& query_bounds, std::span<handle_type> out_handles, Tcollider_test&& is_touching)
+	{
+		//colliders can stick out of their tile by up to the overlap reach so widen the tile search by that much
+		constexpr int32 max_tile_reach = overlap_tracking_grid_type::tile_overlap_max_width / 2;
+		constexpr int32 max_tile = grid_dimension_type::tile_w - 1;
+
+		//tiles the query covers, max is inclusive to match the tile bounds
+		math_2d_util::irect query_tile_rect(
+			{ static_cast<int32>(std::floor(query_bounds.min.x)), static_cast<int32>(std::floor(query_bounds.min.y)) },
+			{ static_cast<int32>(std::floor(query_bounds.max.x)), static_cast<int32>(std::floor(query_bounds.max.y)) });
+
+		int32 search_min_x = std::max(query_tile_rect.min.x - max_tile_reach, 0);
+		int32 search_min_y = std::max(query_tile_rect.min.y - max_tile_reach, 0);
+		int32 search_max_x = std::min(query_tile_rect.max.x + max_tile_reach, max_tile);
+		int32 search_max_y = std::min(query_tile_rect.max.y + max_tile_reach, max_tile);
+
+		uint32_t found_count = 0;
+
+		for (int32 tile_y = search_min_y; tile_y <= search_max_y; ++tile_y)
+		{
+			for (int32 tile_x = search_min_x; tile_x <= search_max_x; ++tile_x)
+			{
+				math_2d_util::ivec2d tile_xy(tile_x, tile_y);
+
+				auto tile = grid_helper.from_xy(tile_xy);
+
+				//tiles with nothing in them have no bounds
+				if (!overlap_grid.has_bounds(tile))
+				{
+					continue;
+				}
+
+				math_2d_util::irect tile_bounds = overlap_grid.get_world_bounds(tile_xy, tile);
+
+				bool is_tile_in_reach =
+					(tile_bounds.min.x <= query_tile_rect.max.x) && (tile_bounds.max.x >= query_tile_rect.min.x) &&
+					(tile_bounds.min.y <= query_tile_rect.max.y) && (tile_bounds.max.y >= query_tile_rect.min.y);
+
+				if (!is_tile_in_reach)
+				{
+					continue;
+				}
+
+				std::for_each(colliders_in_tile_tracker.get_root_node_start(tile.index), colliders_in_tile_tracker.end(), [&](auto handle)
+					{
+						auto ref_struct = collision_data_container.get(handle);
+
+						bool is_hit = is_touching(Tnumeric_policy::to_float(ref_struct.x), Tnumeric_policy::to_float(ref_struct.y), Tnumeric_policy::to_float(ref_struct.radius));
+
+						//keep counting once the output is full so the caller knows how many it missed
+						if (is_hit && (found_count < out_handles.size()))
+						{
+							out_handles[found_count] = handle;
+						}
+
+						found_count += is_hit;
+					});
+			}
+		}
+
+		return found_count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_circle(math_2d_util::fvec2d center, float radius, std::span<handle_type> out_handles)
+	{
+		math_2d_util::frect query_bounds({ center.x - radius, center.y - radius }, { center.x + radius, center.y + radius });
+
+		return query_tiles(query_bounds, out_handles, [&](float x, float y, float collider_radius)
+			{
+				float offset_x = x - center.x;
+				float offset_y = y - center.y;
+
+				float combined_radius = radius + collider_radius;
+
+				return ((offset_x * offset_x) + (offset_y * offset_y)) < (combined_radius * combined_radius);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_aabb(const math_2d_util::frect& rect, std::span<handle_type> out_handles)
+	{
+		return query_tiles(rect, out_handles, [&](float x, float y, float collider_radius)
+			{
+				//distance from the closest point in the rect to the collider
+				float offset_x = x - std::clamp(x, rect.min.x, rect.max.x);
+				float offset_y = y - std::clamp(y, rect.min.y, rect.max.y);
+
+				return ((offset_x * offset_x) + (offset_y * offset_y)) < (collider_radius * collider_radius);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tget_query_position, typename Trun_query>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::run_query_batch(uint32_t query_count, Tget_query_position&& get_query_position, Trun_query&& run_query)
+	{
+		constexpr float max_position = static_cast<float>(grid_dimension_type::tile_w - 1);
+
+		auto get_query_sector = [&](uint32_t query_index)
+			{
+				//queries can start outside the world so clamp them into the closest sector
+				math_2d_util::fvec2d position = get_query_position(query_index);
+
+				math_2d_util::ivec2d tile_xy(static_cast<int32>(std::clamp(position.x, 0.0f, max_position)), static_cast<int32>(std::clamp(position.y, 0.0f, max_position)));
+
+				return grid_helper.to_sector_index(tile_xy);
+			};
+
+		for (uint32_t chunk_start = 0; chunk_start < query_count; chunk_start += max_queries_per_batch)
+		{
+			uint32_t chunk_end = std::min(chunk_start + max_queries_per_batch, query_count);
+
+			//counting sort by sector so each worker walks the tiles of one sector at a time
+			std::array<uint32_t, grid_dimension_type::sector_grid_count> queries_per_sector = {};
+
+			for (uint32_t iquery = chunk_start; iquery < chunk_end; ++iquery)
+			{
+				++queries_per_sector[get_query_sector(iquery)];
+			}
+
+			sectors_with_queries.clear();
+
+			uint32_t running_total = 0;
+
+			for (uint32_t isector = 0; isector < grid_dimension_type::sector_grid_count; ++isector)
+			{
+				query_sector_start[isector] = running_total;
+
+				running_total += queries_per_sector[isector];
+
+				sectors_with_queries.push_back(static_cast<sector_count_type>(isector), queries_per_sector[isector] != 0);
+			}
+
+			query_sector_start[grid_dimension_type::sector_grid_count] = running_total;
+
+			//reuse the counts as the write position for each sector
+			std::copy(query_sector_start.begin(), query_sector_start.end() - 1, queries_per_sector.begin());
+
+			for (uint32_t iquery = chunk_start; iquery < chunk_end; ++iquery)
+			{
+				sorted_query_indexes[queries_per_sector[get_query_sector(iquery)]++] = iquery;
+			}
+
+			//queries only read the world and each one writes to its own output so the sectors can all run at once
+			run_on_sectors(std::span<const sector_count_type>(sectors_with_queries.begin(), sectors_with_queries.end()), [&](sector_count_type sector_index, uint32_t worker_index)
+				{
+					std::for_each(sorted_query_indexes.begin() + query_sector_start[sector_index], sorted_query_indexes.begin() + query_sector_start[sector_index + 1], [&](uint32_t query_index)
+						{
+							run_query(query_index);
+						});
+				});
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_circles(std::span<const circle_query> queries, uint32_t max_results_per_query, std::span<handle_type> out_handles, std::span<uint32_t> out_result_counts)
+	{
+		assert(out_handles.size() >= queries.size() * max_results_per_query);
+		assert(out_result_counts.size() >= queries.size());
+
+		run_query_batch(static_cast<uint32_t>(queries.size()),
+			[&](uint32_t query_index)
+			{
+				return queries[query_index].center;
+			},
+			[&](uint32_t query_index)
+			{
+				out_result_counts[query_index] = query_circle(queries[query_index].center, queries[query_index].radius, out_handles.subspan(query_index * max_results_per_query, max_results_per_query));
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_aabbs(std::span<const math_2d_util::frect> queries, uint32_t max_results_per_query, std::span<handle_type> out_handles, std::span<uint32_t> out_result_counts)
+	{
+		assert(out_handles.size() >= queries.size() * max_results_per_query);
+		assert(out_result_counts.size() >= queries.size());
+
+		run_query_batch(static_cast<uint32_t>(queries.size()),
+			[&](uint32_t query_index)
+			{
+				const math_2d_util::frect& rect = queries[query_index];
+
+				return math_2d_util::fvec2d((rect.min.x + rect.max.x) * 0.5f, (rect.min.y + rect.max.y) * 0.5f);
+			},
+			[&](uint32_t query_index)
+			{
+				out_result_counts[query_index] = query_aabb(queries[query_index], out_handles.subspan(query_index * max_results_per_query, max_results_per_query));
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::raycast_hit 
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::cast_ray(math_2d_util::fvec2d origin, math_2d_util::fvec2d direction, float max_distance, float radius, handle_type ignore_handle)
+	{
+		constexpr int32 max_tile_reach = overlap_tracking_grid_type::tile_overlap_max_width / 2;
+		constexpr int32 max_tile = grid_dimension_type::tile_w - 1;
+		constexpr float world_size = static_cast<float>(grid_dimension_type::tile_w);
+		constexpr float no_crossing = std::numeric_limits<float>::max();
+
+		raycast_hit closest_hit;
+		closest_hit.distance = max_distance;
+
+		//clip the ray to the world so the walk starts and ends inside the grid
+		float start_distance = 0.0f;
+		float end_distance = max_distance;
+
+		auto clip_to_world = [&](float start, float step)
+			{
+				if (step == 0.0f)
+				{
+					bool is_inside = (start >= 0.0f) && (start < world_size);
+
+					end_distance = is_inside ? end_distance : -1.0f;
+
+					return;
+				}
+
+				float distance_a = (0.0f - start) / step;
+				float distance_b = (world_size - start) / step;
+
+				start_distance = std::max(start_distance, std::min(distance_a, distance_b));
+				end_distance = std::min(end_distance, std::max(distance_a, distance_b));
+			};
+
+		clip_to_world(origin.x, direction.x);
+		clip_to_world(origin.y, direction.y);
+
+		if (start_distance > end_distance)
+		{
+			return closest_hit;
+		}
+
+		//the ray radius makes colliders reach further so grow the bounds and the search by it
+		int32 radius_tiles = static_cast<int32>(std::ceil(radius));
+		int32 search_reach = max_tile_reach + radius_tiles;
+
+		int32 tile_x = std::clamp(static_cast<int32>(std::floor(origin.x + (direction.x * start_distance))), 0, max_tile);
+		int32 tile_y = std::clamp(static_cast<int32>(std::floor(origin.y + (direction.y * start_distance))), 0, max_tile);
+
+		int32 step_x = direction.x < 0.0f ? -1 : 1;
+		int32 step_y = direction.y < 0.0f ? -1 : 1;
+
+		//distance along the ray to cross a whole tile and to cross into the next tile on each axis
+		float tile_distance_x = direction.x != 0.0f ? std::abs(1.0f / direction.x) : no_crossing;
+		float tile_distance_y = direction.y != 0.0f ? std::abs(1.0f / direction.y) : no_crossing;
+
+		float next_crossing_x = direction.x != 0.0f ? (static_cast<float>(tile_x + (step_x > 0)) - origin.x) / direction.x : no_crossing;
+		float next_crossing_y = direction.y != 0.0f ? (static_cast<float>(tile_y + (step_y > 0)) - origin.y) / direction.y : no_crossing;
+
+		auto test_collider = [&](auto handle)
+			{
+				auto ref_struct = collision_data_container.get(handle);
+
+				float offset_x = origin.x - Tnumeric_policy::to_float(ref_struct.x);
+				float offset_y = origin.y - Tnumeric_policy::to_float(ref_struct.y);
+
+				float combined_radius = Tnumeric_policy::to_float(ref_struct.radius) + radius;
+
+				//solving |offset + direction * t| = combined radius, the direction is normalized so a = 1
+				float half_b = (offset_x * direction.x) + (offset_y * direction.y);
+				float c = ((offset_x * offset_x) + (offset_y * offset_y)) - (combined_radius * combined_radius);
+
+				float discriminant = (half_b * half_b) - c;
+
+				//rays that start inside a collider hit it straight away
+				bool is_inside = c <= 0.0f;
+
+				float distance = is_inside ? 0.0f : -half_b - std::sqrt(std::max(discriminant, 0.0f));
+
+				bool is_hit = (is_inside || ((half_b < 0.0f) && (discriminant >= 0.0f))) && (distance < closest_hit.distance) && (handle.get_index() != ignore_handle.get_index());
+
+				if (is_hit)
+				{
+					closest_hit.handle = handle;
+					closest_hit.distance = distance;
+				}
+			};
+
+		math_2d_util::ivec2d previous_tile_xy;
+		bool has_previous_tile = false;
+
+		while (true)
+		{
+			math_2d_util::ivec2d tile_xy(tile_x, tile_y);
+
+			int32 search_min_x = std::max(tile_x - search_reach, 0);
+			int32 search_min_y = std::max(tile_y - search_reach, 0);
+			int32 search_max_x = std::min(tile_x + search_reach, max_tile);
+			int32 search_max_y = std::min(tile_y + search_reach, max_tile);
+
+			for (int32 source_y = search_min_y; source_y <= search_max_y; ++source_y)
+			{
+				for (int32 source_x = search_min_x; source_x <= search_max_x; ++source_x)
+				{
+					math_2d_util::ivec2d source_xy(source_x, source_y);
+
+					auto source_tile = grid_helper.from_xy(source_xy);
+
+					if (!overlap_grid.has_bounds(source_tile))
+					{
+						continue;
+					}
+
+					math_2d_util::irect reach = overlap_grid.get_world_bounds(source_xy, source_tile);
+
+					auto reaches_tile = [&](const math_2d_util::ivec2d& target)
+						{
+							return (target.x >= reach.min.x - radius_tiles) && (target.x <= reach.max.x + radius_tiles) &&
+								(target.y >= reach.min.y - radius_tiles) && (target.y <= reach.max.y + radius_tiles);
+						};
+
+					//a ray only passes through a rect of tiles once so anything that reached the previous tile was already tested
+					if (!reaches_tile(tile_xy) || (has_previous_tile && reaches_tile(previous_tile_xy)))
+					{
+						continue;
+					}
+
+					std::for_each(colliders_in_tile_tracker.get_root_node_start(source_tile.index), colliders_in_tile_tracker.end(), test_collider);
+				}
+			}
+
+			float tile_exit_distance = std::min(next_crossing_x, next_crossing_y);
+
+			//every collider the ray can hit inside this tile has been tested so a hit before the exit cant be beaten by a later tile
+			if ((closest_hit.distance <= tile_exit_distance) || (tile_exit_distance >= end_distance))
+			{
+				break;
+			}
+
+			previous_tile_xy = tile_xy;
+			has_previous_tile = true;
+
+			if (next_crossing_x < next_crossing_y)
+			{
+				tile_x += step_x;
+				next_crossing_x += tile_distance_x;
+			}
+			else
+			{
+				tile_y += step_y;
+				next_crossing_y += tile_distance_y;
+			}
+
+			if ((tile_x < 0) || (tile_x > max_tile) || (tile_y < 0) || (tile_y > max_tile))
+			{
+				break;
+			}
+		}
+
+		return closest_hit;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::raycast_hit 
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::raycast(math_2d_util::fvec2d origin, math_2d_util::fvec2d direction, float max_distance, handle_type ignore_handle)
+	{
+		float length = std::sqrt((direction.x * direction.x) + (direction.y * direction.y));
+
+		assert(length > 0.0f);
+
+		return cast_ray(origin, math_2d_util::fvec2d(direction.x / length, direction.y / length), max_distance, 0.0f, ignore_handle);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::raycast_hit 
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::segment_cast(const segment_query& segment)
+	{
+		float move_x = segment.end.x - segment.start.x;
+		float move_y = segment.end.y - segment.start.y;
+
+		float length = std::sqrt((move_x * move_x) + (move_y * move_y));
+
+		if (length == 0.0f)
+		{
+			return raycast_hit{ handle_type::get_invalid_index(), 0.0f };
+		}
+
+		return cast_ray(segment.start, math_2d_util::fvec2d(move_x / length, move_y / length), length, segment.radius, segment.ignore_handle);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::segment_casts(std::span<const segment_query> segments, std::span<raycast_hit> out_hits)
+	{
+		assert(out_hits.size() >= segments.size());
+
+		run_query_batch(static_cast<uint32_t>(segments.size()),
+			[&](uint32_t query_index)
+			{
+				return segments[query_index].start;
+			},
+			[&](uint32_t query_index)
+			{
+				out_hits[query_index] = segment_cast(segments[query_index]);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_k_nearest(math_2d_util::fvec2d point, uint32_t k, std::span<handle_type> out_handles, handle_type ignore_handle)
+	{
+		assert(k <= max_k_nearest);
+		assert(out_handles.size() >= k);
+
+		constexpr int32 max_tile = grid_dimension_type::tile_w - 1;
+
+		struct neighbour
+		{
+			float distance_sqr;
+			handle_type handle;
+
+			bool operator<(const neighbour& other) const
+			{
+				return distance_sqr < other.distance_sqr;
+			}
+		};
+
+		//max heap of the best found so far, the front is the furthest of the current best
+		std::array<neighbour, max_k_nearest> best_neighbours;
+		uint32_t best_count = 0;
+
+		if (k == 0)
+		{
+			return 0;
+		}
+
+		math_2d_util::ivec2d center_tile(static_cast<int32>(std::floor(point.x)), static_cast<int32>(std::floor(point.y)));
+
+		auto test_collider = [&](auto handle)
+			{
+				auto ref_struct = collision_data_container.get(handle);
+
+				float offset_x = Tnumeric_policy::to_float(ref_struct.x) - point.x;
+				float offset_y = Tnumeric_policy::to_float(ref_struct.y) - point.y;
+
+				float distance_sqr = (offset_x * offset_x) + (offset_y * offset_y);
+
+				if (handle.get_index() == ignore_handle.get_index())
+				{
+					return;
+				}
+
+				if (best_count < k)
+				{
+					best_neighbours[best_count++] = neighbour{ distance_sqr, handle };
+
+					std::push_heap(best_neighbours.begin(), best_neighbours.begin() + best_count);
+				}
+				else if (distance_sqr < best_neighbours[0].distance_sqr)
+				{
+					//drop the furthest and put the new one in its place
+					std::pop_heap(best_neighbours.begin(), best_neighbours.begin() + best_count);
+
+					best_neighbours[best_count - 1] = neighbour{ distance_sqr, handle };
+
+					std::push_heap(best_neighbours.begin(), best_neighbours.begin() + best_count);
+				}
+			};
+
+		for (uint32_t iring = 0; iring <= k_nearest_max_ring; ++iring)
+		{
+			//a collider centred in this ring is at least the whole tiles between the rings away
+			float ring_gap = static_cast<float>(std::max(static_cast<int32>(iring) - 1, 0));
+
+			if ((best_count == k) && ((ring_gap * ring_gap) >= best_neighbours[0].distance_sqr))
+			{
+				break;
+			}
+
+			//stop once the ring is outside the world on every side
+			int32 ring = static_cast<int32>(iring);
+
+			bool is_ring_outside_world = 
+				(center_tile.x - ring < 0) && (center_tile.x + ring > max_tile) &&
+				(center_tile.y - ring < 0) && (center_tile.y + ring > max_tile);
+
+			if (is_ring_outside_world)
+			{
+				break;
+			}
+
+			for (uint32_t ioffset = k_nearest_spiral_type::ring_start[iring]; ioffset < k_nearest_spiral_type::ring_start[iring + 1]; ++ioffset)
+			{
+				const math_2d_util::ivec2d& offset = k_nearest_spiral_type::offsets[ioffset];
+
+				math_2d_util::ivec2d tile_xy(center_tile.x + offset.x, center_tile.y + offset.y);
+
+				bool is_in_world = (tile_xy.x >= 0) && (tile_xy.x <= max_tile) && (tile_xy.y >= 0) && (tile_xy.y <= max_tile);
+
+				if (!is_in_world)
+				{
+					continue;
+				}
+
+				auto tile = grid_helper.from_xy(tile_xy);
+
+				std::for_each(colliders_in_tile_tracker.get_root_node_start(tile.index), colliders_in_tile_tracker.end(), test_collider);
+			}
+		}
+
+		//sort_heap leaves them nearest first
+		std::sort_heap(best_neighbours.begin(), best_neighbours.begin() + best_count);
+
+		std::transform(best_neighbours.begin(), best_neighbours.begin() + best_count, out_handles.begin(), [](const neighbour& found)
+			{
+				return found.handle;
+			});
+
+		return best_count;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::query_k_nearest_batch(std::span<const k_nearest_query> queries, uint32_t k, std::span<handle_type> out_handles, std::span<uint32_t> out_result_counts)
+	{
+		assert(out_handles.size() >= queries.size() * k);
+		assert(out_result_counts.size() >= queries.size());
+
+		run_query_batch(static_cast<uint32_t>(queries.size()),
+			[&](uint32_t query_index)
+			{
+				return queries[query_index].point;
+			},
+			[&](uint32_t query_index)
+			{
+				out_result_counts[query_index] = query_k_nearest(queries[query_index].point, k, out_handles.subspan(query_index * k, k), queries[query_index].ignore_handle);
+			});
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline math_2d_util::fvec2d phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_position(handle_type handle)
+	{
+		auto ref_struct = collision_data_container.get(handle);
+
+		return to_float_vector(ref_struct.x, ref_struct.y);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tself, typename Tblock_func>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::for_each_snapshot_block(Tself& self, Tblock_func&& block_func)
+	{
+		//settings
+		block_func(self.time_step, snapshot_block_layout::WHOLE);
+		block_func(self.solver_iterations, snapshot_block_layout::WHOLE);
+		block_func(self.sleep_step_count, snapshot_block_layout::WHOLE);
+		block_func(self.max_sub_steps, snapshot_block_layout::WHOLE);
+		block_func(self.sub_step_max_move, snapshot_block_layout::WHOLE);
+
+		//handles and the paged collider data, the page tables and handle lookup live inside the container
+		block_func(self.handle_manager, snapshot_block_layout::WHOLE);
+		block_func(self.is_handle_index_live, snapshot_block_layout::WHOLE);
+		block_func(self.collision_data_container, snapshot_block_layout::WHOLE);
+
+		//everything queued for the next update
+		block_func(self.colliders_to_add, snapshot_block_layout::WHOLE);
+		block_func(self.sectors_with_queued_items, snapshot_block_layout::WHOLE);
+		block_func(self.queued_removals, snapshot_block_layout::WHOLE);
+		block_func(self.is_queued_for_removal, snapshot_block_layout::WHOLE);
+		block_func(self.queued_motion_commands, snapshot_block_layout::WHOLE);
+		block_func(self.queued_long_range_transfers, snapshot_block_layout::WHOLE);
+		block_func(self.is_queued_for_long_range_transfer, snapshot_block_layout::WHOLE);
+
+		//active sector tracking
+		block_func(self.active_sector_bitmap, snapshot_block_layout::WHOLE);
+		block_func(self.number_of_active_sectors, snapshot_block_layout::WHOLE);
+		block_func(self.active_sectors, snapshot_block_layout::WHOLE);
+		block_func(self.active_sectors_by_colour, snapshot_block_layout::WHOLE);
+		block_func(self.number_of_active_and_neighbouring_sectors, snapshot_block_layout::WHOLE);
+		block_func(self.active_and_neighbouring_sectors, snapshot_block_layout::WHOLE);
+
+		//tile tracking
+		block_func(self.overlap_grid.overlaps, snapshot_block_layout::PER_SECTOR);
+		block_func(self.overlap_grid.bounds, snapshot_block_layout::PER_SECTOR);
+		block_func(self.overlap_grid.overlap_pairs, snapshot_block_layout::PER_SECTOR_OVERLAP_LIST);
+		block_func(self.colliders_in_tile_tracker, snapshot_block_layout::WHOLE);
+
+		//the pairs from the last step are read by the time of impact pass at the start of the next one
+		block_func(self.collider_pairs_per_sector, snapshot_block_layout::PER_SECTOR);
+		block_func(self.collider_pairs_found_per_sector, snapshot_block_layout::WHOLE);
+		block_func(self.time_of_impact_per_collider, snapshot_block_layout::WHOLE);
+
+		//sleep tracking
+		block_func(self.steps_at_rest_per_collider, snapshot_block_layout::WHOLE);
+		block_func(self.sleeping_colliders_per_sector, snapshot_block_layout::WHOLE);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::snapshot_header
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::create_snapshot_header() const
+	{
+		snapshot_header header = {};
+
+		header.magic = snapshot_magic;
+		header.version = snapshot_version;
+		header.max_objects = Imax_objects;
+		header.world_sector_x_count = Iworld_sector_x_count;
+		header.scalar_size = sizeof(scalar_type);
+
+		static_assert(sizeof(scalar_type) <= sizeof(header.scalar_one_bits));
+
+		scalar_type one = Tnumeric_policy::from_float(1.0f);
+
+		std::memcpy(&header.scalar_one_bits, &one, sizeof(scalar_type));
+
+		//total size of all the blocks, catches most changes to the container layouts
+		for_each_snapshot_block(*this, [&](const auto& block, snapshot_block_layout)
+			{
+				header.state_size += sizeof(block);
+			});
+
+		return header;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	template<typename Tblock, typename Trange_func>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::for_each_plain_byte_range(const Tblock& block, Trange_func&& range_func)
+	{
+		//offsets of the locks from the start of the block, there is one per page pool so a handful at most
+		std::vector<size_t> lock_offsets;
+
+		if constexpr (requires { block.for_each_lock([](MiscUtilities::spin_lock&) {}); })
+		{
+			block.for_each_lock([&](const MiscUtilities::spin_lock& lock)
+				{
+					lock_offsets.push_back(static_cast<size_t>(reinterpret_cast<const char*>(&lock) - reinterpret_cast<const char*>(&block)));
+				});
+
+			std::sort(lock_offsets.begin(), lock_offsets.end());
+		}
+
+		size_t range_start = 0;
+
+		for (size_t lock_offset : lock_offsets)
+		{
+			range_func(range_start, lock_offset - range_start);
+
+			range_start = lock_offset + sizeof(MiscUtilities::spin_lock);
+		}
+
+		range_func(range_start, sizeof(Tblock) - range_start);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::save_snapshot(const std::filesystem::path& path) const
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		snapshot_header header = create_snapshot_header();
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		//every container is fixed size and addresses things by index not pointer so the raw bytes are the whole state
+		//apart from the locks, their bytes are written as zeros so the file layout stays one to one with the blocks
+		const std::array<char, 64> zeros = {};
+
+		for_each_snapshot_block(*this, [&](const auto& block, snapshot_block_layout)
+			{
+				size_t written = 0;
+
+				for_each_plain_byte_range(block, [&](size_t offset, size_t size)
+					{
+						for (; written < offset; written += std::min(zeros.size(), offset - written))
+						{
+							file.write(zeros.data(), std::min(zeros.size(), offset - written));
+						}
+
+						file.write(reinterpret_cast<const char*>(&block) + offset, size);
+
+						written = offset + size;
+					});
+			});
+
+		return static_cast<bool>(file.flush());
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline bool phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::load_snapshot(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		snapshot_header expected_header = create_snapshot_header();
+
+		//check the size before reading anything so a short file cant leave the state half loaded
+		if (static_cast<uint64_t>(file.tellg()) != sizeof(snapshot_header) + expected_header.state_size)
+		{
+			return false;
+		}
+
+		file.seekg(0);
+
+		//read everything before touching the live containers so a failed read cant leave the state half loaded
+		std::vector<char> staging(sizeof(snapshot_header) + expected_header.state_size);
+
+		file.read(staging.data(), staging.size());
+
+		if (!file || std::memcmp(staging.data(), &expected_header, sizeof(snapshot_header)) != 0)
+		{
+			return false;
+		}
+
+		size_t block_start = sizeof(snapshot_header);
+
+		for_each_snapshot_block(*this, [&](auto& block, snapshot_block_layout)
+			{
+				for_each_plain_byte_range(block, [&](size_t offset, size_t size)
+					{
+						std::memcpy(reinterpret_cast<char*>(&block) + offset, staging.data() + block_start + offset, size);
+					});
+
+				//the locks were skipped by the copy, make sure none is left held
+				if constexpr (requires { block.for_each_lock([](MiscUtilities::spin_lock&) {}); })
+				{
+					block.for_each_lock([](MiscUtilities::spin_lock& lock)
+						{
+							lock.unlock();
+						});
+				}
+
+				block_start += sizeof(block);
+			});
+
+		//the swept bounds caches are not saved so work every tile out again on the next step
+		mark_all_tile_bounds_dirty();
+
+		return true;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline const phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::collider_pair_buffer_type& 
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_collider_pairs_in_sector(sector_count_type sector_index) const
+	{
+		return collider_pairs_per_sector[sector_index];
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_collider_pair_count_in_sector(sector_count_type sector_index) const
+	{
+		return collider_pairs_found_per_sector[sector_index];
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::set_worker_count(uint32_t worker_count)
+	{
+		//0 = use all hardware threads
+		if (worker_count == 0)
+		{
+			worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		//there is only enough scratch space for max_worker_count workers
+		job_scheduler.set_worker_count(std::min(worker_count, max_worker_count));
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_worker_count() const
+	{
+		return job_scheduler.get_worker_count();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline const phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_phase_times&
+		phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_last_update_phase_times() const
+	{
+		return last_update_phase_times;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline const physics_stats& phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_last_step_stats() const
+	{
+		return last_step_stats;
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::add_bounds_update_to_stats(uint32_t worker_index, const typename overlap_tracking_grid_type::bounds_update_counts& counts)
+	{
+		if constexpr (is_physics_stats_enabled)
+		{
+			physics_stats& stats = per_worker_scratch_buffers[worker_index].step_stats;
+
+			stats.overlap_flag_writes += counts.flag_writes;
+			stats.overlap_pairs_added += counts.pairs_added;
+			stats.overlap_pairs_removed += counts.pairs_removed;
+		}
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint32_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_sector_transfer_direction(const math_2d_util::ivec2d& from_tile, const math_2d_util::ivec2d& to_tile)
+	{
+		using MiscUtilities::grid_directions;
+
+		//indexed by the sector step in x and y plus one
+		static constexpr std::array<grid_directions, 9> direction_for_step = {
+			grid_directions::UP_LEFT, grid_directions::UP, grid_directions::UP_RIGHT,
+			grid_directions::LEFT, grid_directions::COUNT, grid_directions::RIGHT,
+			grid_directions::DOWN_LEFT, grid_directions::DOWN, grid_directions::DOWN_RIGHT };
+
+		math_2d_util::ivec2d step = (to_tile >> sector_grid_helper_type::sub_tile_bits_per_axis) - (from_tile >> sector_grid_helper_type::sub_tile_bits_per_axis);
+
+		//only moves to a direct neighbour go through the transfer buffers
+		assert(std::abs(step.x) <= 1 && std::abs(step.y) <= 1 && (step.x | step.y) != 0);
+
+		return static_cast<uint32_t>(direction_for_step[((step.y + 1) * 3) + (step.x + 1)]);
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint64_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_page_allocation_count() const
+	{
+		return collision_data_container.get_tight_packed_data().get_array_header().paged_memory_tracker.get_allocation_count() + colliders_in_tile_tracker.get_page_header().get_allocation_count();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline uint64_t phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::get_page_free_count() const
+	{
+		return collision_data_container.get_tight_packed_data().get_array_header().paged_memory_tracker.get_free_count() + colliders_in_tile_tracker.get_page_header().get_free_count();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::gather_step_stats(uint64_t page_allocations_at_start, uint64_t page_frees_at_start)
+	{
+		physics_stats stats = {};
+
+		//add up what each worker counted and clear it for the next step
+		for (sector_update_scratch_buffers& scratch : per_worker_scratch_buffers)
+		{
+			physics_stats& worker_stats = scratch.step_stats;
+
+			stats.tile_changes += worker_stats.tile_changes;
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::add_items_from_sector(sector_count_type sector_index)
-	{
-		//get index iterator from the item add header 
-		std::for_each(collider_to_add_header.begin(sector_index), collider_to_add_header.end(sector_index), [&](auto real_address_to_add)
+			stats.integration_passes = std::max(stats.integration_passes, worker_stats.integration_passes);
+			stats.sub_stepped_sector_updates += worker_stats.sub_stepped_sector_updates;
+			stats.long_range_transfers += worker_stats.long_range_transfers;
+			stats.transfer_spills += worker_stats.transfer_spills;
+
+			for (uint32_t direction = 0; direction < physics_stats::direction_count; ++direction)
 			{
-				//get a ref struct to the existing data
-				const new_collider_data& existing_data = colliders_to_add_data[real_address_to_add.address];
+				stats.sector_transfers_per_direction[direction] += worker_stats.sector_transfers_per_direction[direction];
+			}
 
-				add_collider_data_to_sector_data(existing_data, sector_index);
+			stats.oversized_pair_tiles += worker_stats.oversized_pair_tiles;
 
-			});
+			stats.tile_bounds_walks += worker_stats.tile_bounds_walks;
+			stats.tile_bounds_updates += worker_stats.tile_bounds_updates;
+			stats.overlap_flag_writes += worker_stats.overlap_flag_writes;
+			stats.overlap_pairs_added += worker_stats.overlap_pairs_added;
+			stats.overlap_pairs_removed += worker_stats.overlap_pairs_removed;
 
-		//inject the handle into the per tile trakcer
-		std::for_each(collider_to_add_header.begin(sector_index), collider_to_add_header.end(sector_index), [&](auto real_address_to_add)
-			{
-				//get a ref struct to the existing data
-				const new_collider_data& existing_data = colliders_to_add_data[real_address_to_add.address];
+			worker_stats = {};
+		}
 
-				add_collider_handle_to_tile_tracker(existing_data);
-			});
+		stats.overlap_pair_list_growth = static_cast<int32>(stats.overlap_pairs_added) - static_cast<int32>(stats.overlap_pairs_removed);
 
-		//clear all queued items for sector
-		collider_to_add_header.clear_axis(sector_index);
-	}
+		stats.pages_allocated = static_cast<uint32>(get_page_allocation_count() - page_allocations_at_start);
+		stats.pages_freed = static_cast<uint32>(get_page_free_count() - page_frees_at_start);
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::add_collider_data_to_sector_data(const new_collider_data& data_for_new_collider, sector_count_type sector_index)
-	{
-		//make sure the data getting added is valid 
-		assert(data_for_new_collider.radius > 0);
+		//collider counts of the sectors that have any
+		const auto& colliders_per_sector = collision_data_container.get_tight_packed_data().get_array_header().y_axis_count;
 
-		//add to the target sector 
-		auto [destination__real_address, _, __] = collision_data_container.insert(data_for_new_collider.owner, sector_index);
+		uint32_t total_colliders = 0;
 
-		//get the ref struct to the data we are writing to
-		auto data_ref = collision_data_container.get(destination__real_address);
+		for (uint32_t i = 0; i < number_of_active_sectors; ++i)
+		{
+			uint32_t collider_count = colliders_per_sector[active_sectors[i]];
 
-		//copy across the values (could maybe make a meta function for this)
-		data_ref.x = data_for_new_collider.position.x;
-		data_ref.y = data_for_new_collider.position.y;
+			stats.max_colliders_in_sector = std::max(stats.max_colliders_in_sector, collider_count);
 
-		data_ref.velocity_x = data_for_new_collider.velocity.x;
-		data_ref.velocity_y = data_for_new_collider.velocity.y;
+			total_colliders += collider_count;
+		}
 
-		data_ref.radius = data_for_new_collider.radius;
+		stats.active_sector_count = number_of_active_sectors;
+		stats.mean_colliders_per_active_sector = number_of_active_sectors ? static_cast<float>(total_colliders) / static_cast<float>(number_of_active_sectors) : 0.0f;
+
+		last_step_stats = stats;
 	}
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::add_collider_handle_to_tile_tracker(const new_collider_data& data_for_new_collider)
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::end_update_phase(update_phase phase)
 	{
-		//get the handle 
-		auto handle = data_for_new_collider.owner;
+		std::chrono::steady_clock::time_point phase_end_time = std::chrono::steady_clock::now();
 
-		//convert to tile
-		math_2d_util::ivec2d tile_xy = static_cast<math_2d_util::ivec2d>(data_for_new_collider.position);
-
-		//use grid helper to get sector
-		auto sector_index = grid_helper.from_xy(tile_xy);
+		last_update_phase_times[static_cast<uint32_t>(phase)] = phase_end_time - phase_start_time;
 
-		//inject the handle into the grid structure 
-		colliders_in_tile_tracker.add(sector_index.index, handle);
+		phase_start_time = phase_end_time;
 	}
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::add_items_from_all_sectors()
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_all_positions()
 	{
-		//single threaded version.
-		//loop through all sectors and add their items into the simulation
-		std::for_each(sectors_with_queued_items.begin(), sectors_with_queued_items.end(), [&](auto sector_index)
+		PROFILE_ZONE("update_all_positions");
+
+		//update the positions and copy any items changing sectors to the sector edge buffer
+		//each sector only writes to its own data and its own transfer buffers so they can all run at once
+		run_on_active_sectors([&](sector_count_type sector_index, uint32_t worker_index)
 			{
-				add_items_from_sector(sector_index);
+				update_positions_in_sector(sector_index, worker_index, 0);
 			});
 
-		sectors_with_queued_items.clear();
-	}
+		end_update_phase(update_phase::INTEGRATE);
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::update_bounds_in_sector(sector_count_type sector_index)
-	{
-		//get the iterators for the sector
-		auto begin_itr = colliders_in_tile_tracker.get_active_nodes_in_group_start(sector_index);
-		auto end_itr = colliders_in_tile_tracker.get_active_nodes_in_group_end(sector_index);
+		//empty sectors next to active ones can have items moved into them so they get visited as well
+		transfer_items_into_sectors(std::span<const sector_count_type>(active_and_neighbouring_sectors.data(), number_of_active_and_neighbouring_sectors));
 
-		//sector offset 
-		auto tile_offset = sector_index * grid_dimension_type::sector_tile_count;
+		//items can only have moved between an active sector and its neighbours so only those need their state rechecked
+		std::for_each(active_and_neighbouring_sectors.begin(), active_and_neighbouring_sectors.begin() + number_of_active_and_neighbouring_sectors, [&](sector_count_type sector_index)
+			{
+				update_sector_active_state(sector_index);
+			});
 
-		//loop through all active nodes in the sector
-		std::for_each(begin_itr, end_itr, [&](auto root_index)
+		//the sub step passes can also move things into sectors that were not active
+		//they update the active state of every sector they touch so the lists only need rebuilding once at the end
+		if (max_sub_steps > 1)
+		{
+			update_sub_step_positions();
+		}
+
+		refresh_active_sector_lists();
+	}
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::transfer_items_into_sectors(std::span<const sector_count_type> sectors)
+	{
+		//move items out of the sector edge buffer
+		//the neighbouring transfer buffers are only read in this pass and each sector only writes to its own data
+		//so this does not need to be coloured either
+		run_on_sectors(sectors, [&](sector_count_type sector_index, uint32_t worker_index)
 			{
-				//convert from subtile to global tile 
-				auto world_tile = root_index + tile_offset;
+				uint32 sector_x = sector_index % grid_dimension_type::sectors_grid_w;
+				uint32 sector_y = sector_index / grid_dimension_type::sectors_grid_w;
 
-				//get the iterator for the tile
-				auto tile_start = colliders_in_tile_tracker.get_root_node_start(world_tile);
-				auto tile_end = colliders_in_tile_tracker.end();
+				MiscUtilities::grid_function_helper::template_edge_corner_and_fill_function_for_tile(grid_dimension_type::sectors_grid_w, grid_dimension_type::sectors_grid_w, sector_x, sector_y, [&]<typename edge_info>(uint32 x, uint32 y)
+				{
+					transfer_items_between_sectors<edge_info>((grid_dimension_type::sectors_grid_w * y) + x);
+				});
+			});
+	
+		//clear the sector edge buffers
+		//sectors that were empty but had items moved in have filled their removal address list too so clear the neighbours as well
+		run_on_sectors(sectors, [&](sector_count_type sector_index, uint32_t worker_index)
+			{
+				sector_transfer_buffer_groups[sector_index].clear();
+				sector_transfer_removal_address_groups[sector_index].clear();
+			});
 
-				//the rect for the tile
-				math_2d_util::irect new_bounds = math_2d_util::irect::inverse_max_size_rect();
+		//move the colliders that did not fit in the transfer buffers, they only ever go to a neighbour so stay inside the sectors passed in
+		apply_pending_sector_moves();
+	}
 
-				using sector_type_type = typename sector_grid_helper_type::sector_tile_index_type;
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_sub_step_positions()
+	{
+		PROFILE_ZONE("update_sub_step_positions");
 
-				//check for overflow
-				assert(world_tile < std::numeric_limits<sector_type_type::combined_index>::max());
+		//the first pass moved every active sector
+		std::span<const sector_count_type> last_moved_sectors(active_sectors.data(), number_of_active_sectors);
 
-				//convert to a tile type
-				sector_type_type tile = sector_type_type{ static_cast<sector_type_type::combined_index>( world_tile )};
+		for (uint32_t sub_step_index = 1; sub_step_index < max_sub_steps; ++sub_step_index)
+		{
+			//sectors that still have a collider with a sub step left, the collider may have been transfered to a neighbour
+			//at the end of the last pass so the neighbours get moved too
+			sector_bitmap_type sectors_to_move = {};
 
-				//get the tils coordinate
-				math_2d_util::ivec2d tile_coordinate = grid_helper.to_xy<math_2d_util::ivec2d>(tile);
+			bool has_sub_steps_left = false;
 
-				//calculate the bounds for each agent
-				std::for_each(tile_start, tile_end,
-					[&](auto handle)
+			std::for_each(last_moved_sectors.begin(), last_moved_sectors.end(), [&](sector_count_type sector_index)
+				{
+					if (sub_steps_per_sector[sector_index] > sub_step_index)
 					{
-						//get ref struct 
-						typename collision_data_container_type::handle_reference_wrapper ref_struct = collision_data_container.get(handle);
-
-						//calcualte x min max
-						float x_min = ref_struct.x - ref_struct.radius;
-						float x_max = ref_struct.x + ref_struct.radius;
+						set_sector_and_neighbour_bits(sectors_to_move, sector_index);
 
-						//calculate y min max 
-						float y_min = ref_struct.y - ref_struct.radius;
-						float y_max = ref_struct.y + ref_struct.radius;
+						has_sub_steps_left = true;
+					}
+				});
 
-						new_bounds.min.x = std::min(new_bounds.min.x, static_cast<int32>(x_min));
-						new_bounds.max.x = std::max(new_bounds.max.x, static_cast<int32>(x_max));
+			if (!has_sub_steps_left)
+			{
+				return;
+			}
 
-						new_bounds.min.y = std::min(new_bounds.min.y, static_cast<int32>(y_min));
-						new_bounds.max.y = std::max(new_bounds.max.y, static_cast<int32>(y_max));
+			number_of_sub_step_sectors = static_cast<sector_count_type>(sector_bitmap_to_list(sectors_to_move, sub_step_sectors.data()));
 
-					});
+			//anything moved can end up one sector over
+			sector_bitmap_type sectors_to_transfer_into = {};
 
-				//update the bounds of the tile
-				overlap_grid.update_bounds(tile_coordinate, tile, new_bounds);
+			for (uint32_t i = 0; i < number_of_sub_step_sectors; ++i)
+			{
+				set_sector_and_neighbour_bits(sectors_to_transfer_into, sub_step_sectors[i]);
+			}
 
-			});
-	}
+			number_of_sub_step_transfer_sectors = static_cast<sector_count_type>(sector_bitmap_to_list(sectors_to_transfer_into, sub_step_transfer_sectors.data()));
 
+			last_moved_sectors = std::span<const sector_count_type>(sub_step_sectors.data(), number_of_sub_step_sectors);
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::update_bounds_in_all_sectors()
-	{
-		//single threaded version.
-		//loop through all sectors and add their items into the simulation
-		std::for_each(sectors_with_queued_items.begin(), sectors_with_queued_items.end(), [&](auto sector_index)
-			{
-				update_bounds_in_sector(sector_index);
-			});
-	}
+			run_on_sectors(last_moved_sectors, [&](sector_count_type sector_index, uint32_t worker_index)
+				{
+					update_positions_in_sector(sector_index, worker_index, sub_step_index);
+				});
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::update_all_positions()
-	{
-		//update the positions and copy any items changing sectors to the sector edge buffer
-		for (uint32_t is = 0; is < grid_dimension_type::sector_grid_count; ++is)
-		{
-			update_positions_in_sector(is);
-		}
+			transfer_items_into_sectors(std::span<const sector_count_type>(sub_step_transfer_sectors.data(), number_of_sub_step_transfer_sectors));
 
-		//move items out of the sector edge buffer
-		MiscUtilities::grid_function_helper::template_edge_corner_and_fill_function(grid_dimension_type::sectors_grid_w, grid_dimension_type::sectors_grid_w, 0, 0, [&]<typename edge_info>(uint32 x, uint32 y)
-		{
-			transfer_items_between_sectors<edge_info>((grid_dimension_type::sectors_grid_w * y) + x);
-		});
-	
-		//clear the sector edge buffers 
-		for (uint32_t is = 0; is < grid_dimension_type::sector_grid_count; ++is)
-		{
-			sector_transfer_buffer_groups[is].clear();
-			sector_transfer_removal_address_groups[is].clear();
+			std::for_each(sub_step_transfer_sectors.begin(), sub_step_transfer_sectors.begin() + number_of_sub_step_transfer_sectors, [&](sector_count_type sector_index)
+				{
+					update_sector_active_state(sector_index);
+				});
 		}
-	
 	}
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
 	template<typename Tedge_info>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::transfer_items_between_sectors(sector_count_type sector_index)
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::transfer_items_between_sectors(sector_count_type sector_index)
 	{
+		PROFILE_ZONE("transfer_items_between_sectors");
+
 
 		//before we start do a sanity check that all the object in this sector are valid
 		{
@@ -664,13 +3864,15 @@ namespace ContinuousCollisionLibrary
 				{
 					auto refStruct = collision_data_container.get(real_address);
 
-					assert(refStruct.radius > 0);
+					assert(refStruct.radius > scalar_type(0.0f));
 				});
 		}
 
 
 		using grid_utility = MiscUtilities::grid_navigation_helper<grid_dimension_type::sectors_grid_w>;
 
+		using paged_array_type = typename collision_data_container_type::paged_array_type;
+
 		//define sector bounds 
 		math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
 
@@ -693,7 +3895,7 @@ namespace ContinuousCollisionLibrary
 				for (uint32_t ix = 0; ix < transfer_buffer_in_dir.size(); ++ix)
 				{
 					//sanity check that the object is valid
-					assert(transfer_buffer_in_dir[ix].radius > 0);
+					assert(transfer_buffer_in_dir[ix].radius > scalar_type(0.0f));
 
 					//check if the object is in this sector
 					bool is_in_sector = math_2d_util::rect_2d_math::is_overlapping(sector_bounds, math_2d_util::uivec2d(transfer_buffer_in_dir[ix].position));
@@ -715,7 +3917,7 @@ namespace ContinuousCollisionLibrary
 				for (uint32_t ix = 0; ix < transfer_buffer_in_dir.size(); ++ix)
 				{
 					//sanity check that the object is valid
-					assert(transfer_buffer_in_dir[ix].radius > 0);
+					assert(transfer_buffer_in_dir[ix].radius > scalar_type(0.0f));
 
 					//check if the object is in this sector
 					bool is_in_sector = math_2d_util::rect_2d_math::is_overlapping(sector_bounds, math_2d_util::uivec2d(transfer_buffer_in_dir[ix].position));
@@ -738,7 +3940,7 @@ namespace ContinuousCollisionLibrary
 				for (uint32_t ix = 0; ix < transfer_buffer_in_dir.size(); ++ix)
 				{
 					//sanity check that the object is valid
-					assert(transfer_buffer_in_dir[ix].radius > 0);
+					assert(transfer_buffer_in_dir[ix].radius > scalar_type(0.0f));
 
 					//check if the object is in this sector
 					bool is_in_sector = math_2d_util::rect_2d_math::is_overlapping(sector_bounds, math_2d_util::uivec2d(transfer_buffer_in_dir[ix].position));
@@ -760,7 +3962,7 @@ namespace ContinuousCollisionLibrary
 				for (uint32_t ix = 0; ix < transfer_buffer_in_dir.size(); ++ix)
 				{
 					//sanity check that the object is valid
-					assert(transfer_buffer_in_dir[ix].radius > 0);
+					assert(transfer_buffer_in_dir[ix].radius > scalar_type(0.0f));
 
 					//check if the object is in this sector
 					bool is_in_sector = math_2d_util::rect_2d_math::is_overlapping(sector_bounds, math_2d_util::uivec2d(transfer_buffer_in_dir[ix].position));
@@ -821,7 +4023,8 @@ namespace ContinuousCollisionLibrary
 		auto [begin_itr, end_itr] = collision_data_container.reserve_space_for_move(sector_index, space_to_reserver);
 
 		//get the end virtual address in the sector (one more than the last occupied address)
-		typename collision_data_container_type::virtual_combined_node_adderss_type new_virtual_addresses(new_virtual_address_start + (sector_index * collision_data_container_type::paged_array_type::max_y_items));
+		//each sector is max_y_axis_pages pages apart in the combined address space which is not the same as max_y_items
+		typename collision_data_container_type::virtual_combined_node_adderss_type new_virtual_addresses = paged_array_type::convert_from_y_axis_to_combined_virtual_address(sector_index, typename collision_data_container_type::virtual_y_axis_node_adderss_type(new_virtual_address_start));
 
 		//loop through the extra space and extract the real addresses to copy data to
 		std::for_each(begin_itr, end_itr, [&](auto real_address)
@@ -881,6 +4084,9 @@ namespace ContinuousCollisionLibrary
 				ref_struct.velocity_x = buffer_item_ref.velocity.x;
 				ref_struct.velocity_y = buffer_item_ref.velocity.y;
 
+				ref_struct.impulse_x = scalar_type(0.0f);
+				ref_struct.impulse_y = scalar_type(0.0f);
+
 				ref_struct.radius = buffer_item_ref.radius;
 			}
 		}
@@ -919,7 +4125,7 @@ namespace ContinuousCollisionLibrary
 				auto& buffer_item_ref = read_buffer[ibuffer_item];
 
 				//check that the read buffer is a valid object
-				assert(buffer_item_ref.radius > 0);
+				assert(buffer_item_ref.radius > scalar_type(0.0f));
 
 				//get the ref for the write target
 				auto ref_struct = collision_data_container.overwrite(buffer_item_ref.owner, real_address_to_write_to, virtual_address_to_point_handle_to);
@@ -932,6 +4138,9 @@ namespace ContinuousCollisionLibrary
 				ref_struct.velocity_x = buffer_item_ref.velocity.x;
 				ref_struct.velocity_y = buffer_item_ref.velocity.y;
 
+				ref_struct.impulse_x = scalar_type(0.0f);
+				ref_struct.impulse_y = scalar_type(0.0f);
+
 				ref_struct.radius = buffer_item_ref.radius;
 			}
 		}
@@ -950,6 +4159,8 @@ namespace ContinuousCollisionLibrary
 
 			//add the item to the tile tracker
 			colliders_in_tile_tracker.add(new_address.index, ref_struct.handle);
+
+			mark_tile_bounds_dirty(new_address.index);
 		}
 
 		//clean up the reamaining items that are nolonger in the sector
@@ -963,7 +4174,7 @@ namespace ContinuousCollisionLibrary
 		//second repoint all the items that were used to replace items 
 		//as long as a write to virtual address is less than the last virtual address for the sector we know 
 		//it needs to be replaced
-		typename collision_data_container_type::virtual_combined_node_adderss_type last_virtual_addresses(virtual_mem_header.y_axis_count[sector_index] + (sector_index * collision_data_container_type::paged_array_type::max_y_items));
+		typename collision_data_container_type::virtual_combined_node_adderss_type last_virtual_addresses = paged_array_type::convert_from_y_axis_to_combined_virtual_address(sector_index, typename collision_data_container_type::virtual_y_axis_node_adderss_type(virtual_mem_header.y_axis_count[sector_index]));
 
 		for (int iremap_index = write_index; iremap_index < write_to_addresses.size(); ++iremap_index)
 		{
@@ -1001,231 +4212,278 @@ namespace ContinuousCollisionLibrary
 				{
 					auto refStruct = collision_data_container.get(real_address);
 
-					assert(refStruct.radius > 0);
+					assert(refStruct.radius > scalar_type(0.0f));
 				});
 		}
 
 	}
 
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::update_physics()
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_physics()
 	{
+		PROFILE_ZONE("update_physics");
+
+		phase_start_time = std::chrono::steady_clock::now();
+
+		//the page pools only keep running totals so remember where they started
+		uint64_t page_allocations_at_start = 0;
+		uint64_t page_frees_at_start = 0;
+
+		if constexpr (is_physics_stats_enabled)
+		{
+			page_allocations_at_start = get_page_allocation_count();
+			page_frees_at_start = get_page_free_count();
+		}
+
 		//add any new items to the simulation 
 		add_items_from_all_sectors();
+		end_update_phase(update_phase::ADD);
 
-		//move all objects 
-		update_all_positions();
+		//apply the velocity and force changes from game logic
+		apply_all_motion_commands();
+		end_update_phase(update_phase::MOTION_COMMANDS);
 
-		//update the tile boundry overlaps 
-		update_bounds_in_all_sectors();
+		//use the pairs from the last step to stop colliders moving through each other
+		calculate_time_of_impact_in_all_sectors();
+		end_update_phase(update_phase::TIME_OF_IMPACT);
 
+		//remove after the time of impact pass as that still reads the pairs from the last step
+		remove_items_from_all_sectors();
+		end_update_phase(update_phase::REMOVE);
 
-		//object ask the physics system for a handle to a phys object
-		
-		//there is a map from the handle to the address in per sector data 
+		//move the teleported colliders, this has to happen after the removals so nothing removed gets moved
+		apply_all_long_range_transfers();
+		end_update_phase(update_phase::LONG_RANGE_TRANSFER);
 
-		//each object in the world registers movement commands and uses their handle to pass movement forces into the system
+		//move all objects, this ends the integrate phase itself part way through
+		update_all_positions();
+		end_update_phase(update_phase::TRANSFER);
 
-		//update the agent positions inside a sector 
+		//update the tile boundry overlaps 
+		update_bounds_in_all_sectors();
+		end_update_phase(update_phase::BOUNDS);
 
-		//loop through all the active sectors and update the posititons of all the active agents 
+		//find all the touching colliders 
+		generate_pairs_in_all_sectors();
+		end_update_phase(update_phase::PAIRS);
 
-		//for each sector, for each active tile
-		
-		//get the list of all the other active tiles they have potential overlaps with
-		
-		//for each agent in the tile
+		//push apart touching colliders 
+		solve_collisions_in_all_sectors();
+		end_update_phase(update_phase::SOLVE);
 
-		//check if agent overlaps with the bounds of the other overlap
-		
-		//gather all the agent id's inside the tile
-		
-		//use the agent id's to gather the real addresses for each of the potential collider list   
-		
-		//loop through the real addresses and compare flags to see what kind of collisions we are talking about 
-		
-		//for first pass do a discrete sphere check and if collision detected add to list of collisions 
+		//put resting colliders to sleep and wake anything that got pushed
+		update_sleep_state_in_all_sectors();
+		end_update_phase(update_phase::SLEEP);
 
-		//loop through list of collisions and calculate repulsion forces 
+		if constexpr (is_physics_stats_enabled)
+		{
+			gather_step_stats(page_allocations_at_start, page_frees_at_start);
+		}
 
-		//sum up all the repulsion forces 
+		//object ask the physics system for a handle to a phys object
+		
+		//there is a map from the handle to the address in per sector data 
 
-		//apply force to agent 
+		//each object in the world registers movement commands and uses their handle to pass movement forces into the system
 		
 	}
 	
 	//move all objects 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::update_positions_in_sector(sector_count_type sector_index)
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::update_positions_in_sector(sector_count_type sector_index, uint32_t worker_index, uint32_t sub_step_index)
 	{
-		{
-			//get the page data iterators
-			auto page_begin_itr = collision_data_container.get_tight_packed_data().get_array_header().page_begin(sector_index);
-			auto page_end_itr = collision_data_container.get_tight_packed_data().get_array_header().page_end(sector_index);
-
-			//loop through all the pages that a sectors data is in
-			std::for_each(page_begin_itr, page_end_itr, [&](auto& page_address_and_count)
-				{
-					//flip velocity if it will take the agent off the map
-					for (auto real_address = page_address_and_count.page_start_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
-					{
-						//get ref struct 
-						collision_data_ref ref_struct = collision_data_container.get(real_address);
-
-						float new_max_edge = (ref_struct.x + ref_struct.radius) + ref_struct.velocity_x * time_step;
+		PROFILE_ZONE("update_positions_in_sector");
 
-						float new_min_edge = (ref_struct.x - ref_struct.radius) + ref_struct.velocity_x * time_step;
+		//scratch space for this worker
+		auto& items_changing_tile = per_worker_scratch_buffers[worker_index].items_changing_tile;
+		auto& items_exiting_sector = per_worker_scratch_buffers[worker_index].items_exiting_sector;
+		auto& old_tile_x_in_page = per_worker_scratch_buffers[worker_index].old_tile_x_in_page;
+		auto& old_tile_y_in_page = per_worker_scratch_buffers[worker_index].old_tile_y_in_page;
+		auto& changed_tile_in_page = per_worker_scratch_buffers[worker_index].changed_tile_in_page;
+		auto& move_fraction_in_page = per_worker_scratch_buffers[worker_index].move_fraction_in_page;
+		auto& sub_step_fraction_in_page = per_worker_scratch_buffers[worker_index].sub_step_fraction_in_page;
 
-						//check if this will take the object off the bottom of the map
-						bool will_take_off_map = new_max_edge > grid_dimension_type::tile_w || new_min_edge < 0;
+		//sleeping colliders are at the start of the sector and dont move so skip past them
+		uint32_t sleeping_count = sleeping_colliders_per_sector[sector_index];
 
-						//flip the x velocity 
-						ref_struct.velocity_x = will_take_off_map ? -ref_struct.velocity_x : ref_struct.velocity_x;
-					}
+		//edge of the map in the simulation number type
+		const scalar_type world_edge = scalar_type(static_cast<int32>(grid_dimension_type::tile_w));
 
-					for (auto real_address = page_address_and_count.page_start_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
-					{
-						//get ref struct 
-						collision_data_ref ref_struct = collision_data_container.get(real_address);
+		const scalar_type sector_width = scalar_type(static_cast<int32>(grid_dimension_type::sector_w));
 
-						float new_max_edge = (ref_struct.y + ref_struct.radius) + ref_struct.velocity_y * time_step;
+		//sub steps needed per tile of movement
+		const scalar_type sub_steps_per_tile = scalar_type(1.0f) / sub_step_max_move;
 
-						float new_min_edge = (ref_struct.y - ref_struct.radius) + ref_struct.velocity_y * time_step;
+		//the most sub steps any collider in this sector needs, read by the next sub step pass to pick the sectors to visit
+		uint32_t most_sub_steps_in_sector = 1;
 
-						//check if this will take the object off the bottom of the map
-						bool will_take_off_map = new_max_edge > grid_dimension_type::tile_w || new_min_edge < 0;
+		//number of sleeping colliders at the start of a page
+		auto get_sleeping_in_page = [&](uint32_t items_before_page, uint32_t items_in_page)
+			{
+				return std::min(sleeping_count - std::min(sleeping_count, items_before_page), items_in_page);
+			};
 
-						//flip the x velocity 
-						ref_struct.velocity_y = will_take_off_map ? -ref_struct.velocity_y : ref_struct.velocity_y;
-					}
+		if constexpr (is_physics_stats_enabled)
+		{
+			physics_stats& step_stats = per_worker_scratch_buffers[worker_index].step_stats;
 
-					//cant be bothered writing anothre iterator 
-					//apply x movement
-					for (auto real_address = page_address_and_count.page_start_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
-					{
-						//get ref struct 
-						collision_data_ref ref_struct = collision_data_container.get(real_address);
+			step_stats.integration_passes = std::max(step_stats.integration_passes, sub_step_index + 1);
+			step_stats.sub_stepped_sector_updates += sub_step_index > 0;
+		}
 
-						//make sure object is in correct sector to start off with
-						{
-							//get the sector bounds
-							math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
+		{
+			//get the page data iterators
+			auto page_begin_itr = collision_data_container.get_tight_packed_data().get_array_header().page_begin(sector_index);
+			auto page_end_itr = collision_data_container.get_tight_packed_data().get_array_header().page_end(sector_index);
 
-							bool is_in_sector = (sector_bounds.min.x <= ref_struct.x) && (sector_bounds.max.x > ref_struct.x);
+			//define sector bounds 
+			math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
 
-							//check that the object is in the sector
-							if (!is_in_sector)
-							{
-								assert(is_in_sector);
-							}
-						}
+			uint32_t items_before_page = 0;
 
-						auto move_dist = ref_struct.velocity_x * time_step;
+			//loop through all the pages that a sectors data is in
+			std::for_each(page_begin_itr, page_end_itr, [&](auto& page_address_and_count)
+				{
+					auto first_awake_address = page_address_and_count.page_start_address + get_sleeping_in_page(items_before_page, page_address_and_count.items_in_page);
 
-						//check that we are not moving so fast that we jump over an entire sector
-						assert(std::abs(move_dist) < grid_dimension_type::sectors_grid_w);
+					items_before_page += page_address_and_count.items_in_page;
 
-						//apply the x velocity to the x position 
-						ref_struct.x += move_dist;
-					}
+					//offset in the page of the first collider that moves and how many there are after it
+					uint32_t first_awake_offset = first_awake_address.get_sub_page_offset();
+					uint32_t awake_in_page = page_address_and_count.items_in_page - first_awake_offset;
 
-					//apply y movement 
-					for (auto real_address = page_address_and_count.page_start_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
+					//work out how many sub steps each collider is split into
+					//the sub step count only depends on the velocity and time of impact so every pass gets the same answer
+					for (auto real_address = first_awake_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
 					{
 						//get ref struct 
-						collision_data_ref ref_struct = collision_data_container.get(real_address);
-
-						//make sure object is in correct sector to start off with
-						{
-							//get the sector bounds
-							math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
+						auto ref_struct = collision_data_container.get(real_address);
 
-							//check that the object is in the sector
-							assert((sector_bounds.min.y <= ref_struct.y) && (sector_bounds.max.y > ref_struct.y));
-						}
+						auto offset = real_address.get_sub_page_offset();
 
-						auto move_dist = ref_struct.velocity_y * time_step;
+						//make sure object is in correct sector to start off with
+						assert((sector_bounds.min.x <= Tnumeric_policy::to_float(ref_struct.x)) && (sector_bounds.max.x > Tnumeric_policy::to_float(ref_struct.x)));
+						assert((sector_bounds.min.y <= Tnumeric_policy::to_float(ref_struct.y)) && (sector_bounds.max.y > Tnumeric_policy::to_float(ref_struct.y)));
 
-						//check that we are not moving so fast that we jump over an entire sector
-						assert(std::abs(move_dist) < grid_dimension_type::sectors_grid_w);
+						scalar_type time_of_impact = time_of_impact_per_collider[ref_struct.handle.get_index()];
 
-						//apply the x velocity to the x position 
-						ref_struct.y += move_dist;
-					}
+						//the furthest the collider moves along either axis this step
+						scalar_type step_move = std::max<scalar_type>(Tnumeric_policy::abs(ref_struct.velocity_x), Tnumeric_policy::abs(ref_struct.velocity_y)) * time_step * time_of_impact;
 
-				});
-		}
+						uint32_t sub_steps = std::min<uint32_t>(static_cast<uint32_t>(static_cast<int32>(step_move * sub_steps_per_tile)) + 1, max_sub_steps);
 
-		//create page buffer 
-		{
-			//get the page data iterators
-			auto page_begin_itr = collision_data_container.get_tight_packed_data().get_array_header().page_begin(sector_index);
-			auto page_end_itr = collision_data_container.get_tight_packed_data().get_array_header().page_end(sector_index);
+						most_sub_steps_in_sector = std::max(most_sub_steps_in_sector, sub_steps);
 
-			//define sector bounds 
-			math_2d_util::uirect sector_bounds = grid_helper.sector_bounds(sector_index);
+						scalar_type sub_step_fraction = scalar_type(1.0f) / scalar_type(static_cast<int32>(sub_steps));
 
+						scalar_type is_moving = scalar_type(static_cast<int32>(sub_steps > sub_step_index));
 
-			//loop through all the pages that a sectors data is in
-			std::for_each(page_begin_itr, page_end_itr, [&](auto& page_address_and_count)
-				{
+						sub_step_fraction_in_page[offset] = sub_step_fraction;
+						move_fraction_in_page[offset] = time_of_impact * sub_step_fraction * is_moving;
 
+						//check that we are not moving so fast that we jump over an entire sector
+						assert(Tnumeric_policy::abs(ref_struct.velocity_x) * time_step * move_fraction_in_page[offset] < sector_width);
+						assert(Tnumeric_policy::abs(ref_struct.velocity_y) * time_step * move_fraction_in_page[offset] < sector_width);
+					}
 
+					//bounce off the map edges, move and find the colliders that changed tile in one pass over the collider arrays
+					auto first_awake_data = [&](auto field) { return field.subspan(first_awake_address.address, awake_in_page); };
+					auto first_awake_scratch = [&](auto& scratch) { return std::span(scratch).subspan(first_awake_offset, awake_in_page); };
+
+					uint32_t changed_tile_count = collider_integration_kernel::integrate(
+						first_awake_data(get_collision_data_field<collision_data_field::X>()),
+						first_awake_data(get_collision_data_field<collision_data_field::Y>()),
+						first_awake_data(get_collision_data_field<collision_data_field::VELOCITY_X>()),
+						first_awake_data(get_collision_data_field<collision_data_field::VELOCITY_Y>()),
+						first_awake_data(get_collision_data_field<collision_data_field::RADIUS>()),
+						first_awake_scratch(move_fraction_in_page),
+						first_awake_scratch(sub_step_fraction_in_page),
+						time_step,
+						world_edge,
+						first_awake_scratch(old_tile_x_in_page),
+						first_awake_scratch(old_tile_y_in_page),
+						std::span(changed_tile_in_page));
+
+					//the old tiles are only kept for this page so the tile changes are found before moving on to the next one
 					//reset buffers
 					items_changing_tile.clear();
 					items_exiting_sector.clear();
 
-					//shift items in grid tracker 
-					for (auto real_address = page_address_and_count.page_start_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
+					//only the colliders that changed tile need shifting in the grid tracker
+					for (uint32_t changed_index = 0; changed_index < changed_tile_count; ++changed_index)
 					{
-						
+						uint32_t offset = first_awake_offset + changed_tile_in_page[changed_index];
+
+						auto real_address = page_address_and_count.page_start_address + offset;
+
 						//get ref struct
 						auto ref_struct = collision_data_container.get(real_address);
 
 						//sanity check that the object is valid
-						assert(ref_struct.radius > 0);
+						assert(ref_struct.radius > scalar_type(0.0f));
 
 						//old tile
-						math_2d_util::uivec2d old_tile(static_cast<uint32_t>(ref_struct.x - (ref_struct.velocity_x * time_step)), static_cast<uint32_t>(ref_struct.y - (ref_struct.velocity_y * time_step)));
+						math_2d_util::uivec2d old_tile(old_tile_x_in_page[offset], old_tile_y_in_page[offset]);
 
 						//new tile
 						math_2d_util::uivec2d new_tile(static_cast<uint32_t>(ref_struct.x), static_cast<uint32_t>(ref_struct.y));
 
-						bool changed_tile = old_tile != new_tile;
+						assert(old_tile != new_tile);
 
+						//check if this item is being inserted into another tile in this sector
+						bool exiting_sector = !math_2d_util::rect_2d_math::is_overlapping(sector_bounds, new_tile);
 
-						//optionally add this handle to the list of items leaving this sector
-						if (changed_tile)
+						if (exiting_sector)
 						{
-							//check if this item is being inserted into another tile in this sector
-							bool exiting_sector = !math_2d_util::rect_2d_math::is_overlapping(sector_bounds, new_tile);
-
-							if (exiting_sector)
+							//sanity check that we are talking about the something moving out of a sector
 							{
-								//sanity check that we are talking about the something moving out of a sector
-								{
-									bool is_crossing_sector_x = (new_tile.x / grid_dimension_type::sector_w) != (old_tile.x / grid_dimension_type::sector_w);
-									bool is_crossing_sector_y = (new_tile.y / grid_dimension_type::sector_w) != (old_tile.y / grid_dimension_type::sector_w);
+								bool is_crossing_sector_x = (new_tile.x / grid_dimension_type::sector_w) != (old_tile.x / grid_dimension_type::sector_w);
+								bool is_crossing_sector_y = (new_tile.y / grid_dimension_type::sector_w) != (old_tile.y / grid_dimension_type::sector_w);
 
-									assert(is_crossing_sector_x || is_crossing_sector_y);
-								}
+								assert(is_crossing_sector_x || is_crossing_sector_y);
+							}
 
-								typename collision_data_container_type::virtual_combined_node_adderss_type virtual_addres(page_address_and_count.virtual_page_start_address.address + real_address.get_sub_page_offset());
+							typename collision_data_container_type::virtual_combined_node_adderss_type virtual_addres(page_address_and_count.virtual_page_start_address.address + offset);
 
-								items_exiting_sector.push_back(sector_change_tuple_type(real_address, virtual_addres, ref_struct.handle, old_tile, new_tile ));
-							}
-							else
-							{
-								//sanity check that we are talking about the something moving inside a sector
-								assert((new_tile.x / grid_dimension_type::sector_w) == (old_tile.x / grid_dimension_type::sector_w));
-								assert((new_tile.y / grid_dimension_type::sector_w) == (old_tile.y / grid_dimension_type::sector_w));
+							items_exiting_sector.push_back(sector_change_tuple_type(real_address, virtual_addres, ref_struct.handle, old_tile, new_tile ));
+						}
+						else
+						{
+							//sanity check that we are talking about the something moving inside a sector
+							assert((new_tile.x / grid_dimension_type::sector_w) == (old_tile.x / grid_dimension_type::sector_w));
+							assert((new_tile.y / grid_dimension_type::sector_w) == (old_tile.y / grid_dimension_type::sector_w));
 
-								items_changing_tile.push_back(tile_change_tuple_type(ref_struct.handle, old_tile, new_tile ));
-							}
+							items_changing_tile.push_back(tile_change_tuple_type(ref_struct.handle, old_tile, new_tile ));
+						}
+					}
+
+					//colliders whose swept bounds now cover different whole tiles change the bounds of their tile
+					//ones that left the sector are marked by the sector they arrive in
+					for (auto real_address = first_awake_address; real_address < page_address_and_count.page_start_address + page_address_and_count.items_in_page; ++real_address)
+					{
+						auto ref_struct = collision_data_container.get(real_address);
+
+						math_2d_util::irect collider_bounds = calculate_swept_bounds(ref_struct.x, ref_struct.y, ref_struct.velocity_x, ref_struct.velocity_y, ref_struct.radius);
+
+						if (collider_bounds == swept_bounds_per_collider[ref_struct.handle.get_index()])
+						{
+							continue;
+						}
+
+						math_2d_util::uivec2d tile(static_cast<uint32_t>(ref_struct.x), static_cast<uint32_t>(ref_struct.y));
+
+						if (math_2d_util::rect_2d_math::is_overlapping(sector_bounds, tile))
+						{
+							mark_tile_bounds_dirty(grid_helper.from_xy(tile).index);
 						}
 					}
 
+					if constexpr (is_physics_stats_enabled)
+					{
+						per_worker_scratch_buffers[worker_index].step_stats.tile_changes += items_changing_tile.size();
+					}
+
 					//loop through all the tiles that have changed position and move them in the lookup structure
 					std::for_each(items_changing_tile.cbegin(), items_changing_tile.cend(), [&](const tile_change_tuple_type& sector_change_info)
 						{
@@ -1240,6 +4498,9 @@ namespace ContinuousCollisionLibrary
 
 							colliders_in_tile_tracker.add(to_address.index, handle);
 
+							mark_tile_bounds_dirty(from_address.index);
+							mark_tile_bounds_dirty(to_address.index);
+
 							
 						});
 
@@ -1261,23 +4522,41 @@ namespace ContinuousCollisionLibrary
 							//get the buffer to track items leaving the sector
 							auto& address_of_items_leaving = sector_transfer_removal_address_groups[sector_index];
 
-							//remove from old tile, next sector will put it into the new tile
-							colliders_in_tile_tracker.remove(from_address.index, handle);
-
 							//get ref struct
 							collision_data_ref ref_struct = collision_data_container.get(real_address);
 
 							//sanity check that the object is valid
-							assert(ref_struct.radius > 0);
+							assert(ref_struct.radius > scalar_type(0.0f));
 
 							//sanity check that the object is leaving from this sector 
 							bool was_in_this_sector = math_2d_util::rect_2d_math::is_overlapping(sector_bounds, from_coordinate);
 							assert(was_in_this_sector);
 
-							new_collider_data transfer_data = new_collider_data(handle, math_2d_util::fvec2d(ref_struct.x, ref_struct.y), math_2d_util::fvec2d(ref_struct.velocity_x, ref_struct.velocity_y), ref_struct.radius);
+							if constexpr (is_physics_stats_enabled)
+							{
+								++per_worker_scratch_buffers[worker_index].step_stats.sector_transfers_per_direction[get_sector_transfer_direction(from_coordinate, to_coordinate)];
+							}
+
+							//a crowd pushing over one edge can fill the buffer, the rest wait in the shared pool and are moved once the transfer is done
+							//they stay in this sector and under their old tile until then
+							if (transfer_buffer_to_add_to.size() == transfer_buffer_to_add_to.max_size())
+							{
+								push_pending_sector_move(pending_sector_move{ handle, from_coordinate, scalar_vec2d(ref_struct.x, ref_struct.y) });
+
+								if constexpr (is_physics_stats_enabled)
+								{
+									++per_worker_scratch_buffers[worker_index].step_stats.transfer_spills;
+								}
+
+								return;
+							}
+
+							//remove from old tile, next sector will put it into the new tile
+							colliders_in_tile_tracker.remove(from_address.index, handle);
 
-							//check that the transfer buffer is not full
-							assert(transfer_buffer_to_add_to.size() != transfer_buffer_to_add_to.max_size());
+							mark_tile_bounds_dirty(from_address.index);
+
+							new_collider_data transfer_data = new_collider_data(handle, scalar_vec2d(ref_struct.x, ref_struct.y), scalar_vec2d(ref_struct.velocity_x, ref_struct.velocity_y), ref_struct.radius);
 
 							//add to correct buffer
 							transfer_buffer_to_add_to.push_back(transfer_data);
@@ -1287,10 +4566,12 @@ namespace ContinuousCollisionLibrary
 					
 				});
 		}
+
+		sub_steps_per_sector[sector_index] = most_sub_steps_in_sector;
 	}
 
-	template<size_t Imax_objects, size_t Iworld_sector_x_count>
-	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count>::draw_debug(debug_draw_interface& draw_interface)
+	template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+	inline void phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>::draw_debug(debug_draw_interface& draw_interface)
 	{
 		//draw a grid for all the tiles
 		draw_interface.draw_grid(math_2d_util::fvec2d(0, 0), math_2d_util::ivec2d(grid_dimension_type::tile_w, grid_dimension_type::tile_w), 1.0f, debug_draw_interface::to_colour(200, 200, 200));
@@ -1338,7 +4619,7 @@ namespace ContinuousCollisionLibrary
 					{
 						collision_data_ref ref_struct = collision_data_container.get(real_address);
 
-						draw_interface.draw_circle(math_2d_util::fvec2d(ref_struct.x, ref_struct.y), ref_struct.radius, debug_draw_interface::to_colour(0, 255, 0));
+						draw_interface.draw_circle(to_float_vector(ref_struct.x, ref_struct.y), Tnumeric_policy::to_float(ref_struct.radius), debug_draw_interface::to_colour(0, 255, 0));
 					});
 			}
 		}
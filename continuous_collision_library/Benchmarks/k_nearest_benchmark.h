@@ -0,0 +1,145 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+#include "continuous_collision_library/2d_physics_main.h"
+
+namespace ContinuousCollisionLibrary
+{
+	//compare the spiral tile k nearest search against checking every collider
+	static class k_nearest_benchmark
+	{
+	public:
+		static void run_benchmark(uint32 collider_count = 20000, uint32 query_count = 4096, uint32 k = 8)
+		{
+			using physics_main_type = phyisics_2d_main<std::numeric_limits<uint16>::max() - 1, 16>;
+			using handle_type = physics_main_type::handle_type;
+
+			constexpr uint32 seed = 1234;
+			constexpr float world_size = static_cast<float>(physics_main_type::grid_dimension_type::tile_w);
+
+			std::unique_ptr<physics_main_type> physics_main = std::make_unique<physics_main_type>();
+
+			physics_main->set_worker_count(0);
+
+			srand(seed);
+
+			auto random_position = []()
+				{
+					float random_x = static_cast<float>(rand()) / RAND_MAX;
+					float random_y = static_cast<float>(rand()) / RAND_MAX;
+
+					return math_2d_util::fvec2d((random_x * (world_size - 2.0f)) + 1.0f, (random_y * (world_size - 2.0f)) + 1.0f);
+				};
+
+			std::vector<handle_type> handles;
+
+			for (uint32 i = 0; i < collider_count; ++i)
+			{
+				physics_main_type::new_collider_data collider_to_add;
+
+				collider_to_add.position = random_position();
+				collider_to_add.velocity = math_2d_util::fvec2d(0.0f);
+				collider_to_add.radius = 0.5f;
+
+				handles.push_back(physics_main->try_queue_item_to_add(std::move(collider_to_add)));
+			}
+
+			physics_main->update_physics();
+
+			//read back where everything ended up after the first step pushed the overlapping colliders apart
+			std::vector<math_2d_util::fvec2d> positions;
+
+			std::for_each(handles.begin(), handles.end(), [&](handle_type handle) { positions.push_back(physics_main->get_position(handle)); });
+
+			std::vector<physics_main_type::k_nearest_query> queries(query_count);
+
+			std::for_each(queries.begin(), queries.end(), [&](auto& query) { query.point = random_position(); });
+
+			std::vector<handle_type> found_handles(query_count * k);
+			std::vector<uint32> found_counts(query_count);
+
+			auto time_ms = [&](auto&& func)
+				{
+					auto start_time = std::chrono::steady_clock::now();
+
+					func();
+
+					auto end_time = std::chrono::steady_clock::now();
+
+					return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+				};
+
+			double batched_ms = time_ms([&]()
+				{
+					physics_main->query_k_nearest_batch(queries, k, found_handles, found_counts);
+				});
+
+			double single_ms = time_ms([&]()
+				{
+					for (uint32 iquery = 0; iquery < query_count; ++iquery)
+					{
+						found_counts[iquery] = physics_main->query_k_nearest(queries[iquery].point, k, std::span<handle_type>(found_handles).subspan(iquery * k, k));
+					}
+				});
+
+			//brute force keeps the distances so they can be checked against the grid search
+			std::vector<float> brute_force_distances(query_count * k);
+
+			double brute_force_ms = time_ms([&]()
+				{
+					std::vector<std::pair<float, uint32>> all_distances(collider_count);
+
+					for (uint32 iquery = 0; iquery < query_count; ++iquery)
+					{
+						math_2d_util::fvec2d point = queries[iquery].point;
+
+						for (uint32 icollider = 0; icollider < collider_count; ++icollider)
+						{
+							float offset_x = positions[icollider].x - point.x;
+							float offset_y = positions[icollider].y - point.y;
+
+							all_distances[icollider] = { (offset_x * offset_x) + (offset_y * offset_y), icollider };
+						}
+
+						std::partial_sort(all_distances.begin(), all_distances.begin() + k, all_distances.end());
+
+						for (uint32 i = 0; i < k; ++i)
+						{
+							brute_force_distances[(iquery * k) + i] = all_distances[i].first;
+						}
+					}
+				});
+
+			//handles can differ when two colliders are the same distance away so compare distances
+			for (uint32 iquery = 0; iquery < query_count; ++iquery)
+			{
+				assert(found_counts[iquery] == k);
+
+				for (uint32 i = 0; i < k; ++i)
+				{
+					math_2d_util::fvec2d found_position = physics_main->get_position(found_handles[(iquery * k) + i]);
+
+					float offset_x = found_position.x - queries[iquery].point.x;
+					float offset_y = found_position.y - queries[iquery].point.y;
+
+					float found_distance = (offset_x * offset_x) + (offset_y * offset_y);
+
+					assert(std::abs(found_distance - brute_force_distances[(iquery * k) + i]) < 0.001f);
+				}
+			}
+
+			std::cout << "colliders: " << collider_count << " queries: " << query_count << " k: " << k << "\n";
+			std::cout << "batched k nearest ms:     " << batched_ms << "\n";
+			std::cout << "single k nearest ms:      " << single_ms << "\n";
+			std::cout << "brute force k nearest ms: " << brute_force_ms << "\n";
+			std::cout << "brute force / batched:    " << (brute_force_ms / batched_ms) << "\n";
+		}
+	};
+};
@@ -0,0 +1,211 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+
+#include "continuous_collision_library/2d_physics_main.h"
+#include "continuous_collision_library/Benchmarks/scenario_generator.h"
+
+namespace ContinuousCollisionLibrary
+{
+	//step a scenario and time every phase of update_physics on its own
+	//reports the min, median and p99 of each phase so a regression in the slow steps shows up and not just in the average
+	static class phase_timing_benchmark
+	{
+	public:
+		struct benchmark_settings
+		{
+			scenario_settings scenario;
+
+			//steps run before timing starts, the first step adds every collider so it is always left out
+			uint32 warmup_steps = 10;
+
+			uint32 measured_steps = 200;
+
+			//0 = all hardware threads
+			uint32 worker_count = 0;
+		};
+
+		//all times in microseconds
+		struct timing_summary
+		{
+			double min = 0.0;
+			double median = 0.0;
+			double p99 = 0.0;
+			double max = 0.0;
+			double mean = 0.0;
+		};
+
+		//returns false if the json file could not be written
+		template<typename Tphysics_type>
+		static bool run_benchmark(const benchmark_settings& settings, const std::filesystem::path& json_path)
+		{
+			using update_phase = typename Tphysics_type::update_phase;
+
+			constexpr uint32 phase_count = Tphysics_type::update_phase_count;
+
+			static_assert(phase_count == phase_names.size());
+
+			std::unique_ptr<Tphysics_type> physics = std::make_unique<Tphysics_type>();
+
+			physics->set_worker_count(settings.worker_count);
+
+			uint32 spawned_count = scenario_generator::spawn(*physics, settings.scenario);
+
+			std::cout << "Timing scenario " << scenario_generator::get_name(settings.scenario.type) << " seed " << settings.scenario.seed << " with " << spawned_count << " colliders\n";
+
+			for (uint32 i = 0; i < std::max<uint32>(settings.warmup_steps, 1); ++i)
+			{
+				physics->update_physics();
+			}
+
+			//one list of step times per phase, plus the whole step timed from outside on the end
+			std::array<std::vector<double>, phase_count + 1> times;
+
+			std::for_each(times.begin(), times.end(), [&](std::vector<double>& phase_times) { phase_times.reserve(settings.measured_steps); });
+
+			for (uint32 i = 0; i < settings.measured_steps; ++i)
+			{
+				auto step_start = std::chrono::steady_clock::now();
+
+				physics->update_physics();
+
+				auto step_time = std::chrono::steady_clock::now() - step_start;
+
+				const auto& phase_times = physics->get_last_update_phase_times();
+
+				for (uint32 phase = 0; phase < phase_count; ++phase)
+				{
+					times[phase].push_back(to_microseconds(phase_times[phase]));
+				}
+
+				times[phase_count].push_back(to_microseconds(step_time));
+			}
+
+			std::array<timing_summary, phase_count + 1> summaries;
+
+			std::transform(times.begin(), times.end(), summaries.begin(), [](std::vector<double>& phase_times) { return summarise(phase_times); });
+
+			//print a table so a run can be read without opening the json
+			std::cout << std::fixed << std::setprecision(1);
+			std::cout << std::setw(20) << "phase (us)" << std::setw(10) << "min" << std::setw(10) << "median" << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+			for (uint32 phase = 0; phase < phase_count + 1; ++phase)
+			{
+				std::string_view name = phase < phase_count ? phase_names[phase] : "step";
+
+				const timing_summary& summary = summaries[phase];
+
+				std::cout << std::setw(20) << name << std::setw(10) << summary.min << std::setw(10) << summary.median << std::setw(10) << summary.p99 << std::setw(10) << summary.max << "\n";
+			}
+
+			std::ofstream file(json_path, std::ios::trunc);
+
+			if (!file)
+			{
+				std::cout << "Could not open " << json_path.string() << "\n";
+
+				return false;
+			}
+
+			file << std::fixed << std::setprecision(3);
+			file << "{\n";
+			file << "  \"scenario\": \"" << scenario_generator::get_name(settings.scenario.type) << "\",\n";
+			file << "  \"seed\": " << settings.scenario.seed << ",\n";
+			file << "  \"collider_count\": " << spawned_count << ",\n";
+			file << "  \"worker_count\": " << physics->get_worker_count() << ",\n";
+			file << "  \"warmup_steps\": " << settings.warmup_steps << ",\n";
+			file << "  \"measured_steps\": " << settings.measured_steps << ",\n";
+			file << "  \"units\": \"microseconds\",\n";
+			file << "  \"phases\": {\n";
+
+			for (uint32 phase = 0; phase < phase_count; ++phase)
+			{
+				file << "    \"" << phase_names[phase] << "\": ";
+
+				write_summary(file, summaries[phase]);
+
+				file << (phase + 1 < phase_count ? ",\n" : "\n");
+			}
+
+			file << "  },\n";
+			file << "  \"step\": ";
+
+			write_summary(file, summaries[phase_count]);
+
+			file << "\n}\n";
+
+			std::cout << "Wrote " << json_path.string() << "\n";
+
+			return static_cast<bool>(file.flush());
+		}
+
+	private:
+		//in the same order as phyisics_2d_main::update_phase
+		static constexpr std::array<std::string_view, 11> phase_names = {
+			"add",
+			"motion_commands",
+			"time_of_impact",
+			"remove",
+			"long_range_transfer",
+			"integrate",
+			"transfer",
+			"bounds",
+			"pairs",
+			"solve",
+			"sleep" };
+
+		static double to_microseconds(std::chrono::steady_clock::duration duration)
+		{
+			return std::chrono::duration<double, std::micro>(duration).count();
+		}
+
+		//sorts the times in place
+		static timing_summary summarise(std::vector<double>& phase_times)
+		{
+			timing_summary summary;
+
+			if (phase_times.empty())
+			{
+				return summary;
+			}
+
+			std::sort(phase_times.begin(), phase_times.end());
+
+			size_t count = phase_times.size();
+
+			//nearest rank, with fewer than 100 steps the p99 is the slowest step
+			auto percentile = [&](size_t percent)
+				{
+					size_t rank = ((count * percent) + 99) / 100;
+
+					return phase_times[std::max<size_t>(rank, 1) - 1];
+				};
+
+			summary.min = phase_times.front();
+			summary.median = percentile(50);
+			summary.p99 = percentile(99);
+			summary.max = phase_times.back();
+
+			double total = 0.0;
+
+			std::for_each(phase_times.begin(), phase_times.end(), [&](double time) { total += time; });
+
+			summary.mean = total / static_cast<double>(count);
+
+			return summary;
+		}
+
+		static void write_summary(std::ofstream& file, const timing_summary& summary)
+		{
+			file << "{ \"min\": " << summary.min << ", \"median\": " << summary.median << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max << ", \"mean\": " << summary.mean << " }";
+		}
+	};
+};
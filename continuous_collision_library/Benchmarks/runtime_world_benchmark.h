@@ -0,0 +1,63 @@
+#pragma once
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "continuous_collision_library/2d_physics_main.h"
+#include "continuous_collision_library/physics_2d_world.h"
+
+namespace ContinuousCollisionLibrary
+{
+	//compare the step time of the templated world against the same world created through physics_2d_world
+	static class runtime_world_benchmark
+	{
+	public:
+		static void run_benchmark(uint32 collider_count = 20000, uint32 step_count = 100, float max_velocity = 200.0f)
+		{
+			using physics_main_type = phyisics_2d_main<std::numeric_limits<uint16>::max() - 1, 16>;
+
+			constexpr uint32 seed = 1234;
+
+			std::unique_ptr<physics_main_type> templated_world = std::make_unique<physics_main_type>();
+
+			std::unique_ptr<physics_2d_world> runtime_world = physics_2d_world::create({ std::numeric_limits<uint16>::max() - 1, 16 });
+
+			//make sure the runtime world picked the same size so we are comparing the same thing
+			assert(runtime_world->get_max_objects() == std::numeric_limits<uint16>::max() - 1);
+			assert(runtime_world->get_world_sector_x_count() == 16);
+
+			templated_world->set_worker_count(0);
+			runtime_world->set_worker_count(0);
+
+			//spawn the same colliders in both
+			srand(seed);
+			templated_world->setup_physics_random(collider_count, max_velocity);
+
+			srand(seed);
+			runtime_world->setup_physics_random(collider_count, max_velocity);
+
+			auto time_steps = [&](auto&& step_func)
+				{
+					auto start_time = std::chrono::steady_clock::now();
+
+					for (uint32 i = 0; i < step_count; ++i)
+					{
+						step_func();
+					}
+
+					auto end_time = std::chrono::steady_clock::now();
+
+					return std::chrono::duration<double, std::milli>(end_time - start_time).count() / step_count;
+				};
+
+			double templated_ms_per_step = time_steps([&]() { templated_world->update_physics(); });
+			double runtime_ms_per_step = time_steps([&]() { runtime_world->update_physics(); });
+
+			std::cout << "colliders: " << collider_count << " steps: " << step_count << "\n";
+			std::cout << "templated world ms per step: " << templated_ms_per_step << "\n";
+			std::cout << "runtime world ms per step:   " << runtime_ms_per_step << "\n";
+			std::cout << "runtime / templated:         " << (runtime_ms_per_step / templated_ms_per_step) << "\n";
+		}
+	};
+};
@@ -0,0 +1,357 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <string_view>
+#include <algorithm>
+
+#include "continuous_collision_library/2d_physics_main.h"
+
+#include <assert.h>
+
+//seeded scenes for the benchmarks, the random numbers come from our own generator and maths
+//so the same seed gives the same scene on every compiler and standard library
+
+namespace ContinuousCollisionLibrary
+{
+	enum class scenario_type : uint8
+	{
+		UNIFORM, //spread evenly over the whole world moving in random directions
+		CLUSTERED_BLOBS, //tight blobs paired up and charging at each other like two armies meeting
+		OPPOSING_LANES, //horizontal lanes with a crowd at each end walking at the other
+		SINGLE_SECTOR, //everything packed into one sector in the middle of the world
+		EDGE_BOUNCERS, //colliders running along the world edge and bouncing off it
+		COUNT
+	};
+
+	//settings shared by all the scenarios, the ones that dont apply to a scenario are ignored
+	struct scenario_settings
+	{
+		scenario_type type = scenario_type::UNIFORM;
+
+		uint32 seed = 1234;
+
+		uint32 collider_count = 20000;
+
+		//speed in tiles per second, each collider gets a speed between the min and max
+		float min_speed = 0.0f;
+		float max_speed = 100.0f;
+
+		//each collider gets a radius between the min and max
+		float min_radius = 0.5f;
+		float max_radius = 1.5f;
+
+		//number of blobs for CLUSTERED_BLOBS, rounded up to an even number so every blob has an opponent
+		uint32 blob_count = 8;
+		float blob_radius = 12.0f;
+
+		//number of lanes for OPPOSING_LANES and how wide each one is in tiles
+		uint32 lane_count = 8;
+		float lane_width = 6.0f;
+
+		//how far in from the world edge EDGE_BOUNCERS start in tiles
+		float edge_band_width = 4.0f;
+	};
+
+	//a collider created by a scenario, in floats so it can be fed to any physics world
+	struct scenario_collider
+	{
+		math_2d_util::fvec2d position;
+		math_2d_util::fvec2d velocity;
+		float radius;
+	};
+
+	//small fast generator with a fixed algorithm, std distributions are allowed to differ between standard libraries
+	struct scenario_random
+	{
+		uint64 state;
+
+		explicit scenario_random(uint32 seed) :state(seed) {}
+
+		//splitmix64
+		uint64 next()
+		{
+			state += 0x9e3779b97f4a7c15ull;
+
+			uint64 value = state;
+			value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+			value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+
+			return value ^ (value >> 31);
+		}
+
+		//0 to 1 not including 1, the top 24 bits fill a float mantissa exactly
+		float next_float()
+		{
+			return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+		}
+
+		float next_range(float min_value, float max_value)
+		{
+			return min_value + ((max_value - min_value) * next_float());
+		}
+
+		//roughly bell shaped between -1 and 1, the sum of uniforms avoids the platform dependant log and sqrt a true normal needs
+		float next_centered()
+		{
+			return (next_float() + next_float() + next_float() + next_float() - 2.0f) * 0.5f;
+		}
+
+		uint32 next_index(uint32 count)
+		{
+			return static_cast<uint32>((next() >> 32) % count);
+		}
+	};
+
+	static class scenario_generator
+	{
+	public:
+		static constexpr uint32 scenario_count = static_cast<uint32>(scenario_type::COUNT);
+
+		static constexpr std::array<std::string_view, scenario_count> scenario_names = {
+			"uniform",
+			"clustered_blobs",
+			"opposing_lanes",
+			"single_sector",
+			"edge_bouncers" };
+
+		static std::string_view get_name(scenario_type type)
+		{
+			assert(type < scenario_type::COUNT);
+
+			return scenario_names[static_cast<uint32>(type)];
+		}
+
+		//returns false if the name does not match any scenario
+		static bool try_get_type_from_name(std::string_view name, scenario_type& out_type)
+		{
+			auto found = std::find(scenario_names.begin(), scenario_names.end(), name);
+
+			out_type = static_cast<scenario_type>(found - scenario_names.begin());
+
+			return found != scenario_names.end();
+		}
+
+		//call add_collider(const scenario_collider&) for every collider in the scene
+		//world_size is the width of the square world in tiles and sector_size is the width of a sector in tiles
+		template<typename Tadd_func>
+		static void generate(const scenario_settings& settings, float world_size, float sector_size, Tadd_func&& add_collider)
+		{
+			assert(settings.min_radius > 0.0f && settings.min_radius <= settings.max_radius);
+			assert(settings.min_speed >= 0.0f && settings.min_speed <= settings.max_speed);
+
+			scenario_random random(settings.seed);
+
+			//keep the whole circle inside the world
+			auto clamp_to_world = [&](math_2d_util::fvec2d position, float radius)
+				{
+					return math_2d_util::fvec2d(std::clamp(position.x, radius, world_size - radius), std::clamp(position.y, radius, world_size - radius));
+				};
+
+			auto random_radius = [&]()
+				{
+					return random.next_range(settings.min_radius, settings.max_radius);
+				};
+
+			auto random_speed = [&]()
+				{
+					return random.next_range(settings.min_speed, settings.max_speed);
+				};
+
+			//a random point in a square pushed out to length 1, not quite uniform but it needs no trig and is close enough for a benchmark
+			auto random_direction = [&]()
+				{
+					math_2d_util::fvec2d direction(random.next_range(-1.0f, 1.0f), random.next_range(-1.0f, 1.0f));
+
+					float length = std::sqrt((direction.x * direction.x) + (direction.y * direction.y));
+
+					return length > 0.0f ? math_2d_util::fvec2d(direction.x / length, direction.y / length) : math_2d_util::fvec2d(1.0f, 0.0f);
+				};
+
+			switch (settings.type)
+			{
+			case scenario_type::UNIFORM:
+			{
+				for (uint32 i = 0; i < settings.collider_count; ++i)
+				{
+					float radius = random_radius();
+
+					math_2d_util::fvec2d position(random.next_range(0.0f, world_size), random.next_range(0.0f, world_size));
+
+					math_2d_util::fvec2d direction = random_direction();
+
+					float speed = random_speed();
+
+					add_collider(scenario_collider{ clamp_to_world(position, radius), math_2d_util::fvec2d(direction.x * speed, direction.y * speed), radius });
+				}
+
+				break;
+			}
+			case scenario_type::CLUSTERED_BLOBS:
+			{
+				uint32 blob_count = std::max<uint32>(2, settings.blob_count + (settings.blob_count & 1));
+
+				//place the blob centers far enough in that the blobs start inside the world
+				float margin = std::min(settings.blob_radius, world_size * 0.5f);
+
+				std::array<math_2d_util::fvec2d, 256> blob_centers;
+
+				blob_count = std::min<uint32>(blob_count, static_cast<uint32>(blob_centers.size()));
+
+				for (uint32 i = 0; i < blob_count; ++i)
+				{
+					blob_centers[i] = math_2d_util::fvec2d(random.next_range(margin, world_size - margin), random.next_range(margin, world_size - margin));
+				}
+
+				for (uint32 i = 0; i < settings.collider_count; ++i)
+				{
+					uint32 blob = i % blob_count;
+
+					//each blob charges at its partner
+					math_2d_util::fvec2d center = blob_centers[blob];
+					math_2d_util::fvec2d target = blob_centers[blob ^ 1];
+
+					math_2d_util::fvec2d to_target(target.x - center.x, target.y - center.y);
+
+					float distance = std::sqrt((to_target.x * to_target.x) + (to_target.y * to_target.y));
+
+					math_2d_util::fvec2d direction = distance > 0.0f ? math_2d_util::fvec2d(to_target.x / distance, to_target.y / distance) : random_direction();
+
+					float radius = random_radius();
+
+					math_2d_util::fvec2d position(center.x + (random.next_centered() * settings.blob_radius), center.y + (random.next_centered() * settings.blob_radius));
+
+					//a little sideways wobble so the blob does not move as one rigid block
+					float speed = random_speed();
+					float wobble = random.next_range(-0.1f, 0.1f) * speed;
+
+					math_2d_util::fvec2d velocity((direction.x * speed) - (direction.y * wobble), (direction.y * speed) + (direction.x * wobble));
+
+					add_collider(scenario_collider{ clamp_to_world(position, radius), velocity, radius });
+				}
+
+				break;
+			}
+			case scenario_type::OPPOSING_LANES:
+			{
+				uint32 lane_count = std::max<uint32>(1, settings.lane_count);
+
+				float lane_spacing = world_size / static_cast<float>(lane_count);
+
+				//each crowd starts in the outer quarter of the world at its end of the lane
+				float crowd_length = world_size * 0.25f;
+
+				for (uint32 i = 0; i < settings.collider_count; ++i)
+				{
+					uint32 lane = i % lane_count;
+
+					bool is_heading_left = (i / lane_count) & 1;
+
+					float radius = random_radius();
+
+					float lane_center = (static_cast<float>(lane) + 0.5f) * lane_spacing;
+
+					float along_lane = random.next_range(0.0f, crowd_length);
+
+					math_2d_util::fvec2d position(
+						is_heading_left ? world_size - along_lane : along_lane,
+						lane_center + random.next_range(-0.5f, 0.5f) * settings.lane_width);
+
+					float speed = random_speed();
+
+					math_2d_util::fvec2d velocity(is_heading_left ? -speed : speed, random.next_range(-0.05f, 0.05f) * speed);
+
+					add_collider(scenario_collider{ clamp_to_world(position, radius), velocity, radius });
+				}
+
+				break;
+			}
+			case scenario_type::SINGLE_SECTOR:
+			{
+				//the sector just below and right of the center of the world
+				float sector_min = std::floor((world_size * 0.5f) / sector_size) * sector_size;
+
+				for (uint32 i = 0; i < settings.collider_count; ++i)
+				{
+					//keep small enough to fit in the sector at least
+					float radius = std::min(random_radius(), sector_size * 0.5f);
+
+					math_2d_util::fvec2d position(
+						random.next_range(sector_min + radius, sector_min + sector_size - radius),
+						random.next_range(sector_min + radius, sector_min + sector_size - radius));
+
+					math_2d_util::fvec2d direction = random_direction();
+
+					float speed = random_speed();
+
+					add_collider(scenario_collider{ position, math_2d_util::fvec2d(direction.x * speed, direction.y * speed), radius });
+				}
+
+				break;
+			}
+			case scenario_type::EDGE_BOUNCERS:
+			{
+				float band_width = std::min(settings.edge_band_width, world_size * 0.5f);
+
+				for (uint32 i = 0; i < settings.collider_count; ++i)
+				{
+					//0 = top, 1 = right, 2 = bottom, 3 = left
+					uint32 edge = random.next_index(4);
+
+					float radius = random_radius();
+
+					float along_edge = random.next_range(0.0f, world_size);
+					float into_world = random.next_range(0.0f, band_width);
+
+					bool is_vertical_edge = edge & 1;
+					bool is_far_edge = (edge == 1) || (edge == 2);
+
+					float distance_from_origin = is_far_edge ? world_size - into_world : into_world;
+
+					math_2d_util::fvec2d position = is_vertical_edge ? math_2d_util::fvec2d(distance_from_origin, along_edge) : math_2d_util::fvec2d(along_edge, distance_from_origin);
+
+					//mostly along the edge with some speed into the wall so they keep bouncing off it
+					float speed = random_speed();
+					float along_speed = (random.next_float() < 0.5f ? -0.8f : 0.8f) * speed;
+					float into_wall_speed = (is_far_edge ? 0.6f : -0.6f) * speed;
+
+					math_2d_util::fvec2d velocity = is_vertical_edge ? math_2d_util::fvec2d(into_wall_speed, along_speed) : math_2d_util::fvec2d(along_speed, into_wall_speed);
+
+					add_collider(scenario_collider{ clamp_to_world(position, radius), velocity, radius });
+				}
+
+				break;
+			}
+			default:
+				assert(false);
+			}
+		}
+
+		//queue every collider in the scene to be added to a physics world, returns how many were accepted
+		template<size_t Imax_objects, size_t Iworld_sector_x_count, typename Tnumeric_policy>
+		static uint32 spawn(phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>& physics, const scenario_settings& settings)
+		{
+			using physics_main_type = phyisics_2d_main<Imax_objects, Iworld_sector_x_count, Tnumeric_policy>;
+			using scalar_vec2d = typename physics_main_type::scalar_vec2d;
+
+			constexpr float world_size = static_cast<float>(physics_main_type::grid_dimension_type::tile_w);
+			constexpr float sector_size = static_cast<float>(physics_main_type::grid_dimension_type::sector_w);
+
+			uint32 added_count = 0;
+
+			generate(settings, world_size, sector_size, [&](const scenario_collider& collider)
+				{
+					typename physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = scalar_vec2d(Tnumeric_policy::from_float(collider.position.x), Tnumeric_policy::from_float(collider.position.y));
+					collider_to_add.velocity = scalar_vec2d(Tnumeric_policy::from_float(collider.velocity.x), Tnumeric_policy::from_float(collider.velocity.y));
+					collider_to_add.radius = Tnumeric_policy::from_float(collider.radius);
+
+					auto handle = physics.try_queue_item_to_add(std::move(collider_to_add));
+
+					added_count += handle.get_index() != physics_main_type::handle_type::get_invalid_index();
+				});
+
+			return added_count;
+		}
+	};
+};
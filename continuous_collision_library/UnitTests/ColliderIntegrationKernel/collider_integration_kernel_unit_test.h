@@ -0,0 +1,186 @@
+#pragma once
+#include <array>
+#include <cstdlib>
+#include <assert.h>
+
+#include "continuous_collision_library/collider_integration_kernel.h"
+
+namespace ContinuousCollisionLibrary
+{
+	static class collider_integration_kernel_unit_test
+	{
+	public:
+		static void run_test()
+		{
+			//check the batched version matches a plain loop, use an odd count so the tail gets tested
+			constexpr uint32 collider_count = 37;
+			constexpr float time_step = 1.0f / 60.0f;
+			constexpr float world_edge = 32.0f;
+
+			std::array<float, collider_count> x;
+			std::array<float, collider_count> y;
+			std::array<float, collider_count> velocity_x;
+			std::array<float, collider_count> velocity_y;
+			std::array<float, collider_count> radius;
+			std::array<float, collider_count> move_fraction;
+			std::array<float, collider_count> sub_step_fraction;
+
+			for (uint32 i = 0; i < collider_count; ++i)
+			{
+				//keep some right up against the edges so the bounce gets hit
+				x[i] = (i % 5 == 0) ? 0.6f : static_cast<float>(rand() % 3100) / 100.0f + 0.5f;
+				y[i] = (i % 7 == 0) ? 31.4f : static_cast<float>(rand() % 3100) / 100.0f + 0.5f;
+				velocity_x[i] = static_cast<float>((rand() % 400) - 200);
+				velocity_y[i] = static_cast<float>((rand() % 400) - 200);
+				radius[i] = 0.5f;
+				sub_step_fraction[i] = 1.0f / static_cast<float>((rand() % 4) + 1);
+
+				//every few colliders has finished its sub steps and should not move
+				move_fraction[i] = (i % 6 == 0) ? 0.0f : sub_step_fraction[i];
+			}
+
+			std::array<float, collider_count> expected_x = x;
+			std::array<float, collider_count> expected_y = y;
+			std::array<float, collider_count> expected_velocity_x = velocity_x;
+			std::array<float, collider_count> expected_velocity_y = velocity_y;
+			std::array<bool, collider_count> expected_changed_tile = {};
+
+			for (uint32 i = 0; i < collider_count; ++i)
+			{
+				bool is_moving = move_fraction[i] != 0.0f;
+
+				float next_move_x = expected_velocity_x[i] * time_step * sub_step_fraction[i];
+				float next_move_y = expected_velocity_y[i] * time_step * sub_step_fraction[i];
+
+				if ((((expected_x[i] + radius[i]) + next_move_x) > world_edge || ((expected_x[i] - radius[i]) + next_move_x) < 0.0f) && is_moving)
+				{
+					expected_velocity_x[i] = -expected_velocity_x[i];
+				}
+
+				if ((((expected_y[i] + radius[i]) + next_move_y) > world_edge || ((expected_y[i] - radius[i]) + next_move_y) < 0.0f) && is_moving)
+				{
+					expected_velocity_y[i] = -expected_velocity_y[i];
+				}
+
+				uint32 old_tile_x = static_cast<uint32>(expected_x[i]);
+				uint32 old_tile_y = static_cast<uint32>(expected_y[i]);
+
+				expected_x[i] += expected_velocity_x[i] * time_step * move_fraction[i];
+				expected_y[i] += expected_velocity_y[i] * time_step * move_fraction[i];
+
+				expected_changed_tile[i] = (old_tile_x != static_cast<uint32>(expected_x[i])) || (old_tile_y != static_cast<uint32>(expected_y[i]));
+			}
+
+			std::array<uint32, collider_count> old_tile_x;
+			std::array<uint32, collider_count> old_tile_y;
+			std::array<uint32, collider_count + collider_integration_kernel::simd_width> changed;
+
+			std::array<float, collider_count> start_x = x;
+			std::array<float, collider_count> start_y = y;
+
+			uint32 changed_count = collider_integration_kernel::integrate(x, y, velocity_x, velocity_y, radius, move_fraction, sub_step_fraction, time_step, world_edge, old_tile_x, old_tile_y, changed);
+
+			uint32 expected_changed_count = 0;
+
+			for (uint32 i = 0; i < collider_count; ++i)
+			{
+				assert(x[i] == expected_x[i] && y[i] == expected_y[i]);
+				assert(velocity_x[i] == expected_velocity_x[i] && velocity_y[i] == expected_velocity_y[i]);
+				assert(old_tile_x[i] == static_cast<uint32>(start_x[i]) && old_tile_y[i] == static_cast<uint32>(start_y[i]));
+
+				//changed colliders come out in order
+				if (expected_changed_tile[i])
+				{
+					assert(expected_changed_count < changed_count && changed[expected_changed_count] == i);
+
+					++expected_changed_count;
+				}
+			}
+
+			assert(changed_count == expected_changed_count);
+
+			//the fixed point version has to match a plain loop bit for bit
+			{
+				using fixed_type = fixed_point<16>;
+
+				const fixed_type fixed_time_step = fixed_type(time_step);
+				const fixed_type fixed_world_edge = fixed_type(world_edge);
+
+				std::array<fixed_type, collider_count> fixed_x;
+				std::array<fixed_type, collider_count> fixed_y;
+				std::array<fixed_type, collider_count> fixed_velocity_x;
+				std::array<fixed_type, collider_count> fixed_velocity_y;
+				std::array<fixed_type, collider_count> fixed_radius;
+				std::array<fixed_type, collider_count> fixed_move_fraction;
+				std::array<fixed_type, collider_count> fixed_sub_step_fraction;
+
+				for (uint32 i = 0; i < collider_count; ++i)
+				{
+					fixed_x[i] = fixed_type(start_x[i]);
+					fixed_y[i] = fixed_type(start_y[i]);
+					fixed_velocity_x[i] = fixed_type(static_cast<float>((rand() % 400) - 200));
+					fixed_velocity_y[i] = fixed_type(static_cast<float>((rand() % 400) - 200));
+					fixed_radius[i] = fixed_type(radius[i]);
+					fixed_move_fraction[i] = fixed_type(move_fraction[i]);
+					fixed_sub_step_fraction[i] = fixed_type(sub_step_fraction[i]);
+				}
+
+				std::array<fixed_type, collider_count> expected_fixed_x = fixed_x;
+				std::array<fixed_type, collider_count> expected_fixed_y = fixed_y;
+				std::array<fixed_type, collider_count> expected_fixed_velocity_x = fixed_velocity_x;
+				std::array<fixed_type, collider_count> expected_fixed_velocity_y = fixed_velocity_y;
+				std::array<bool, collider_count> expected_fixed_changed_tile = {};
+
+				for (uint32 i = 0; i < collider_count; ++i)
+				{
+					bool is_moving = fixed_move_fraction[i] != fixed_type();
+
+					fixed_type next_move_x = expected_fixed_velocity_x[i] * fixed_time_step * fixed_sub_step_fraction[i];
+					fixed_type next_move_y = expected_fixed_velocity_y[i] * fixed_time_step * fixed_sub_step_fraction[i];
+
+					if ((((expected_fixed_x[i] + fixed_radius[i]) + next_move_x) > fixed_world_edge || ((expected_fixed_x[i] - fixed_radius[i]) + next_move_x) < fixed_type()) && is_moving)
+					{
+						expected_fixed_velocity_x[i] = -expected_fixed_velocity_x[i];
+					}
+
+					if ((((expected_fixed_y[i] + fixed_radius[i]) + next_move_y) > fixed_world_edge || ((expected_fixed_y[i] - fixed_radius[i]) + next_move_y) < fixed_type()) && is_moving)
+					{
+						expected_fixed_velocity_y[i] = -expected_fixed_velocity_y[i];
+					}
+
+					uint32 old_tile_x = static_cast<uint32>(expected_fixed_x[i]);
+					uint32 old_tile_y = static_cast<uint32>(expected_fixed_y[i]);
+
+					expected_fixed_x[i] += expected_fixed_velocity_x[i] * fixed_time_step * fixed_move_fraction[i];
+					expected_fixed_y[i] += expected_fixed_velocity_y[i] * fixed_time_step * fixed_move_fraction[i];
+
+					expected_fixed_changed_tile[i] = (old_tile_x != static_cast<uint32>(expected_fixed_x[i])) || (old_tile_y != static_cast<uint32>(expected_fixed_y[i]));
+				}
+
+				std::array<fixed_type, collider_count> fixed_start_x = fixed_x;
+				std::array<fixed_type, collider_count> fixed_start_y = fixed_y;
+
+				uint32 fixed_changed_count = collider_integration_kernel::integrate(std::span<fixed_type>(fixed_x), std::span<fixed_type>(fixed_y), std::span<fixed_type>(fixed_velocity_x), std::span<fixed_type>(fixed_velocity_y),
+					std::span<const fixed_type>(fixed_radius), std::span<const fixed_type>(fixed_move_fraction), std::span<const fixed_type>(fixed_sub_step_fraction), fixed_time_step, fixed_world_edge, old_tile_x, old_tile_y, changed);
+
+				uint32 expected_fixed_changed_count = 0;
+
+				for (uint32 i = 0; i < collider_count; ++i)
+				{
+					assert(fixed_x[i] == expected_fixed_x[i] && fixed_y[i] == expected_fixed_y[i]);
+					assert(fixed_velocity_x[i] == expected_fixed_velocity_x[i] && fixed_velocity_y[i] == expected_fixed_velocity_y[i]);
+					assert(old_tile_x[i] == static_cast<uint32>(fixed_start_x[i]) && old_tile_y[i] == static_cast<uint32>(fixed_start_y[i]));
+
+					if (expected_fixed_changed_tile[i])
+					{
+						assert(expected_fixed_changed_count < fixed_changed_count && changed[expected_fixed_changed_count] == i);
+
+						++expected_fixed_changed_count;
+					}
+				}
+
+				assert(fixed_changed_count == expected_fixed_changed_count);
+			}
+		}
+	};
+};
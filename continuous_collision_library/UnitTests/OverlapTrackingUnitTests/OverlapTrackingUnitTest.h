@@ -8,7 +8,7 @@
 #include <assert.h>
 #include <ranges>
 
-#include "../../overlap_tracking_grid.hpp"
+#include "../../overlap_tracking_grid.h"
 #include "vector_2d_math_utils/vector_types.h"
 #include "vector_2d_math_utils/byte_vector_2d.h"
 
@@ -406,6 +406,42 @@ namespace ContinuousCollisionLibrary
 					}
 				}
 			}
+
+			//add and remove flags for a full width area that crosses a sector edge so the rows get split into runs
+			{
+				constexpr int32 sector_w = static_cast<int32>(grid_dimension_type::sector_w);
+
+				math_2d_util::ivec2d target_tile(sector_w, 4);
+
+				math_2d_util::irect area{ sector_w - 3, 1, sector_w + 4, 8 };
+
+				math_2d_util::irect empty_bounds = math_2d_util::irect::inverse_max_size_rect();
+
+				auto check_flags = [&](bool expect_set)
+				{
+					for (int32 iy = area.min.y; iy < area.max.y; ++iy)
+					{
+						for (int32 ix = area.min.x; ix < area.max.x; ++ix)
+						{
+							math_2d_util::ivec2d tile_to_check{ ix,iy };
+
+							auto flag_for_source_tile = overlap_grid->calculate_flag_for_tile(target_tile, tile_to_check);
+
+							auto& flag_data = overlap_grid->overlaps.get_ref_to_data(overlap_grid->grid_helper.from_xy(tile_to_check));
+
+							assert(flag_data.has_flags(flag_for_source_tile) == expect_set);
+						}
+					}
+				};
+
+				overlap_grid->add_flag_to_tiles(target_tile, area, empty_bounds, area);
+
+				check_flags(true);
+
+				overlap_grid->remove_flag_from_tiles(target_tile, area, area, empty_bounds);
+
+				check_flags(false);
+			}
 		}
 	};
 }
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <array>
+#include <span>
+#include <cmath>
+#include <vector>
+#include <filesystem>
 
 #include "continuous_collision_library/2d_physics_main.h"
+#include "continuous_collision_library/physics_rollback_buffer.h"
 
 
 
@@ -34,12 +40,840 @@ namespace ContinuousCollisionLibrary
 
 			colider_to_add02.radius = 1.0f;
 
+			//this one is in the same tile as the first one and touching it
+			physics_main_type::new_collider_data colider_to_add03;
+
+			colider_to_add03.position = math_2d_util::fvec2d(0.5f);
+			colider_to_add03.velocity = math_2d_util::fvec2d(0.0f);
+
+			colider_to_add03.radius = 0.5f;
+
 			//queue up a new item 
 			auto colider_handle01 = paged_hirachical_list->try_queue_item_to_add( std::move(colider_to_add01));
 			auto colider_handle02 = paged_hirachical_list->try_queue_item_to_add(std::move(colider_to_add02));
+			auto colider_handle03 = paged_hirachical_list->try_queue_item_to_add(std::move(colider_to_add03));
 
 			paged_hirachical_list->update_physics();
 
+			//the first and third collider should be the only touching pair
+			assert(paged_hirachical_list->get_collider_pair_count_in_sector(0) == 1);
+			assert(paged_hirachical_list->get_collider_pairs_in_sector(0).size() == 1);
+
+			//run a few more steps split across multiple workers
+			paged_hirachical_list->set_worker_count(4);
+
+			assert(paged_hirachical_list->get_worker_count() == 4);
+
+			paged_hirachical_list->set_solver_iterations(8);
+
+			assert(paged_hirachical_list->get_solver_iterations() == 8);
+
+			for (uint32 i = 0; i < 10; ++i)
+			{
+				paged_hirachical_list->update_physics();
+			}
+
+			//a tile packed with more colliders than the pair cache holds still finds every pair
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				//a 10 x 10 grid of small colliders inside one tile, only the ones directly next to each other touch
+				for (uint32 i = 0; i < 100; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(8.05f + (0.1f * static_cast<float>(i % 10)), 8.05f + (0.1f * static_cast<float>(i / 10)));
+					collider_to_add.velocity = math_2d_util::fvec2d(0.0f);
+					collider_to_add.radius = 0.06f;
+
+					world->try_queue_item_to_add(std::move(collider_to_add));
+				}
+
+				world->update_physics();
+
+				assert(world->get_collider_pair_count_in_sector(0) == 2 * 10 * 9);
+				assert(world->get_collider_pairs_in_sector(0).size() == 2 * 10 * 9);
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					assert(world->get_last_step_stats().oversized_pair_tiles == 1);
+				}
+			}
+
+			//a collider removed before the update that adds it is added and removed without touching anything else
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				physics_main_type::new_collider_data kept_collider;
+
+				kept_collider.position = math_2d_util::fvec2d(30.5f, 30.5f);
+				kept_collider.velocity = math_2d_util::fvec2d(0.0f);
+				kept_collider.radius = 0.5f;
+
+				auto kept_handle = world->try_queue_item_to_add(std::move(kept_collider));
+
+				world->update_physics();
+
+				physics_main_type::new_collider_data spawned_collider;
+
+				spawned_collider.position = math_2d_util::fvec2d(100.5f, 100.5f);
+				spawned_collider.velocity = math_2d_util::fvec2d(0.0f);
+				spawned_collider.radius = 0.5f;
+
+				auto spawned_handle = world->try_queue_item_to_add(std::move(spawned_collider));
+
+				assert(world->try_queue_item_to_remove(spawned_handle));
+				assert(!world->try_queue_item_to_remove(spawned_handle));
+
+				world->update_physics();
+
+				std::array<physics_main_type::handle_type, 4> found;
+
+				assert(world->query_circle(math_2d_util::fvec2d(100.5f, 100.5f), 1.0f, found) == 0);
+				assert(world->query_circle(math_2d_util::fvec2d(30.5f, 30.5f), 0.1f, found) == 1 && found[0] == kept_handle);
+				assert(world->get_position(kept_handle) == math_2d_util::fvec2d(30.5f, 30.5f));
+
+				//the handle was given back
+				physics_main_type::new_collider_data replacement_collider;
+
+				replacement_collider.position = math_2d_util::fvec2d(50.5f, 50.5f);
+				replacement_collider.velocity = math_2d_util::fvec2d(0.0f);
+				replacement_collider.radius = 0.5f;
+
+				assert(world->try_queue_item_to_add(std::move(replacement_collider)) == spawned_handle);
+
+				world->update_physics();
+			}
+
+			//a handle that has already been removed is rejected and does not touch the collider that took its place
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				std::array<physics_main_type::handle_type, 3> handles;
+
+				for (uint32 i = 0; i < handles.size(); ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(60.2f + (i * 0.3f), 60.5f);
+					collider_to_add.velocity = math_2d_util::fvec2d(0.0f);
+					collider_to_add.radius = 0.1f;
+
+					handles[i] = world->try_queue_item_to_add(std::move(collider_to_add));
+				}
+
+				world->update_physics();
+
+				//the last collider in the tile gets moved into the slot the first one leaves
+				assert(world->try_queue_item_to_remove(handles[0]));
+
+				world->update_physics();
+
+				assert(!world->is_handle_live(handles[0]));
+				assert(!world->try_queue_item_to_remove(handles[0]));
+				assert(!world->queue_velocity_command(handles[0], math_2d_util::fvec2d(1.0f, 0.0f)));
+				assert(!world->queue_force_command(handles[0], math_2d_util::fvec2d(1.0f, 0.0f)));
+				assert(!world->queue_long_range_transfer(handles[0], math_2d_util::fvec2d(100.5f, 100.5f)));
+				assert(!world->try_queue_item_to_remove(physics_main_type::handle_type::get_invalid_index()));
+
+				world->update_physics();
+
+				std::array<physics_main_type::handle_type, 4> found;
+
+				assert(world->query_aabb(math_2d_util::frect(60.0f, 60.0f, 61.0f, 61.0f), found) == 2);
+
+				for (uint32 i = 1; i < handles.size(); ++i)
+				{
+					assert(world->is_handle_live(handles[i]));
+					assert(world->get_position(handles[i]) == math_2d_util::fvec2d(60.2f + (i * 0.3f), 60.5f));
+					assert(world->query_circle(world->get_position(handles[i]), 0.01f, found) == 1 && found[0] == handles[i]);
+				}
+
+				//the freed index is only handed out once
+				std::array<physics_main_type::handle_type, 2> new_handles;
+
+				for (auto& new_handle : new_handles)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(90.5f, 90.5f);
+					collider_to_add.velocity = math_2d_util::fvec2d(0.0f);
+					collider_to_add.radius = 0.1f;
+
+					new_handle = world->try_queue_item_to_add(std::move(collider_to_add));
+				}
+
+				assert(new_handles[0].get_index() != new_handles[1].get_index());
+
+				for (auto new_handle : new_handles)
+				{
+					assert(new_handle.get_index() != handles[1].get_index() && new_handle.get_index() != handles[2].get_index());
+				}
+
+				world->update_physics();
+			}
+
+			//a collider sitting still on its own should fall asleep and wake up again when it is given a velocity
+			{
+				physics_main_type::new_collider_data resting_collider;
+
+				resting_collider.position = math_2d_util::fvec2d(200.5f);
+				resting_collider.velocity = math_2d_util::fvec2d(0.0f);
+				resting_collider.radius = 0.5f;
+
+				auto resting_handle = paged_hirachical_list->try_queue_item_to_add(std::move(resting_collider));
+
+				paged_hirachical_list->set_sleep_step_count(5);
+
+				for (uint32 i = 0; i < 6; ++i)
+				{
+					paged_hirachical_list->update_physics();
+				}
+
+				assert(paged_hirachical_list->is_collider_sleeping(resting_handle));
+
+				//sleeping colliders should still be found by the region queries
+				{
+					std::array<physics_main_type::handle_type, 4> found_handles;
+
+					assert(paged_hirachical_list->query_circle(math_2d_util::fvec2d(201.5f, 200.5f), 0.75f, found_handles) == 1);
+					assert(found_handles[0].get_index() == resting_handle.get_index());
+
+					assert(paged_hirachical_list->query_aabb(math_2d_util::frect(199.0f, 199.0f, 200.2f, 200.2f), found_handles) == 1);
+
+					assert(paged_hirachical_list->query_circle(math_2d_util::fvec2d(100.0f, 100.0f), 2.0f, found_handles) == 0);
+
+					//it is the only collider out here so it should be the nearest one even from a few tiles away
+					assert(paged_hirachical_list->query_k_nearest(math_2d_util::fvec2d(205.0f, 197.0f), 2, found_handles) == 1);
+					assert(found_handles[0].get_index() == resting_handle.get_index());
+
+					assert(paged_hirachical_list->query_k_nearest(math_2d_util::fvec2d(205.0f, 197.0f), 2, found_handles, resting_handle) == 0);
+
+					//the batched form should give the same answers
+					std::array<physics_main_type::circle_query, 2> queries = { { { math_2d_util::fvec2d(201.5f, 200.5f), 0.75f }, { math_2d_util::fvec2d(100.0f, 100.0f), 2.0f } } };
+					std::array<uint32_t, 2> result_counts;
+
+					paged_hirachical_list->query_circles(queries, 2, std::span<physics_main_type::handle_type>(found_handles.data(), 4), result_counts);
+
+					assert(result_counts[0] == 1);
+					assert(result_counts[1] == 0);
+					assert(found_handles[0].get_index() == resting_handle.get_index());
+				}
+
+				//rays should hit it from the side and miss when they pass by
+				{
+					auto hit = paged_hirachical_list->raycast(math_2d_util::fvec2d(190.5f, 200.5f), math_2d_util::fvec2d(1.0f, 0.0f), 20.0f);
+
+					assert(hit.handle.get_index() == resting_handle.get_index());
+					assert(std::abs(hit.distance - 9.5f) < 0.001f);
+
+					auto miss = paged_hirachical_list->raycast(math_2d_util::fvec2d(190.5f, 190.0f), math_2d_util::fvec2d(0.0f, 1.0f), 20.0f);
+
+					assert(miss.handle.get_index() == physics_main_type::handle_type::get_invalid_index());
+
+					//a segment that stops short should miss and one with a radius should clip the edge
+					std::array<physics_main_type::segment_query, 3> segments = { {
+						{ math_2d_util::fvec2d(190.5f, 200.5f), math_2d_util::fvec2d(199.0f, 200.5f) },
+						{ math_2d_util::fvec2d(190.5f, 201.2f), math_2d_util::fvec2d(210.5f, 201.2f), 0.5f },
+						{ math_2d_util::fvec2d(200.5f, 200.5f), math_2d_util::fvec2d(210.5f, 200.5f), 0.0f, resting_handle } } };
+
+					std::array<physics_main_type::raycast_hit, 3> hits;
+
+					paged_hirachical_list->segment_casts(segments, hits);
+
+					assert(hits[0].handle.get_index() == physics_main_type::handle_type::get_invalid_index());
+					assert(hits[1].handle.get_index() == resting_handle.get_index());
+					assert(hits[2].handle.get_index() == physics_main_type::handle_type::get_invalid_index());
+				}
+
+				paged_hirachical_list->set_velocity(resting_handle, math_2d_util::fvec2d(10.0f, 0.0f));
+
+				assert(!paged_hirachical_list->is_collider_sleeping(resting_handle));
+
+				paged_hirachical_list->update_physics();
+
+				assert(!paged_hirachical_list->is_collider_sleeping(resting_handle));
+
+				//remove it again, the handle should be free to use once the update has run
+				assert(paged_hirachical_list->try_queue_item_to_remove(resting_handle));
+				assert(!paged_hirachical_list->try_queue_item_to_remove(resting_handle));
+
+				paged_hirachical_list->update_physics();
+
+				physics_main_type::new_collider_data replacement_collider;
+
+				replacement_collider.position = math_2d_util::fvec2d(200.5f);
+				replacement_collider.velocity = math_2d_util::fvec2d(0.0f);
+				replacement_collider.radius = 0.5f;
+
+				auto replacement_handle = paged_hirachical_list->try_queue_item_to_add(std::move(replacement_collider));
+
+				assert(replacement_handle.get_index() == resting_handle.get_index());
+
+				paged_hirachical_list->update_physics();
+
+				//let it fall asleep then wake it with a queued velocity
+				for (uint32 i = 0; i < 6; ++i)
+				{
+					paged_hirachical_list->update_physics();
+				}
+
+				assert(paged_hirachical_list->is_collider_sleeping(replacement_handle));
+
+				assert(paged_hirachical_list->queue_velocity_command(replacement_handle, math_2d_util::fvec2d(0.0f, 10.0f)));
+				assert(paged_hirachical_list->queue_force_command(replacement_handle, math_2d_util::fvec2d(60.0f, 0.0f)));
+
+				paged_hirachical_list->update_physics();
+
+				assert(!paged_hirachical_list->is_collider_sleeping(replacement_handle));
+			}
+
+			//the fixed point policy has to give exactly the same answer no matter how the work is split across threads
+			{
+				using fixed_physics_main_type = phyisics_2d_main<std::numeric_limits<uint16>::max() - 1, 16, fixed_point_numeric_policy<>>;
+
+				using fixed_scalar_type = fixed_physics_main_type::scalar_type;
+
+				constexpr uint32 collider_count = 2000;
+
+				auto run_fixed_point_world = [&](uint32 worker_count)
+					{
+						std::unique_ptr<fixed_physics_main_type> fixed_world = std::make_unique<fixed_physics_main_type>();
+
+						fixed_world->set_worker_count(worker_count);
+
+						std::vector<fixed_physics_main_type::handle_type> handles;
+
+						//a packed crowd all heading at each other so there are plenty of pairs and sector changes
+						for (uint32 i = 0; i < collider_count; ++i)
+						{
+							fixed_physics_main_type::new_collider_data collider_to_add;
+
+							int32 column = static_cast<int32>(i % 50);
+							int32 row = static_cast<int32>(i / 50);
+
+							collider_to_add.position = fixed_physics_main_type::scalar_vec2d(fixed_scalar_type(100 + column) + fixed_scalar_type(0.5f), fixed_scalar_type(100 + row) + fixed_scalar_type(0.5f));
+							collider_to_add.velocity = fixed_physics_main_type::scalar_vec2d(fixed_scalar_type((column % 7) - 3) * fixed_scalar_type(10), fixed_scalar_type((row % 5) - 2) * fixed_scalar_type(10));
+							collider_to_add.radius = fixed_scalar_type(0.45f);
+
+							handles.push_back(fixed_world->try_queue_item_to_add(std::move(collider_to_add)));
+						}
+
+						for (uint32 i = 0; i < 30; ++i)
+						{
+							fixed_world->update_physics();
+						}
+
+						std::vector<math_2d_util::fvec2d> positions;
+
+						for (auto handle : handles)
+						{
+							positions.push_back(fixed_world->get_position(handle));
+						}
+
+						return positions;
+					};
+
+				//positions this small convert to float exactly so comparing the floats compares every bit
+				assert(run_fixed_point_world(1) == run_fixed_point_world(4));
+
+				//a single head on hit should still end up close to where the float simulation puts it
+				auto run_head_on = [&]<typename Tphysics_main_type>()
+					{
+						std::unique_ptr<Tphysics_main_type> world = std::make_unique<Tphysics_main_type>();
+
+						auto add = [&](float x, float velocity_x)
+							{
+								typename Tphysics_main_type::new_collider_data collider_to_add;
+
+								collider_to_add.position = typename Tphysics_main_type::scalar_vec2d(typename Tphysics_main_type::scalar_type(x), typename Tphysics_main_type::scalar_type(40.5f));
+								collider_to_add.velocity = typename Tphysics_main_type::scalar_vec2d(typename Tphysics_main_type::scalar_type(velocity_x), typename Tphysics_main_type::scalar_type(0.0f));
+								collider_to_add.radius = typename Tphysics_main_type::scalar_type(0.5f);
+
+								return world->try_queue_item_to_add(std::move(collider_to_add));
+							};
+
+						//started off the half tile so the quantised time step does not leave them touching right on a tile edge
+						auto left_handle = add(38.3f, 30.0f);
+
+						add(42.7f, -30.0f);
+
+						for (uint32 i = 0; i < 20; ++i)
+						{
+							world->update_physics();
+						}
+
+						return world->get_position(left_handle).x;
+					};
+
+				float float_x = run_head_on.template operator()<physics_main_type>();
+				float fixed_x = run_head_on.template operator()<fixed_physics_main_type>();
+
+				assert(std::abs(float_x - fixed_x) < 0.05f);
+			}
+
+			//a world loaded from a snapshot has to carry on exactly the same as the world that saved it
+			{
+				std::filesystem::path snapshot_path = std::filesystem::temp_directory_path() / "phyisics_2d_main_unit_test.snapshot";
+
+				std::unique_ptr<physics_main_type> saved_world = std::make_unique<physics_main_type>();
+
+				std::vector<physics_main_type::handle_type> handles;
+
+				for (uint32 i = 0; i < 1000; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					float column = static_cast<float>(i % 40);
+					float row = static_cast<float>(i / 40);
+
+					collider_to_add.position = math_2d_util::fvec2d(60.5f + (column * 1.5f), 60.5f + (row * 1.5f));
+					collider_to_add.velocity = math_2d_util::fvec2d((column - 20.0f) * 2.0f, (row - 12.0f) * 3.0f);
+					collider_to_add.radius = 0.5f;
+
+					handles.push_back(saved_world->try_queue_item_to_add(std::move(collider_to_add)));
+				}
+
+				for (uint32 i = 0; i < 10; ++i)
+				{
+					saved_world->update_physics();
+				}
+
+				//leave something queued so the queues get checked as well
+				assert(saved_world->queue_velocity_command(handles[0], math_2d_util::fvec2d(-20.0f, 0.0f)));
+
+				assert(saved_world->save_snapshot(snapshot_path));
+
+				std::unique_ptr<physics_main_type> loaded_world = std::make_unique<physics_main_type>();
+
+				assert(loaded_world->load_snapshot(snapshot_path));
+
+				for (uint32 i = 0; i < 10; ++i)
+				{
+					saved_world->update_physics();
+					loaded_world->update_physics();
+				}
+
+				for (auto handle : handles)
+				{
+					assert(saved_world->get_position(handle) == loaded_world->get_position(handle));
+				}
+
+				//a snapshot from a different physics type is rejected
+				using fixed_physics_main_type = phyisics_2d_main<std::numeric_limits<uint16>::max() - 1, 16, fixed_point_numeric_policy<>>;
+
+				std::unique_ptr<fixed_physics_main_type> fixed_world = std::make_unique<fixed_physics_main_type>();
+
+				assert(!fixed_world->load_snapshot(snapshot_path));
+
+				std::filesystem::remove(snapshot_path);
+
+				assert(!loaded_world->load_snapshot(snapshot_path));
+			}
+
+			//rolling back and stepping again has to give the same result as the first time through
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				std::vector<physics_main_type::handle_type> handles;
+
+				for (uint32 i = 0; i < 1000; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					float column = static_cast<float>(i % 40);
+					float row = static_cast<float>(i / 40);
+
+					collider_to_add.position = math_2d_util::fvec2d(60.5f + (column * 1.5f), 60.5f + (row * 1.5f));
+					collider_to_add.velocity = math_2d_util::fvec2d((column - 20.0f) * 2.0f, (row - 12.0f) * 3.0f);
+					collider_to_add.radius = 0.5f;
+
+					handles.push_back(world->try_queue_item_to_add(std::move(collider_to_add)));
+				}
+
+				std::unique_ptr<physics_rollback_buffer<physics_main_type, 8>> rollback_buffer = std::make_unique<physics_rollback_buffer<physics_main_type, 8>>(*world);
+
+				auto get_positions = [&]()
+					{
+						std::vector<math_2d_util::fvec2d> positions;
+
+						for (auto handle : handles)
+						{
+							positions.push_back(world->get_position(handle));
+						}
+
+						return positions;
+					};
+
+				for (uint32 i = 0; i < 3; ++i)
+				{
+					world->update_physics();
+					rollback_buffer->record_frame();
+				}
+
+				auto positions_at_rollback_frame = get_positions();
+
+				for (uint32 i = 0; i < 4; ++i)
+				{
+					world->update_physics();
+					rollback_buffer->record_frame();
+				}
+
+				auto positions_before_rollback = get_positions();
+
+				assert(rollback_buffer->get_recorded_frame_count() == 7);
+				assert(!rollback_buffer->rollback(8));
+
+				assert(rollback_buffer->rollback(4));
+				assert(rollback_buffer->get_recorded_frame_count() == 3);
+				assert(get_positions() == positions_at_rollback_frame);
+
+				for (uint32 i = 0; i < 4; ++i)
+				{
+					world->update_physics();
+					rollback_buffer->record_frame();
+				}
+
+				assert(get_positions() == positions_before_rollback);
+
+				//the ring only holds the last 8 frames
+				std::vector<math_2d_util::fvec2d> positions_8_frames_back;
+
+				for (uint32 i = 0; i < 10; ++i)
+				{
+					world->update_physics();
+					rollback_buffer->record_frame();
+
+					if (i == 1)
+					{
+						positions_8_frames_back = get_positions();
+					}
+				}
+
+				auto positions_after_ring_wrap = get_positions();
+
+				assert(rollback_buffer->get_recorded_frame_count() == 8);
+				assert(rollback_buffer->rollback(8));
+				assert(get_positions() == positions_8_frames_back);
+
+				for (uint32 i = 0; i < 8; ++i)
+				{
+					world->update_physics();
+					rollback_buffer->record_frame();
+				}
+
+				assert(get_positions() == positions_after_ring_wrap);
+			}
+
+			//long range transfers keep the handle and velocity and can land anywhere in the world
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				std::vector<physics_main_type::handle_type> handles;
+
+				for (uint32 i = 0; i < 64; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(8.5f + static_cast<float>(i % 8), 8.5f + static_cast<float>(i / 8));
+					collider_to_add.velocity = math_2d_util::fvec2d(0.0f);
+					collider_to_add.radius = 0.4f;
+
+					handles.push_back(world->try_queue_item_to_add(std::move(collider_to_add)));
+				}
+
+				world->update_physics();
+
+				//send every other collider to the far corner and queue one of them for removal as well
+				for (uint32 i = 0; i < handles.size(); i += 2)
+				{
+					assert(world->queue_long_range_transfer(handles[i], physics_main_type::scalar_vec2d(200.5f + static_cast<float>(i % 8), 230.5f + static_cast<float>(i / 8))));
+				}
+
+				assert(!world->queue_long_range_transfer(handles[0], physics_main_type::scalar_vec2d(100.0f, 100.0f)));
+
+				assert(world->try_queue_item_to_remove(handles[2]));
+
+				world->update_physics();
+
+				for (uint32 i = 0; i < handles.size(); i += 2)
+				{
+					if (i == 2)
+					{
+						continue;
+					}
+
+					math_2d_util::fvec2d position = world->get_position(handles[i]);
+
+					assert(position == math_2d_util::fvec2d(200.5f + static_cast<float>(i % 8), 230.5f + static_cast<float>(i / 8)));
+
+					std::array<physics_main_type::handle_type, 4> found;
+
+					assert(world->query_circle(position, 0.1f, found) == 1 && found[0] == handles[i]);
+				}
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					assert(world->get_last_step_stats().long_range_transfers == 31);
+				}
+			}
+
+			//fast colliders split into sub steps still end up where a single step would put them
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				world->set_max_sub_steps(8);
+				world->set_sub_step_max_move(0.5f);
+
+				physics_main_type::new_collider_data collider_to_add;
+
+				//just short of a sector edge so the first step crosses it part way through
+				collider_to_add.position = math_2d_util::fvec2d(14.5f, 100.5f);
+				collider_to_add.velocity = math_2d_util::fvec2d(170.0f, -20.0f);
+				collider_to_add.radius = 0.5f;
+
+				auto fast_handle = world->try_queue_item_to_add(std::move(collider_to_add));
+
+				world->update_physics();
+
+				math_2d_util::fvec2d position = world->get_position(fast_handle);
+
+				assert(std::abs(position.x - (14.5f + (170.0f / 60.0f))) < 0.001f);
+				assert(std::abs(position.y - (100.5f - (20.0f / 60.0f))) < 0.001f);
+
+				//170 tiles a second is just under 3 tiles a step so it takes 6 half tile sub steps
+				if constexpr (is_physics_stats_enabled)
+				{
+					assert(world->get_last_step_stats().integration_passes == 6);
+				}
+
+				//bouncing off the world edges in sub steps keeps it inside the world
+				for (uint32 i = 0; i < 200; ++i)
+				{
+					world->update_physics();
+
+					position = world->get_position(fast_handle);
+
+					assert(position.x > 0.0f && position.x < static_cast<float>(physics_main_type::grid_dimension_type::tile_w));
+					assert(position.y > 0.0f && position.y < static_cast<float>(physics_main_type::grid_dimension_type::tile_w));
+				}
+			}
+
+			//the solver only caps the speed it adds so a collider the game set moving faster than that keeps its speed
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				world->set_max_sub_steps(16);
+				world->set_sub_step_max_move(0.5f);
+
+				physics_main_type::new_collider_data collider_to_add;
+
+				collider_to_add.position = math_2d_util::fvec2d(20.5f, 50.5f);
+				collider_to_add.velocity = math_2d_util::fvec2d(300.0f, 0.0f);
+				collider_to_add.radius = 0.5f;
+
+				auto fast_handle = world->try_queue_item_to_add(std::move(collider_to_add));
+
+				//5 tiles a step is over the 3 tiles a step the solver is allowed to push things
+				for (uint32 i = 0; i < 4; ++i)
+				{
+					world->update_physics();
+				}
+
+				math_2d_util::fvec2d position = world->get_position(fast_handle);
+
+				assert(std::abs(position.x - (20.5f + (4.0f * 300.0f / 60.0f))) < 0.001f);
+				assert(position.y == 50.5f);
+			}
+
+			//more colliders crossing one sector edge than the transfer buffer holds spill over and still all arrive
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				//3 columns down the whole height of the first sector all moving right together
+				std::vector<std::pair<physics_main_type::handle_type, math_2d_util::fvec2d>> handles;
+
+				for (uint32 i = 0; i < 48; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(14.7f + (0.5f * static_cast<float>(i % 3)), 0.5f + static_cast<float>(i / 3));
+					collider_to_add.velocity = math_2d_util::fvec2d(90.0f, 0.0f);
+					collider_to_add.radius = 0.2f;
+
+					math_2d_util::fvec2d start_position = collider_to_add.position;
+
+					handles.emplace_back(world->try_queue_item_to_add(std::move(collider_to_add)), start_position);
+				}
+
+				world->update_physics();
+
+				for (const auto& [handle, start_position] : handles)
+				{
+					math_2d_util::fvec2d position = world->get_position(handle);
+
+					assert(position.x > 16.0f && std::abs(position.x - (start_position.x + 1.5f)) < 0.001f);
+					assert(position.y == start_position.y);
+
+					std::array<physics_main_type::handle_type, 4> found;
+
+					assert(world->query_circle(position, 0.1f, found) == 1 && found[0] == handle);
+				}
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					const physics_stats& stats = world->get_last_step_stats();
+
+					assert(stats.sector_transfers_per_direction[static_cast<uint32>(MiscUtilities::grid_directions::RIGHT)] == 48);
+					assert(stats.transfer_spills == 48 - (physics_main_type::grid_dimension_type::sector_w * 2));
+				}
+			}
+
+			//a tile packed with more than 64 colliders crossing a sector edge together spills and lands in one tile
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				//a 9 x 9 grid inside the last tile of the first sector, spaced so none of them touch
+				std::vector<std::pair<physics_main_type::handle_type, math_2d_util::fvec2d>> handles;
+
+				for (uint32 i = 0; i < 81; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(15.1f + (0.1f * static_cast<float>(i % 9)), 5.1f + (0.1f * static_cast<float>(i / 9)));
+					collider_to_add.velocity = math_2d_util::fvec2d(60.0f, 0.0f);
+					collider_to_add.radius = 0.04f;
+
+					math_2d_util::fvec2d start_position = collider_to_add.position;
+
+					handles.emplace_back(world->try_queue_item_to_add(std::move(collider_to_add)), start_position);
+				}
+
+				world->update_physics();
+
+				for (const auto& [handle, start_position] : handles)
+				{
+					math_2d_util::fvec2d position = world->get_position(handle);
+
+					assert(static_cast<uint32>(position.x) == 16 && std::abs(position.x - (start_position.x + 1.0f)) < 0.001f);
+					assert(position.y == start_position.y);
+
+					std::array<physics_main_type::handle_type, 4> found;
+
+					assert(world->query_circle(position, 0.01f, found) == 1 && found[0] == handle);
+				}
+
+				//every one of them is still found by a query over the whole tile
+				std::array<physics_main_type::handle_type, 128> found_in_tile;
+
+				assert(world->query_aabb(math_2d_util::frect(16.0f, 5.0f, 17.0f, 6.0f), found_in_tile) == 81);
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					const physics_stats& stats = world->get_last_step_stats();
+
+					assert(stats.sector_transfers_per_direction[static_cast<uint32>(MiscUtilities::grid_directions::RIGHT)] == 81);
+					assert(stats.transfer_spills == 81 - (physics_main_type::grid_dimension_type::sector_w * 2));
+				}
+			}
+
+			//a slow collider only has its tile bounds worked out again when its swept bounds reach a new tile
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				world->set_sleep_step_count(0);
+
+				physics_main_type::new_collider_data collider_to_add;
+
+				collider_to_add.position = math_2d_util::fvec2d(40.5f, 40.5f);
+				collider_to_add.velocity = math_2d_util::fvec2d(0.6f, 0.0f);
+				collider_to_add.radius = 0.25f;
+
+				physics_main_type::handle_type handle = world->try_queue_item_to_add(std::move(collider_to_add));
+
+				world->update_physics();
+
+				//moving 0.01 a step stays inside the same whole tiles for a while
+				for (uint32 i = 0; i < 10; ++i)
+				{
+					world->update_physics();
+
+					if constexpr (is_physics_stats_enabled)
+					{
+						assert(world->get_last_step_stats().tile_bounds_updates == 0);
+					}
+				}
+
+				//by now its edge has pushed into the next tile over so the bounds must have followed it
+				for (uint32 i = 0; i < 20; ++i)
+				{
+					world->update_physics();
+				}
+
+				math_2d_util::fvec2d position = world->get_position(handle);
+
+				assert(position.x + 0.25f > 41.0f);
+
+				std::array<physics_main_type::handle_type, 4> found;
+
+				assert(world->query_circle(math_2d_util::fvec2d(41.02f, 40.5f), 0.01f, found) == 1 && found[0] == handle);
+			}
+
+			//a tile where everything has fallen asleep is not walked again until something in it wakes up
+			{
+				std::unique_ptr<physics_main_type> world = std::make_unique<physics_main_type>();
+
+				world->set_sleep_step_count(3);
+
+				std::vector<physics_main_type::handle_type> handles;
+
+				for (uint32 i = 0; i < 9; ++i)
+				{
+					physics_main_type::new_collider_data collider_to_add;
+
+					collider_to_add.position = math_2d_util::fvec2d(80.2f + ((i % 3) * 0.3f), 80.2f + ((i / 3) * 0.3f));
+					collider_to_add.velocity = math_2d_util::fvec2d(0.0f);
+					collider_to_add.radius = 0.05f;
+
+					handles.push_back(world->try_queue_item_to_add(std::move(collider_to_add)));
+				}
+
+				for (uint32 i = 0; i < 5; ++i)
+				{
+					world->update_physics();
+				}
+
+				for (auto handle : handles)
+				{
+					assert(world->is_collider_sleeping(handle));
+				}
+
+				for (uint32 i = 0; i < 5; ++i)
+				{
+					world->update_physics();
+
+					if constexpr (is_physics_stats_enabled)
+					{
+						assert(world->get_last_step_stats().tile_bounds_walks == 0);
+					}
+				}
+
+				//waking one up and moving it far enough to reach the next tile gets the tile walked again
+				world->set_velocity(handles[8], math_2d_util::fvec2d(20.0f, 0.0f));
+
+				world->update_physics();
+
+				if constexpr (is_physics_stats_enabled)
+				{
+					assert(world->get_last_step_stats().tile_bounds_walks >= 1);
+					assert(world->get_last_step_stats().tile_bounds_updates >= 1);
+				}
+
+				std::array<physics_main_type::handle_type, 4> found;
+
+				assert(world->query_circle(world->get_position(handles[8]), 0.01f, found) == 1 && found[0] == handles[8]);
+			}
+
 		}
 	};
 };
@@ -0,0 +1,108 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <assert.h>
+
+#include "continuous_collision_library/swept_circle_time_of_impact.h"
+
+namespace ContinuousCollisionLibrary
+{
+	static class swept_circle_time_of_impact_unit_test
+	{
+	public:
+		static void run_test()
+		{
+			//head on hit, gap of 9 closing 10 per step
+			assert(std::abs(swept_circle_time_of_impact::calculate(10.0f, 0.0f, -10.0f, 0.0f, 1.0f) - 0.9f) < 0.0001f);
+
+			//moving apart
+			assert(swept_circle_time_of_impact::calculate(10.0f, 0.0f, 10.0f, 0.0f, 1.0f) == swept_circle_time_of_impact::no_impact);
+
+			//passing by
+			assert(swept_circle_time_of_impact::calculate(10.0f, 5.0f, -20.0f, 0.0f, 1.0f) == swept_circle_time_of_impact::no_impact);
+
+			//already overlapping and closing
+			assert(swept_circle_time_of_impact::calculate(0.5f, 0.0f, -1.0f, 0.0f, 1.0f) == 0.0f);
+
+			//check the batched version matches the single version, use an odd count so the tail gets tested
+			{
+				constexpr uint32 collider_count = 16;
+				constexpr uint32 pair_count = 13;
+				constexpr float time_step = 1.0f / 60.0f;
+
+				std::array<float, collider_count> x;
+				std::array<float, collider_count> y;
+				std::array<float, collider_count> velocity_x;
+				std::array<float, collider_count> velocity_y;
+				std::array<float, collider_count> radius;
+
+				for (uint32 i = 0; i < collider_count; ++i)
+				{
+					x[i] = static_cast<float>(rand() % 10);
+					y[i] = static_cast<float>(rand() % 10);
+					velocity_x[i] = static_cast<float>((rand() % 400) - 200);
+					velocity_y[i] = static_cast<float>((rand() % 400) - 200);
+					radius[i] = 0.5f;
+				}
+
+				std::array<uint32, pair_count> index_a;
+				std::array<uint32, pair_count> index_b;
+				std::array<float, pair_count> time_of_impact;
+
+				for (uint32 i = 0; i < pair_count; ++i)
+				{
+					index_a[i] = i;
+					index_b[i] = collider_count - 1 - i;
+				}
+
+				swept_circle_time_of_impact::calculate_for_pairs(x, y, velocity_x, velocity_y, radius, index_a, index_b, time_step, time_of_impact);
+
+				for (uint32 i = 0; i < pair_count; ++i)
+				{
+					uint32 a = index_a[i];
+					uint32 b = index_b[i];
+
+					float expected = swept_circle_time_of_impact::calculate(x[b] - x[a], y[b] - y[a], (velocity_x[b] - velocity_x[a]) * time_step, (velocity_y[b] - velocity_y[a]) * time_step, radius[a] + radius[b]);
+
+					assert(std::abs(expected - time_of_impact[i]) < 0.0001f);
+				}
+
+				//the fixed point batch has to match the single version bit for bit
+				using fixed_type = fixed_point<16>;
+
+				const fixed_type fixed_time_step = fixed_type(time_step);
+
+				std::array<fixed_type, collider_count> fixed_x;
+				std::array<fixed_type, collider_count> fixed_y;
+				std::array<fixed_type, collider_count> fixed_velocity_x;
+				std::array<fixed_type, collider_count> fixed_velocity_y;
+				std::array<fixed_type, collider_count> fixed_radius;
+
+				for (uint32 i = 0; i < collider_count; ++i)
+				{
+					fixed_x[i] = fixed_type(x[i]);
+					fixed_y[i] = fixed_type(y[i]);
+					fixed_velocity_x[i] = fixed_type(velocity_x[i]);
+					fixed_velocity_y[i] = fixed_type(velocity_y[i]);
+					fixed_radius[i] = fixed_type(radius[i]);
+				}
+
+				std::array<fixed_type, pair_count> fixed_time_of_impact;
+
+				swept_circle_time_of_impact::calculate_for_pairs(std::span<const fixed_type>(fixed_x), std::span<const fixed_type>(fixed_y), std::span<const fixed_type>(fixed_velocity_x), std::span<const fixed_type>(fixed_velocity_y),
+					std::span<const fixed_type>(fixed_radius), index_a, index_b, fixed_time_step, std::span<fixed_type>(fixed_time_of_impact));
+
+				for (uint32 i = 0; i < pair_count; ++i)
+				{
+					uint32 a = index_a[i];
+					uint32 b = index_b[i];
+
+					fixed_type expected = swept_circle_time_of_impact::calculate(fixed_x[b] - fixed_x[a], fixed_y[b] - fixed_y[a], (fixed_velocity_x[b] - fixed_velocity_x[a]) * fixed_time_step, (fixed_velocity_y[b] - fixed_velocity_y[a]) * fixed_time_step, fixed_radius[a] + fixed_radius[b]);
+
+					assert(expected == fixed_time_of_impact[i]);
+				}
+			}
+		}
+	};
+};
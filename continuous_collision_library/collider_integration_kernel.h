@@ -0,0 +1,456 @@
+#pragma once
+#include <span>
+#include <array>
+#include <bit>
+#include <assert.h>
+#include <type_traits>
+
+#include "base_types_definition.h"
+#include "continuous_collision_library/physics_numeric_policy.h"
+#include "continuous_collision_library/fixed_point_simd.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+//moves a run of colliders that sit next to each other in the collider arrays in one pass
+//bounces off the world edges, moves and finds the colliders that changed tile so only those get looked at afterwards
+
+namespace ContinuousCollisionLibrary
+{
+	struct collider_integration_kernel
+	{
+		//number of colliders moved at once, avx2 needs /arch:AVX2 otherwise we fall back to sse2 then scalar
+#if defined(__AVX2__)
+		static constexpr uint32 simd_width = 8;
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		static constexpr uint32 simd_width = 4;
+#else
+		static constexpr uint32 simd_width = 1;
+#endif
+
+		//velocities that would take a collider over the world edge this sub step are flipped, then it moves velocity * time_step * move_fraction
+		//colliders with a move fraction of 0 are left where they are
+		//the tile each collider started in goes into old_tile_x / old_tile_y and the indexes of the ones that ended up in another tile are packed into changed_out
+		//changed_out needs simd_width entries of room past the number of colliders, returns the number of colliders that changed tile
+		static uint32 integrate(
+			std::span<float> x,
+			std::span<float> y,
+			std::span<float> velocity_x,
+			std::span<float> velocity_y,
+			std::span<const float> radius,
+			std::span<const float> move_fraction,
+			std::span<const float> sub_step_fraction,
+			float time_step,
+			float world_edge,
+			std::span<uint32> old_tile_x,
+			std::span<uint32> old_tile_y,
+			std::span<uint32> changed_out);
+
+		//fixed point version for the deterministic numeric policy, the fraction bits are picked up from the time step
+		//the simd paths do the same integer maths as the scalar one so the results are bit identical whichever one runs
+		template<uint32 Ifraction_bits>
+		static uint32 integrate(
+			std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> x,
+			std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> y,
+			std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> velocity_x,
+			std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> velocity_y,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> radius,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> move_fraction,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> sub_step_fraction,
+			fixed_point<Ifraction_bits> time_step,
+			std::type_identity_t<fixed_point<Ifraction_bits>> world_edge,
+			std::span<uint32> old_tile_x,
+			std::span<uint32> old_tile_y,
+			std::span<uint32> changed_out);
+
+	private:
+
+		//one collider, returns true if it changed tile
+		template<typename Tscalar>
+		static bool integrate_collider(Tscalar& x, Tscalar& y, Tscalar& velocity_x, Tscalar& velocity_y, Tscalar radius, Tscalar move_fraction, Tscalar sub_step_fraction, Tscalar time_step, Tscalar world_edge, uint32& old_tile_x, uint32& old_tile_y);
+
+#if defined(__AVX2__)
+		//for each 8 bit lane mask the lanes that are set packed down to the bottom, one byte per lane index
+		static constexpr std::array<uint64, 256> left_pack_lanes = []()
+			{
+				std::array<uint64, 256> lanes = {};
+
+				for (uint32 mask = 0; mask < 256; ++mask)
+				{
+					uint32 write_index = 0;
+
+					for (uint32 lane = 0; lane < 8; ++lane)
+					{
+						if (mask & (1u << lane))
+						{
+							lanes[mask] |= static_cast<uint64>(lane) << (write_index++ * 8);
+						}
+					}
+				}
+
+				return lanes;
+			}();
+#endif
+	};
+
+	template<typename Tscalar>
+	inline bool collider_integration_kernel::integrate_collider(Tscalar& x, Tscalar& y, Tscalar& velocity_x, Tscalar& velocity_y, Tscalar radius, Tscalar move_fraction, Tscalar sub_step_fraction, Tscalar time_step, Tscalar world_edge, uint32& old_tile_x, uint32& old_tile_y)
+	{
+		const Tscalar zero = Tscalar(0.0f);
+
+		bool is_moving = move_fraction != zero;
+
+		//flip the velocity on any axis where this sub step would take the collider off the map
+		Tscalar next_move_x = velocity_x * time_step * sub_step_fraction;
+		Tscalar next_move_y = velocity_y * time_step * sub_step_fraction;
+
+		bool will_take_off_map_x = (((x + radius) + next_move_x) > world_edge || ((x - radius) + next_move_x) < zero) && is_moving;
+		bool will_take_off_map_y = (((y + radius) + next_move_y) > world_edge || ((y - radius) + next_move_y) < zero) && is_moving;
+
+		velocity_x = will_take_off_map_x ? -velocity_x : velocity_x;
+		velocity_y = will_take_off_map_y ? -velocity_y : velocity_y;
+
+		//keep the tile from before the move, working it back out from the new position can round into the wrong tile
+		old_tile_x = static_cast<uint32>(x);
+		old_tile_y = static_cast<uint32>(y);
+
+		x += velocity_x * time_step * move_fraction;
+		y += velocity_y * time_step * move_fraction;
+
+		return (old_tile_x != static_cast<uint32>(x)) || (old_tile_y != static_cast<uint32>(y));
+	}
+
+	inline uint32 collider_integration_kernel::integrate(
+		std::span<float> x,
+		std::span<float> y,
+		std::span<float> velocity_x,
+		std::span<float> velocity_y,
+		std::span<const float> radius,
+		std::span<const float> move_fraction,
+		std::span<const float> sub_step_fraction,
+		float time_step,
+		float world_edge,
+		std::span<uint32> old_tile_x,
+		std::span<uint32> old_tile_y,
+		std::span<uint32> changed_out)
+	{
+		uint32 collider_count = static_cast<uint32>(x.size());
+
+		assert(y.size() == collider_count && velocity_x.size() == collider_count && velocity_y.size() == collider_count && radius.size() == collider_count);
+		assert(move_fraction.size() >= collider_count && sub_step_fraction.size() >= collider_count);
+		assert(old_tile_x.size() >= collider_count && old_tile_y.size() >= collider_count);
+		assert(changed_out.size() >= collider_count + simd_width);
+
+		uint32 index = 0;
+		uint32 changed_count = 0;
+
+#if defined(__AVX2__)
+		{
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+			const __m256 step = _mm256_set1_ps(time_step);
+			const __m256 edge = _mm256_set1_ps(world_edge);
+			const __m256i lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+			//flip the velocity where the next move takes the collider over either edge
+			auto bounce = [&](__m256 position, __m256 velocity, __m256 collider_radius, __m256 fraction, __m256 is_moving)
+				{
+					__m256 next_move = _mm256_mul_ps(_mm256_mul_ps(velocity, step), fraction);
+
+					__m256 is_over_max = _mm256_cmp_ps(_mm256_add_ps(_mm256_add_ps(position, collider_radius), next_move), edge, _CMP_GT_OQ);
+					__m256 is_under_min = _mm256_cmp_ps(_mm256_add_ps(_mm256_sub_ps(position, collider_radius), next_move), zero, _CMP_LT_OQ);
+
+					__m256 will_take_off_map = _mm256_and_ps(_mm256_or_ps(is_over_max, is_under_min), is_moving);
+
+					return _mm256_xor_ps(velocity, _mm256_and_ps(will_take_off_map, sign_bit));
+				};
+
+			for (; index + simd_width <= collider_count; index += simd_width)
+			{
+				__m256 position_x = _mm256_loadu_ps(x.data() + index);
+				__m256 position_y = _mm256_loadu_ps(y.data() + index);
+				__m256 collider_radius = _mm256_loadu_ps(radius.data() + index);
+				__m256 fraction = _mm256_loadu_ps(move_fraction.data() + index);
+				__m256 sub_fraction = _mm256_loadu_ps(sub_step_fraction.data() + index);
+
+				__m256 is_moving = _mm256_cmp_ps(fraction, zero, _CMP_NEQ_UQ);
+
+				__m256 new_velocity_x = bounce(position_x, _mm256_loadu_ps(velocity_x.data() + index), collider_radius, sub_fraction, is_moving);
+				__m256 new_velocity_y = bounce(position_y, _mm256_loadu_ps(velocity_y.data() + index), collider_radius, sub_fraction, is_moving);
+
+				_mm256_storeu_ps(velocity_x.data() + index, new_velocity_x);
+				_mm256_storeu_ps(velocity_y.data() + index, new_velocity_y);
+
+				//positions are never negative so truncating is the same as flooring
+				__m256i tile_x = _mm256_cvttps_epi32(position_x);
+				__m256i tile_y = _mm256_cvttps_epi32(position_y);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(old_tile_x.data() + index), tile_x);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(old_tile_y.data() + index), tile_y);
+
+				position_x = _mm256_add_ps(position_x, _mm256_mul_ps(_mm256_mul_ps(new_velocity_x, step), fraction));
+				position_y = _mm256_add_ps(position_y, _mm256_mul_ps(_mm256_mul_ps(new_velocity_y, step), fraction));
+
+				_mm256_storeu_ps(x.data() + index, position_x);
+				_mm256_storeu_ps(y.data() + index, position_y);
+
+				__m256i is_same_tile = _mm256_and_si256(_mm256_cmpeq_epi32(tile_x, _mm256_cvttps_epi32(position_x)), _mm256_cmpeq_epi32(tile_y, _mm256_cvttps_epi32(position_y)));
+
+				uint32 changed_mask = ~static_cast<uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(is_same_tile))) & 0xFF;
+
+				//left pack the indexes of the changed lanes, all 8 lanes are written but only the changed ones are kept
+				__m256i pack_order = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(left_pack_lanes[changed_mask])));
+
+				__m256i changed_index = _mm256_permutevar8x32_epi32(_mm256_add_epi32(_mm256_set1_epi32(static_cast<int32>(index)), lane_index), pack_order);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(changed_out.data() + changed_count), changed_index);
+
+				changed_count += std::popcount(changed_mask);
+			}
+		}
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 sign_bit = _mm_set1_ps(-0.0f);
+			const __m128 step = _mm_set1_ps(time_step);
+			const __m128 edge = _mm_set1_ps(world_edge);
+
+			auto bounce = [&](__m128 position, __m128 velocity, __m128 collider_radius, __m128 fraction, __m128 is_moving)
+				{
+					__m128 next_move = _mm_mul_ps(_mm_mul_ps(velocity, step), fraction);
+
+					__m128 is_over_max = _mm_cmpgt_ps(_mm_add_ps(_mm_add_ps(position, collider_radius), next_move), edge);
+					__m128 is_under_min = _mm_cmplt_ps(_mm_add_ps(_mm_sub_ps(position, collider_radius), next_move), zero);
+
+					__m128 will_take_off_map = _mm_and_ps(_mm_or_ps(is_over_max, is_under_min), is_moving);
+
+					return _mm_xor_ps(velocity, _mm_and_ps(will_take_off_map, sign_bit));
+				};
+
+			for (; index + simd_width <= collider_count; index += simd_width)
+			{
+				__m128 position_x = _mm_loadu_ps(x.data() + index);
+				__m128 position_y = _mm_loadu_ps(y.data() + index);
+				__m128 collider_radius = _mm_loadu_ps(radius.data() + index);
+				__m128 fraction = _mm_loadu_ps(move_fraction.data() + index);
+				__m128 sub_fraction = _mm_loadu_ps(sub_step_fraction.data() + index);
+
+				__m128 is_moving = _mm_cmpneq_ps(fraction, zero);
+
+				__m128 new_velocity_x = bounce(position_x, _mm_loadu_ps(velocity_x.data() + index), collider_radius, sub_fraction, is_moving);
+				__m128 new_velocity_y = bounce(position_y, _mm_loadu_ps(velocity_y.data() + index), collider_radius, sub_fraction, is_moving);
+
+				_mm_storeu_ps(velocity_x.data() + index, new_velocity_x);
+				_mm_storeu_ps(velocity_y.data() + index, new_velocity_y);
+
+				__m128i tile_x = _mm_cvttps_epi32(position_x);
+				__m128i tile_y = _mm_cvttps_epi32(position_y);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(old_tile_x.data() + index), tile_x);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(old_tile_y.data() + index), tile_y);
+
+				position_x = _mm_add_ps(position_x, _mm_mul_ps(_mm_mul_ps(new_velocity_x, step), fraction));
+				position_y = _mm_add_ps(position_y, _mm_mul_ps(_mm_mul_ps(new_velocity_y, step), fraction));
+
+				_mm_storeu_ps(x.data() + index, position_x);
+				_mm_storeu_ps(y.data() + index, position_y);
+
+				__m128i is_same_tile = _mm_and_si128(_mm_cmpeq_epi32(tile_x, _mm_cvttps_epi32(position_x)), _mm_cmpeq_epi32(tile_y, _mm_cvttps_epi32(position_y)));
+
+				uint32 changed_mask = ~static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(is_same_tile))) & 0xF;
+
+				//sse2 has no lane permute so walk the set bits instead, most of the time there are none
+				for (; changed_mask != 0; changed_mask &= changed_mask - 1)
+				{
+					changed_out[changed_count++] = index + std::countr_zero(changed_mask);
+				}
+			}
+		}
+#endif
+
+		//finish off the colliders that did not fill a whole register
+		for (; index < collider_count; ++index)
+		{
+			bool changed_tile = integrate_collider<float>(x[index], y[index], velocity_x[index], velocity_y[index], radius[index], move_fraction[index], sub_step_fraction[index], time_step, world_edge, old_tile_x[index], old_tile_y[index]);
+
+			changed_out[changed_count] = index;
+
+			changed_count += changed_tile;
+		}
+
+		return changed_count;
+	}
+
+	template<uint32 Ifraction_bits>
+	inline uint32 collider_integration_kernel::integrate(
+		std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> x,
+		std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> y,
+		std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> velocity_x,
+		std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> velocity_y,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> radius,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> move_fraction,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> sub_step_fraction,
+		fixed_point<Ifraction_bits> time_step,
+		std::type_identity_t<fixed_point<Ifraction_bits>> world_edge,
+		std::span<uint32> old_tile_x,
+		std::span<uint32> old_tile_y,
+		std::span<uint32> changed_out)
+	{
+		using fixed_type = fixed_point<Ifraction_bits>;
+
+		using lanes = fixed_point_simd<Ifraction_bits>;
+
+		uint32 collider_count = static_cast<uint32>(x.size());
+
+		assert(y.size() == collider_count && velocity_x.size() == collider_count && velocity_y.size() == collider_count && radius.size() == collider_count);
+		assert(move_fraction.size() >= collider_count && sub_step_fraction.size() >= collider_count);
+		assert(old_tile_x.size() >= collider_count && old_tile_y.size() >= collider_count);
+		assert(changed_out.size() >= collider_count + simd_width);
+
+		//fixed point values are a single int32 so the arrays can be loaded as packed ints
+		static_assert(sizeof(fixed_type) == sizeof(int32));
+
+		uint32 index = 0;
+		uint32 changed_count = 0;
+
+#if defined(__AVX2__)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i step = _mm256_set1_epi32(time_step.raw);
+			const __m256i edge = _mm256_set1_epi32(world_edge.raw);
+			const __m256i lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+			auto load = [](auto span, uint32 offset) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(span.data() + offset)); };
+
+			//flip the velocity where the next move takes the collider over either edge
+			auto bounce = [&](__m256i position, __m256i velocity, __m256i collider_radius, __m256i fraction, __m256i is_moving)
+				{
+					__m256i next_move = lanes::multiply(lanes::multiply(velocity, step), fraction);
+
+					__m256i is_over_max = _mm256_cmpgt_epi32(_mm256_add_epi32(_mm256_add_epi32(position, collider_radius), next_move), edge);
+					__m256i is_under_min = _mm256_cmpgt_epi32(zero, _mm256_add_epi32(_mm256_sub_epi32(position, collider_radius), next_move));
+
+					__m256i will_take_off_map = _mm256_and_si256(_mm256_or_si256(is_over_max, is_under_min), is_moving);
+
+					//two's complement negate of the lanes that bounce
+					return _mm256_sub_epi32(_mm256_xor_si256(velocity, will_take_off_map), will_take_off_map);
+				};
+
+			for (; index + simd_width <= collider_count; index += simd_width)
+			{
+				__m256i position_x = load(x, index);
+				__m256i position_y = load(y, index);
+				__m256i collider_radius = load(radius, index);
+				__m256i fraction = load(move_fraction, index);
+				__m256i sub_fraction = load(sub_step_fraction, index);
+
+				__m256i is_moving = _mm256_xor_si256(_mm256_cmpeq_epi32(fraction, zero), _mm256_set1_epi32(-1));
+
+				__m256i new_velocity_x = bounce(position_x, load(velocity_x, index), collider_radius, sub_fraction, is_moving);
+				__m256i new_velocity_y = bounce(position_y, load(velocity_y, index), collider_radius, sub_fraction, is_moving);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(velocity_x.data() + index), new_velocity_x);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(velocity_y.data() + index), new_velocity_y);
+
+				__m256i tile_x = lanes::truncate(position_x);
+				__m256i tile_y = lanes::truncate(position_y);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(old_tile_x.data() + index), tile_x);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(old_tile_y.data() + index), tile_y);
+
+				position_x = _mm256_add_epi32(position_x, lanes::multiply(lanes::multiply(new_velocity_x, step), fraction));
+				position_y = _mm256_add_epi32(position_y, lanes::multiply(lanes::multiply(new_velocity_y, step), fraction));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(x.data() + index), position_x);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(y.data() + index), position_y);
+
+				__m256i is_same_tile = _mm256_and_si256(_mm256_cmpeq_epi32(tile_x, lanes::truncate(position_x)), _mm256_cmpeq_epi32(tile_y, lanes::truncate(position_y)));
+
+				uint32 changed_mask = ~static_cast<uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(is_same_tile))) & 0xFF;
+
+				//left pack the indexes of the changed lanes the same as the float version
+				__m256i pack_order = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(left_pack_lanes[changed_mask])));
+
+				__m256i changed_index = _mm256_permutevar8x32_epi32(_mm256_add_epi32(_mm256_set1_epi32(static_cast<int32>(index)), lane_index), pack_order);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(changed_out.data() + changed_count), changed_index);
+
+				changed_count += std::popcount(changed_mask);
+			}
+		}
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i step = _mm_set1_epi32(time_step.raw);
+			const __m128i edge = _mm_set1_epi32(world_edge.raw);
+
+			auto load = [](auto span, uint32 offset) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(span.data() + offset)); };
+
+			auto bounce = [&](__m128i position, __m128i velocity, __m128i collider_radius, __m128i fraction, __m128i is_moving)
+				{
+					__m128i next_move = lanes::multiply(lanes::multiply(velocity, step), fraction);
+
+					__m128i is_over_max = _mm_cmpgt_epi32(_mm_add_epi32(_mm_add_epi32(position, collider_radius), next_move), edge);
+					__m128i is_under_min = _mm_cmplt_epi32(_mm_add_epi32(_mm_sub_epi32(position, collider_radius), next_move), zero);
+
+					__m128i will_take_off_map = _mm_and_si128(_mm_or_si128(is_over_max, is_under_min), is_moving);
+
+					return _mm_sub_epi32(_mm_xor_si128(velocity, will_take_off_map), will_take_off_map);
+				};
+
+			for (; index + simd_width <= collider_count; index += simd_width)
+			{
+				__m128i position_x = load(x, index);
+				__m128i position_y = load(y, index);
+				__m128i collider_radius = load(radius, index);
+				__m128i fraction = load(move_fraction, index);
+				__m128i sub_fraction = load(sub_step_fraction, index);
+
+				__m128i is_moving = _mm_xor_si128(_mm_cmpeq_epi32(fraction, zero), _mm_set1_epi32(-1));
+
+				__m128i new_velocity_x = bounce(position_x, load(velocity_x, index), collider_radius, sub_fraction, is_moving);
+				__m128i new_velocity_y = bounce(position_y, load(velocity_y, index), collider_radius, sub_fraction, is_moving);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(velocity_x.data() + index), new_velocity_x);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(velocity_y.data() + index), new_velocity_y);
+
+				__m128i tile_x = lanes::truncate(position_x);
+				__m128i tile_y = lanes::truncate(position_y);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(old_tile_x.data() + index), tile_x);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(old_tile_y.data() + index), tile_y);
+
+				position_x = _mm_add_epi32(position_x, lanes::multiply(lanes::multiply(new_velocity_x, step), fraction));
+				position_y = _mm_add_epi32(position_y, lanes::multiply(lanes::multiply(new_velocity_y, step), fraction));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(x.data() + index), position_x);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(y.data() + index), position_y);
+
+				__m128i is_same_tile = _mm_and_si128(_mm_cmpeq_epi32(tile_x, lanes::truncate(position_x)), _mm_cmpeq_epi32(tile_y, lanes::truncate(position_y)));
+
+				uint32 changed_mask = ~static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(is_same_tile))) & 0xF;
+
+				for (; changed_mask != 0; changed_mask &= changed_mask - 1)
+				{
+					changed_out[changed_count++] = index + std::countr_zero(changed_mask);
+				}
+			}
+		}
+#endif
+
+		//finish off the colliders that did not fill a whole register
+		for (; index < collider_count; ++index)
+		{
+			bool changed_tile = integrate_collider<fixed_type>(x[index], y[index], velocity_x[index], velocity_y[index], radius[index], move_fraction[index], sub_step_fraction[index], time_step, world_edge, old_tile_x[index], old_tile_y[index]);
+
+			changed_out[changed_count] = index;
+
+			changed_count += changed_tile;
+		}
+
+		return changed_count;
+	}
+}
\ No newline at end of file
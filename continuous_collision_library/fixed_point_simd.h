@@ -0,0 +1,166 @@
+#pragma once
+
+#include "base_types_definition.h"
+#include "continuous_collision_library/physics_numeric_policy.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+//fixed point maths on packed int32 lanes for the simd paths of the deterministic numeric policy
+//each function gives the same bits as the matching fixed_point operator so the simd paths and the scalar tails always agree
+
+namespace ContinuousCollisionLibrary
+{
+	template<uint32 Ifraction_bits>
+	struct fixed_point_simd
+	{
+#if defined(__AVX2__)
+		using lanes_type = __m256i;
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		using lanes_type = __m128i;
+#endif
+
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		//signed 64 bit products of the even lanes, lane 0 of a and b goes into int64 lane 0 and so on
+		static lanes_type multiply_wide_even(lanes_type a, lanes_type b);
+
+		//signed 64 bit products of the odd lanes, lane 1 of a and b goes into int64 lane 0 and so on
+		static lanes_type multiply_wide_odd(lanes_type a, lanes_type b);
+
+		//the same as fixed_point::operator*, only the low 32 bits of each shifted product are kept
+		//so a logical shift gets them right as well as an arithmetic one
+		static lanes_type multiply(lanes_type a, lanes_type b);
+
+		//the integer part of each lane rounded towards 0, the same as casting a fixed point to an int
+		static lanes_type truncate(lanes_type raw);
+
+		//all bits set in the int32 lanes where the matching int64 lane is negative, the even lanes come from even_wide and the odd from odd_wide
+		static lanes_type is_negative_wide(lanes_type even_wide, lanes_type odd_wide);
+#endif
+	};
+
+#if defined(__AVX2__)
+	template<uint32 Ifraction_bits>
+	inline __m256i fixed_point_simd<Ifraction_bits>::multiply_wide_even(__m256i a, __m256i b)
+	{
+		return _mm256_mul_epi32(a, b);
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m256i fixed_point_simd<Ifraction_bits>::multiply_wide_odd(__m256i a, __m256i b)
+	{
+		//the multiply only reads the low half of each int64 lane so a shuffle can move the odd lanes down, it runs on a different port to the multiplies
+		return _mm256_mul_epi32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 1, 1)), _mm256_shuffle_epi32(b, _MM_SHUFFLE(3, 3, 1, 1)));
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m256i fixed_point_simd<Ifraction_bits>::multiply(__m256i a, __m256i b)
+	{
+		__m256i even = _mm256_srli_epi64(multiply_wide_even(a, b), Ifraction_bits);
+		__m256i odd = _mm256_slli_epi64(multiply_wide_odd(a, b), 32 - Ifraction_bits);
+
+		return _mm256_blend_epi32(even, odd, 0b10101010);
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m256i fixed_point_simd<Ifraction_bits>::truncate(__m256i raw)
+	{
+		__m256i round_up = _mm256_and_si256(_mm256_srai_epi32(raw, 31), _mm256_set1_epi32(fixed_point<Ifraction_bits>::one_raw - 1));
+
+		return _mm256_srai_epi32(_mm256_add_epi32(raw, round_up), Ifraction_bits);
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m256i fixed_point_simd<Ifraction_bits>::is_negative_wide(__m256i even_wide, __m256i odd_wide)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+
+		return _mm256_blend_epi32(_mm256_cmpgt_epi64(zero, even_wide), _mm256_cmpgt_epi64(zero, odd_wide), 0b10101010);
+	}
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#if defined(__SSE4_1__) || defined(__AVX__)
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::multiply_wide_even(__m128i a, __m128i b)
+	{
+		return _mm_mul_epi32(a, b);
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::multiply_wide_odd(__m128i a, __m128i b)
+	{
+		//the multiply only reads the low half of each int64 lane so a shuffle can move the odd lanes down, it runs on a different port to the multiplies
+		return _mm_mul_epi32(_mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 1, 1)), _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 3, 1, 1)));
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::multiply(__m128i a, __m128i b)
+	{
+		__m128i even = _mm_srli_epi64(multiply_wide_even(a, b), Ifraction_bits);
+		__m128i odd = _mm_slli_epi64(multiply_wide_odd(a, b), 32 - Ifraction_bits);
+
+		return _mm_blend_epi16(even, odd, 0b11001100);
+	}
+#else
+	//sse2 only has an unsigned 32 x 32 multiply, the signed product is the unsigned one with b taken off the top half
+	//when a is negative and a taken off when b is negative
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::multiply_wide_even(__m128i a, __m128i b)
+	{
+		__m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+
+		return _mm_sub_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(correction, 32));
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::multiply_wide_odd(__m128i a, __m128i b)
+	{
+		const __m128i low_half = _mm_set1_epi64x(0xffffffff);
+
+		__m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+
+		return _mm_sub_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), _mm_andnot_si128(low_half, correction));
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::multiply(__m128i a, __m128i b)
+	{
+		const __m128i low_half = _mm_set1_epi64x(0xffffffff);
+
+		//only the top half of the even products needs correcting and the shifts below drop the top half of the odd ones
+		//so the whole correction can come off the 32 bit results
+		__m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+
+		//keep the 32 bits above the fraction bits of each unsigned product
+		__m128i even = _mm_and_si128(_mm_srli_epi64(_mm_mul_epu32(a, b), Ifraction_bits), low_half);
+		__m128i odd = _mm_andnot_si128(low_half, _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), 32 - Ifraction_bits));
+
+		return _mm_sub_epi32(_mm_or_si128(even, odd), _mm_slli_epi32(correction, 32 - Ifraction_bits));
+	}
+#endif
+
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::truncate(__m128i raw)
+	{
+		__m128i round_up = _mm_and_si128(_mm_srai_epi32(raw, 31), _mm_set1_epi32(fixed_point<Ifraction_bits>::one_raw - 1));
+
+		return _mm_srai_epi32(_mm_add_epi32(raw, round_up), Ifraction_bits);
+	}
+
+	template<uint32 Ifraction_bits>
+	inline __m128i fixed_point_simd<Ifraction_bits>::is_negative_wide(__m128i even_wide, __m128i odd_wide)
+	{
+		//no 64 bit compare before sse4.2 so copy the sign of the top half of each int64 lane over the whole lane
+		__m128i even_sign = _mm_shuffle_epi32(_mm_srai_epi32(even_wide, 31), _MM_SHUFFLE(3, 3, 1, 1));
+		__m128i odd_sign = _mm_shuffle_epi32(_mm_srai_epi32(odd_wide, 31), _MM_SHUFFLE(3, 3, 1, 1));
+
+		const __m128i low_half = _mm_set1_epi64x(0xffffffff);
+
+		return _mm_or_si128(_mm_and_si128(even_sign, low_half), _mm_andnot_si128(low_half, odd_sign));
+	}
+#endif
+}
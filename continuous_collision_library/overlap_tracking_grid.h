@@ -8,12 +8,19 @@
 #include "vector_2d_math_utils/rect_types.h"
 #include "base_types_definition.h"
 #include "vector_2d_math_utils/byte_vector_2d.h"
+#include "misc_utilities/profile_zones.h"
 #include <limits>
 #include <algorithm>
 #include <utility>
 #include <cmath>
 #include <bit>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 
 
 namespace ContinuousCollisionLibrary
@@ -129,7 +136,7 @@ namespace ContinuousCollisionLibrary
 			return *this;
 		}
 
-		overlap_flag_template<TFlagDataType, IoverlapRegionWidth>& operator~() const
+		overlap_flag_template<TFlagDataType, IoverlapRegionWidth> operator~() const
 		{
 			overlap_flag_template<TFlagDataType, IoverlapRegionWidth> result;
 			result.overlap_flag = ~overlap_flag;
@@ -215,6 +222,17 @@ namespace ContinuousCollisionLibrary
 		using sector_overlap_list = ArrayUtilities::wide_node_linked_list<grid_dimensions::sector_tile_count, uint16, max_overlap_pairs_per_sector, wide_node_linked_list_width, math_2d_util::byte_vector_2d>;
 
 
+		//how much one update_bounds call changed, the physics stats add these up
+		struct bounds_update_counts
+		{
+			//tiles that had this tiles flag set or cleared
+			uint32 flag_writes = 0;
+
+			//tile pairs that started or stopped overlapping, each pair is stored in both tiles lists
+			uint32 pairs_added = 0;
+			uint32 pairs_removed = 0;
+		};
+
 		//constructor 
 		overlap_tracking_grid();
 		
@@ -222,13 +240,19 @@ namespace ContinuousCollisionLibrary
 		void initialize();
 		
 		//make bounds at index larget
-		void update_bounds(const math_2d_util::ivec2d& tile_coordinate_to_update, overlap_grid_index tile_sector_packed_index_to_update, const math_2d_util::irect& new_world_bounds_for_tile_items);
+		bounds_update_counts update_bounds(const math_2d_util::ivec2d& tile_coordinate_to_update, overlap_grid_index tile_sector_packed_index_to_update, const math_2d_util::irect& new_world_bounds_for_tile_items);
+
+		//true if the tile has had its bounds set and they have not been cleared
+		bool has_bounds(overlap_grid_index tile_sector_packed_index) const;
+
+		//the bounds of the items in a tile in world tile coordinates, max is inclusive
+		math_2d_util::irect get_world_bounds(const math_2d_util::ivec2d& tile_coordinate, overlap_grid_index tile_sector_packed_index) const;
 		
 		//calculates the bitflag for a tile relative to another tile
 		overlap_flags calculate_flag_for_tile(const math_2d_util::ivec2d & tile_to_create_flag_for, const math_2d_util::ivec2d & target_tile) const;
 
-		//add flag to all tiles in rect
-		void add_flag_to_tiles(
+		//add flag to all tiles in rect, returns the number of new overlap pairs
+		uint32 add_flag_to_tiles(
 			const math_2d_util::ivec2d& source_tile_cord,
 			overlap_grid_index source_world_tile,
 			const math_2d_util::irect& add_to_area,
@@ -237,14 +261,14 @@ namespace ContinuousCollisionLibrary
 
 		//helper function that converts source tile cord to a grid index and calls the above function
 		//use the other function if you have the sector grid tile index available
-		void add_flag_to_tiles(
+		uint32 add_flag_to_tiles(
 			const math_2d_util::ivec2d& source_tile_cord, 
 			const math_2d_util::irect& add_to_area, 
 			const math_2d_util::irect& old_bounds, 
 			const math_2d_util::irect& new_bounds);
 		
-		//remove flag from all tiles in rect 
-		void remove_flag_from_tiles(
+		//remove flag from all tiles in rect, returns the number of overlap pairs removed
+		uint32 remove_flag_from_tiles(
 			const math_2d_util::ivec2d& source_tile_cord,
 			overlap_grid_index source_world_tile,
 			const math_2d_util::irect& remove_area,
@@ -252,7 +276,7 @@ namespace ContinuousCollisionLibrary
 			const math_2d_util::irect& new_bounds);
 
 		//helper function that converts source tile cord to a grid index and calls the above function
-		void remove_flag_from_tiles(
+		uint32 remove_flag_from_tiles(
 			const math_2d_util::ivec2d& source_tile_cord, 
 			const math_2d_util::irect& remove_area, 
 			const math_2d_util::irect& old_bounds, 
@@ -273,6 +297,26 @@ namespace ContinuousCollisionLibrary
 		//max size of the other tile so 2 times max tile overlap squared 
 		static constexpr uint32 max_overlap_pairs = (tile_overlap_max_width + tile_overlap_max_width) * (tile_overlap_max_width + tile_overlap_max_width);
 
+		//call run_func(run start, first tile flags, run length, source flag in the first tile) for every run of tiles in area that sit next to each other in a row of one sector
+		//the tiles in a sector row are stored one after another so each run can be worked on as a plain array
+		template<typename Trun_func>
+		void for_each_flag_run(const math_2d_util::ivec2d& source_tile_cord, const math_2d_util::irect& area, Trun_func&& run_func);
+
+		//set or clear the source tile flag in a run of tiles
+		//the flag moves down one bit for every tile to the right so a whole run is done with shifted copies of the first flag
+		template<bool Iis_adding>
+		static void update_flags_in_run(overlap_flags* run, uint32 run_length, uint64 first_flag);
+
+		//second pass after the flags in area have been changed, finds the tiles that started or stopped overlapping the source tile
+		//changed_bounds are the source bounds that cover area, the new bounds when adding and the old bounds when removing, other_bounds are the bounds on the other side of the change
+		//each pair is only found in the top left tile the two bounds share, returns the number of tiles written to changed_pairs
+		uint32 find_changed_overlap_pairs(
+			const math_2d_util::ivec2d& source_tile_cord,
+			const math_2d_util::irect& area,
+			const math_2d_util::irect& changed_bounds,
+			const math_2d_util::irect& other_bounds,
+			std::array<overlap_grid_index, max_overlap_pairs>& changed_pairs);
+
 
 		ContinuousCollisionLibrary::uint32 get_affinity_for_offset(const math_2d_util::uivec2d& offset) const;
 
@@ -287,6 +331,10 @@ namespace ContinuousCollisionLibrary
 		
 		//structure holding a list of all the intersecting tiles per sector
 		std::array<sector_overlap_list, grid_dimensions::sector_grid_count> overlap_pairs;
+
+		//set when a sectors overlap list is added to or removed from, nothing in the grid clears it
+		//so whoever wants to track changes to the lists clears it once they have seen them
+		std::array<bool, grid_dimensions::sector_grid_count> is_overlap_pair_list_changed = {};
 	};
 
 };
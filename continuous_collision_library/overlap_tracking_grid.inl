@@ -32,8 +32,25 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 }
 
 template<typename TGridDimensions>
-inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::update_bounds(const math_2d_util::ivec2d& tile_coordinate_to_update, overlap_grid_index tile_sector_packed_index_to_update, const math_2d_util::irect& new_world_bounds_for_tile_items)
+inline bool ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::has_bounds(overlap_grid_index tile_sector_packed_index) const
 {
+	return !(bounds.get_ref_to_data(tile_sector_packed_index) == tile_local_bounds::inverse_max_size_rect());
+}
+
+template<typename TGridDimensions>
+inline math_2d_util::irect ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::get_world_bounds(const math_2d_util::ivec2d& tile_coordinate, overlap_grid_index tile_sector_packed_index) const
+{
+	//get the top left corner the tile is projected from
+	auto bounds_window_top_left = tile_coordinate - tile_local_bounds::vector_type::center().convert_to<math_2d_util::ivec2d>();
+
+	return math_2d_util::rect_2d_math::get_offset_rect_as<math_2d_util::irect>(bounds.get_ref_to_data(tile_sector_packed_index), bounds_window_top_left);
+}
+
+template<typename TGridDimensions>
+inline ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::bounds_update_counts ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::update_bounds(const math_2d_util::ivec2d& tile_coordinate_to_update, overlap_grid_index tile_sector_packed_index_to_update, const math_2d_util::irect& new_world_bounds_for_tile_items)
+{
+	PROFILE_ZONE("overlap_tracking_grid::update_bounds");
+
 	//check that the index and coordinate match
 	//, "Passed in tile xy corrdinate did not match tile index"
 	assert(grid_helper.to_xy<math_2d_util::ivec2d>(tile_sector_packed_index_to_update) == tile_coordinate_to_update);
@@ -79,26 +96,27 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 	if(!(add_count | remove_count))
 	{
 
+		//the strips are built in world space and clipped to the rect they come from so bounds that jumped clear of each other still work
 		//------------- remove top and bottom before sides as removes are faster with long x and short y axis -----------------
 
 		{
 			//trim the top
 			{
 				remove_rects[remove_count].min = old_world_bounds.min;
-				remove_rects[remove_count].max = math_2d_util::ivec2d{ old_world_bounds.max.x, new_world_bounds_for_tile_items.min.y };
+				remove_rects[remove_count].max = math_2d_util::ivec2d{ old_world_bounds.max.x, std::min(new_world_bounds_for_tile_items.min.y, old_world_bounds.max.y) };
 				remove_count += old_world_bounds.min.y < new_world_bounds_for_tile_items.min.y;
 			}
 
 			//trim the left
 			{
 				remove_rects[remove_count].min = math_2d_util::ivec2d{ old_world_bounds.min.x,new_min_y };
-				remove_rects[remove_count].max = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.min.x,new_max_y };
+				remove_rects[remove_count].max = math_2d_util::ivec2d{ std::min(new_world_bounds_for_tile_items.min.x, old_world_bounds.max.x),new_max_y };
 				remove_count += old_world_bounds.min.x < new_world_bounds_for_tile_items.min.x;
 			}
 
 			//trim the right
 			{
-				remove_rects[remove_count].min = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.max.x, new_min_y };
+				remove_rects[remove_count].min = math_2d_util::ivec2d{ std::max(new_world_bounds_for_tile_items.max.x, old_world_bounds.min.x), new_min_y };
 				remove_rects[remove_count].max = math_2d_util::ivec2d{ old_world_bounds.max.x, new_max_y };
 				remove_count += old_world_bounds.max.x > new_world_bounds_for_tile_items.max.x;
 			}
@@ -106,7 +124,7 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 			//trim the bottom 
 			{
 				remove_rects[remove_count].max = old_world_bounds.max;
-				remove_rects[remove_count].min = math_2d_util::ivec2d{ old_world_bounds.min.x, new_world_bounds_for_tile_items.max.y };
+				remove_rects[remove_count].min = math_2d_util::ivec2d{ old_world_bounds.min.x, std::max(new_world_bounds_for_tile_items.max.y, old_world_bounds.min.y) };
 				remove_count += old_world_bounds.max.y > new_world_bounds_for_tile_items.max.y;
 			}
 		}
@@ -119,20 +137,20 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 			//add to the top
 			{
 				add_rects[add_count].min = new_world_bounds_for_tile_items.min;
-				add_rects[add_count].max = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.max.x, old_local_bounds.min.y };
+				add_rects[add_count].max = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.max.x, std::min(old_world_bounds.min.y, new_world_bounds_for_tile_items.max.y) };
 				add_count += old_world_bounds.min.y > new_world_bounds_for_tile_items.min.y;
 			}
 
 			//add to the left
 			{
 				add_rects[add_count].min = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.min.x,new_min_y };
-				add_rects[add_count].max = math_2d_util::ivec2d{ old_local_bounds.min.x,new_max_y };
+				add_rects[add_count].max = math_2d_util::ivec2d{ std::min(old_world_bounds.min.x, new_world_bounds_for_tile_items.max.x),new_max_y };
 				add_count += old_world_bounds.min.x > new_world_bounds_for_tile_items.min.x;
 			}
 
 			//add to the right
 			{
-				add_rects[add_count].min = math_2d_util::ivec2d{ old_local_bounds.max.x, new_min_y };
+				add_rects[add_count].min = math_2d_util::ivec2d{ std::max(old_world_bounds.max.x, new_world_bounds_for_tile_items.min.x), new_min_y };
 				add_rects[add_count].max = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.max.x, new_max_y };
 				add_count += old_world_bounds.max.x < new_world_bounds_for_tile_items.max.x;
 			}
@@ -140,22 +158,32 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 			//add to the bottom 
 			{
 				add_rects[add_count].max = new_world_bounds_for_tile_items.max;
-				add_rects[add_count].min = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.min.x,old_local_bounds.max.y };
+				add_rects[add_count].min = math_2d_util::ivec2d{ new_world_bounds_for_tile_items.min.x,std::max(old_world_bounds.max.y, new_world_bounds_for_tile_items.min.y) };
 				add_count += old_world_bounds.max.y < new_world_bounds_for_tile_items.max.y;
 			}
 		}
 	}
 
+	bounds_update_counts counts;
+
+	//the flag loops stop before max so this is the number of tiles they touch
+	auto get_rect_tile_count = [](const math_2d_util::irect& rect)
+		{
+			return static_cast<uint32>(std::max(rect.max.x - rect.min.x, 0) * std::max(rect.max.y - rect.min.y, 0));
+		};
+
 	//loop through all the remove rects and change the flags 
 	for (uint32 i = 0; i < remove_count; i++)
 	{
-		remove_flag_from_tiles(tile_coordinate_to_update, tile_sector_packed_index_to_update, remove_rects[i], old_world_bounds, new_world_bounds_for_tile_items);
+		counts.flag_writes += get_rect_tile_count(remove_rects[i]);
+		counts.pairs_removed += remove_flag_from_tiles(tile_coordinate_to_update, tile_sector_packed_index_to_update, remove_rects[i], old_world_bounds, new_world_bounds_for_tile_items);
 	}
 
 	//loop through all the add rects and change the flags 
 	for (uint32 i = 0; i < add_count; i++)
 	{
-		add_flag_to_tiles(tile_coordinate_to_update, tile_sector_packed_index_to_update, (add_rects[i]), old_world_bounds, new_world_bounds_for_tile_items);
+		counts.flag_writes += get_rect_tile_count(add_rects[i]);
+		counts.pairs_added += add_flag_to_tiles(tile_coordinate_to_update, tile_sector_packed_index_to_update, (add_rects[i]), old_world_bounds, new_world_bounds_for_tile_items);
 	}
 
 	//convert new world bounds back to local bounds
@@ -166,6 +194,10 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 	old_local_bounds.min = static_cast<tile_local_bounds::vector_type>(new_local_min);
 	old_local_bounds.max = static_cast<tile_local_bounds::vector_type>(new_local_max);
 
+	//a cleared tile has to go back to the local empty rect, the world empty rect does not survive the cast to bytes
+	old_local_bounds = (new_world_bounds_for_tile_items == math_2d_util::irect::inverse_max_size_rect()) ? tile_local_bounds::inverse_max_size_rect() : old_local_bounds;
+
+	return counts;
 }
 
 template<typename TGridDimensions>
@@ -184,7 +216,7 @@ inline ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::overl
 }
 
 template<typename TGridDimensions>
-inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::add_flag_to_tiles(
+inline ContinuousCollisionLibrary::uint32 ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::add_flag_to_tiles(
 	const math_2d_util::ivec2d& source_tile_cord,
 	const math_2d_util::irect& add_to_area,
 	const math_2d_util::irect& old_bounds,
@@ -193,11 +225,11 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 	//the source tile index
 	auto source_world_tile = grid_helper.from_xy(source_tile_cord);
 
-	add_flag_to_tiles(source_tile_cord, source_world_tile, add_to_area, old_bounds, new_bounds);
+	return add_flag_to_tiles(source_tile_cord, source_world_tile, add_to_area, old_bounds, new_bounds);
 }
 
 template<typename TGridDimensions>
-inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::add_flag_to_tiles(
+inline ContinuousCollisionLibrary::uint32 ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::add_flag_to_tiles(
 	const math_2d_util::ivec2d& source_tile_cord,
 	overlap_grid_index source_world_tile,
 	const math_2d_util::irect& add_to_area,
@@ -211,99 +243,18 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 	//, "source cord and source index must be for the same tile"
 	assert(grid_helper.to_xy<math_2d_util::ivec2d>(source_world_tile) == source_tile_cord);
 
+	//set the flag on every tile in the area a row at a time
+	for_each_flag_run(source_tile_cord, add_to_area, [&](const math_2d_util::ivec2d&, overlap_flags* run, uint32 run_length, uint64 first_flag)
+		{
+			update_flags_in_run<true>(run, run_length, first_flag);
+		});
+
 	//the per tile overlap list is a lot more likely to trigger a cache miss so I am 
 	//delaying it and doing it in a sepparate pass to hopefully not trash the cache as much
 	std::array<SectorGrid::sector_tile_index<grid_dimensions>, max_overlap_pairs> new_overlaps;
-	uint32 num_of_new_overlaps = 0;
-
-	//alocate an array for all the possible overlaps 
-	//I am doing this calclulation in passes in the hopes that by doing it this way the 
-	//cpu / compiler will be better at parelelizing it 
-	std::array<uint32, overlap_flags::max_overlaps> overlap_indexes_in_tile;
-	uint32 num_of_overlaps_in_tile = 0;
-
-	//loop through all the tiles 
-	for (int32 iy = add_to_area.min.y; iy < add_to_area.max.y; ++iy)
-	{
-		for (int32 ix = add_to_area.min.x; ix < add_to_area.max.x; ++ix)
-		{
-			//reset the number of overlaps found at this tile
-			num_of_overlaps_in_tile = 0;
-
-			math_2d_util::ivec2d target_xy(ix,iy);
-
-			//convert from xy to lookup
-			SectorGrid::sector_tile_index<grid_dimensions> target_index = grid_helper.from_xy(target_xy);
-
-			//get the flag data for the sector we are accessing 
-			overlap_flags& overlaps_in_tile = overlaps.get_ref_to_data(target_index);
-
-			//calculate the corner offset for this tile 
-			//this calculates a point 4 tiles up/left from the target tile
-			//the target tile has a uint64 offset flags where each bit represents a value that can represent 64 points in a 8 by 8 tile window
-			//the center tile is considered at 4,4 biased to the bottom right
-			math_2d_util::ivec2d overlap_corner = target_xy - overlap_flags::center<math_2d_util::ivec2d>();
-
-
-			//loop through all tight tile bounds that overlap the target tile
-			//and pull out the overlap indexes 
-			for (uint32 overlap_flag_index : overlaps_in_tile)
-			{
-				overlap_indexes_in_tile[num_of_overlaps_in_tile++] = overlap_flag_index;
-			}
-
-			//loop over all items in the index
-			std::for_each(overlap_indexes_in_tile.begin(), overlap_indexes_in_tile.begin() + num_of_overlaps_in_tile, [&](uint32 flag_index)
-				{
-					//calculate the offset for the flag 
-					//this value is 0-7 in both x and y axis
-					math_2d_util::ivec2d offset = overlap_flags::calcualte_offset_for_flag_index(flag_index);
-
-					//calculate the coordinate of this overlap flag
-					math_2d_util::ivec2d overlap_tile_coordinate = offset + overlap_corner;
-
-					//calculate the top left corner of the overlap region for that tile
-					math_2d_util::ivec2d overlap_tile_overlap_region_top_left = overlap_tile_coordinate - static_cast<math_2d_util::ivec2d>(tile_local_bounds::vector_type::center());
-
-					//convert from coordinate to sector grid index 
-					auto overlap_index = grid_helper.from_xy(overlap_tile_coordinate);
-
-					//get the bounds of the overlapped tile 
-					const auto bounds_of_overlapped_tile = bounds.get_ref_to_data(overlap_index);
-
-					//convert bounds from local space to world space using the top left corner offset
-					auto world_bounds_of_overlapped_tile = math_2d_util::rect_2d_math::get_offset_rect_as<math_2d_util::irect>(bounds_of_overlapped_tile, overlap_tile_overlap_region_top_left);
-
-					//check if these tiles were already overlapping
-					bool was_overlapping = math_2d_util::rect_2d_math::is_overlapping(world_bounds_of_overlapped_tile, old_bounds);
-
-					//get the min tile overlap between the new bounds 
-					auto min_overlap_address = math_2d_util::rect_2d_math::get_top_left_corner_of_overlap(new_bounds, world_bounds_of_overlapped_tile);
-
-					//check if this tile is the first tile that these two rects overlap
-					bool is_first_overlap_tile = target_xy == min_overlap_address;
-					
-					//if this is the first time these two tiles have overlapped
-					{
-						//add it to list of all overlap pairs for this tile
-						new_overlaps[num_of_new_overlaps] = overlap_index;
-						
-						num_of_new_overlaps += is_first_overlap_tile && !was_overlapping;
-					}
-				});
-			
-			//flag for source tile 
-			{
-				//get the offset 
-				math_2d_util::ivec2d offset_in_target_window = source_tile_cord - overlap_corner;
 
-				auto flag = overlap_flags(offset_in_target_window);
-
-				//add overlap flag for tile
-				overlaps_in_tile |= flag;
-			}
-		}
-	}
+	//tiles that were not overlapping the old bounds but are now
+	uint32 num_of_new_overlaps = find_changed_overlap_pairs(source_tile_cord, add_to_area, new_bounds, old_bounds, new_overlaps);
 
 	auto source_sector = grid_helper.to_sector_index(source_world_tile);
 
@@ -347,20 +298,25 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 		//add this tile to the target tile 
 		target_sector_overlap_list.add(target_overlap_sub_tile, dif_target_byte_vec);
 		source_overlap_sector.add(source_sub_tile, dif_source_byte_vec);
+
+		is_overlap_pair_list_changed[target_overlap_sector] = true;
+		is_overlap_pair_list_changed[source_sector] = true;
 	}
+
+	return num_of_new_overlaps;
 }
 
 template<typename TGridDimensions>
-inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::remove_flag_from_tiles(const math_2d_util::ivec2d& source_tile_cord, const math_2d_util::irect& remove_area, const math_2d_util::irect& old_bounds, const math_2d_util::irect& new_bounds)
+inline ContinuousCollisionLibrary::uint32 ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::remove_flag_from_tiles(const math_2d_util::ivec2d& source_tile_cord, const math_2d_util::irect& remove_area, const math_2d_util::irect& old_bounds, const math_2d_util::irect& new_bounds)
 {
 	//the source tile index
 	auto source_world_tile = grid_helper.from_xy(source_tile_cord);
 
-	remove_flag_from_tiles(source_tile_cord, source_world_tile, remove_area, old_bounds, new_bounds);
+	return remove_flag_from_tiles(source_tile_cord, source_world_tile, remove_area, old_bounds, new_bounds);
 }
 
 template<typename TGridDimensions>
-inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::remove_flag_from_tiles(const math_2d_util::ivec2d& source_tile_cord, overlap_grid_index source_world_tile,  const math_2d_util::irect & remove_area, const math_2d_util::irect & old_bounds, const math_2d_util::irect & new_bounds)
+inline ContinuousCollisionLibrary::uint32 ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::remove_flag_from_tiles(const math_2d_util::ivec2d& source_tile_cord, overlap_grid_index source_world_tile,  const math_2d_util::irect & remove_area, const math_2d_util::irect & old_bounds, const math_2d_util::irect & new_bounds)
 {
 	//sanity check to make sure boudns falls within grid 
 	//, "rect exits map bounds"
@@ -369,101 +325,18 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 	//, "source cord and source index must be for the same tile"
 	assert(grid_helper.to_xy<math_2d_util::ivec2d>(source_world_tile) ==  static_cast<math_2d_util::ivec2d>(source_tile_cord));
 
+	//clear the flag from every tile in the area a row at a time, this is done first so we dont self detect overlaps
+	for_each_flag_run(source_tile_cord, remove_area, [&](const math_2d_util::ivec2d&, overlap_flags* run, uint32 run_length, uint64 first_flag)
+		{
+			update_flags_in_run<false>(run, run_length, first_flag);
+		});
+
 	//the per tile overlap list is a lot more likely to trigger a cache miss so I am 
 	//delaying it and doing it in a sepparate pass to hopefully not trash the cache as much
 	std::array<SectorGrid::sector_tile_index<grid_dimensions>, max_overlap_pairs> new_overlaps;
-	uint32 num_of_new_overlaps = 0;
-
-	//alocate an array for all the possible overlaps 
-	//I am doing this calclulation in passes in the hopes that by doing it this way the 
-	//cpu / compiler will be better at parelelizing it 
-	std::array<uint32, overlap_flags::max_overlaps> overlap_indexes_in_tile;
-	uint32 num_of_overlaps_in_tile = 0;
-
-	//loop through all the tiles 
-	for (int32 iy = remove_area.min.y; iy < remove_area.max.y; ++iy)
-	{
-		for (int32 ix = remove_area.min.x; ix < remove_area.max.x; ++ix)
-		{
-			//reset the number of overlaps found at this tile
-			num_of_overlaps_in_tile = 0;
-
-			math_2d_util::ivec2d target_xy(ix,iy);
-
-			//convert from xy to lookup
-			SectorGrid::sector_tile_index<grid_dimensions> target_index = grid_helper.from_xy(target_xy);
-
-			//get the flag data for the sector we are accessing 
-			overlap_flags& overlaps_in_tile = overlaps.get_ref_to_data(target_index);
-
-			//calculate the corner offset for this tile 
-			//this calculates a point 4 tiles up/left from the target tile
-			//the target tile has a uint64 offset flags where each bit represents a value that can represent 64 points in a 8 by 8 tile window
-			//the center tile is considered at 4,4 biased to the bottom right
-			math_2d_util::ivec2d overlap_corner = target_xy - overlap_flags::center<math_2d_util::ivec2d>();
-
-			//remove the flag from the tile. we do this first so we dont self detect overlaps
-			{
-				//get the offset 
-				math_2d_util::ivec2d offset_in_target_window = source_tile_cord - overlap_corner;
-
-				auto flag = overlap_flags(offset_in_target_window);
-
-				//add overlap flag for tile
-				overlaps_in_tile &= ~flag;
-			}
-
-			//loop through all tight tile bounds that overlap the target tile
-			//and pull out the overlap indexes 
-			for (uint32 overlap_flag_index : overlaps_in_tile)
-			{
-				overlap_indexes_in_tile[num_of_overlaps_in_tile++] = overlap_flag_index;
-			}
-
-
-			//loop over all items in the index
-			std::for_each(overlap_indexes_in_tile.begin(), overlap_indexes_in_tile.begin() + num_of_overlaps_in_tile, [&](uint32 flag_index)
-				{
-					//calculate the offset for the flag 
-					//this value is 0-7 in both x and y axis
-					math_2d_util::ivec2d offset = overlap_flags::calcualte_offset_for_flag_index(flag_index);
-
-					//calculate the coordinate of this overlap flag
-					math_2d_util::ivec2d overlap_tile_coordinate = offset + overlap_corner;
-
-					//calculate the top left corner of the overlap region for that tile
-					math_2d_util::ivec2d overlap_tile_overlap_region_top_left = overlap_tile_coordinate - static_cast<math_2d_util::ivec2d>(tile_local_bounds::vector_type::center());
-
-					//convert from coordinate to sector grid index 
-					auto overlap_index = grid_helper.from_xy(overlap_tile_coordinate);
 
-					//get the bounds of the overlapped tile 
-					const auto bounds_of_overlapped_tile = bounds.get_ref_to_data(overlap_index);
-
-					//convert bounds from local space to world space using the top left corner offset
-					auto world_bounds_of_overlapped_tile = math_2d_util::rect_2d_math::get_offset_rect_as<math_2d_util::irect>(bounds_of_overlapped_tile, overlap_tile_overlap_region_top_left);
-
-					//check if these tiles will be overlappling after the bounds have changed 
-					bool will_continue_to_overlap = math_2d_util::rect_2d_math::is_overlapping(world_bounds_of_overlapped_tile, static_cast<math_2d_util::irect>(new_bounds));
-
-					//get the min tile overlap between the new bounds 
-					auto min_overlap_address = math_2d_util::rect_2d_math::get_top_left_corner_of_overlap(old_bounds, world_bounds_of_overlapped_tile);
-
-					//check if this tile is the first tile that these two rects overlap
-					bool is_first_overlap_tile = target_xy == min_overlap_address;
-
-					//if this is the first time these two tiles have overlapped
-					{
-						//add it to list of all overlap pairs for this tile
-						new_overlaps[num_of_new_overlaps] = overlap_index;
-
-						num_of_new_overlaps += is_first_overlap_tile && !will_continue_to_overlap;
-					}
-				});
-
-			
-		}
-	}
+	//tiles that were overlapping the old bounds but will not be overlapping the new ones
+	uint32 num_of_new_overlaps = find_changed_overlap_pairs(source_tile_cord, remove_area, old_bounds, new_bounds, new_overlaps);
 
 	auto source_sector = grid_helper.to_sector_index(source_world_tile);
 
@@ -507,9 +380,154 @@ inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::
 		//remove this tile from the overlap list 
 		target_sector_overlap_list.remove(target_overlap_sub_tile, dif_target_byte_vec);
 		source_overlap_sector.remove(source_sub_tile, dif_source_byte_vec);
+
+		is_overlap_pair_list_changed[target_overlap_sector] = true;
+		is_overlap_pair_list_changed[source_sector] = true;
+	}
+
+	return num_of_new_overlaps;
+}
+
+template<typename TGridDimensions>
+template<typename Trun_func>
+inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::for_each_flag_run(const math_2d_util::ivec2d& source_tile_cord, const math_2d_util::irect& area, Trun_func&& run_func)
+{
+	constexpr int32 sector_width = static_cast<int32>(grid_dimensions::sector_w);
+
+	for (int32 iy = area.min.y; iy < area.max.y; ++iy)
+	{
+		for (int32 run_start_x = area.min.x; run_start_x < area.max.x;)
+		{
+			//a run stops at the sector edge as the next tile along is stored in a different sector
+			int32 sector_end_x = (run_start_x - (run_start_x % sector_width)) + sector_width;
+			int32 run_end_x = std::min(area.max.x, sector_end_x);
+
+			math_2d_util::ivec2d run_start(run_start_x, iy);
+
+			//the flag for the source tile in the window of the first tile of the run
+			overlap_flags first_flag(source_tile_cord - (run_start - overlap_flags::center<math_2d_util::ivec2d>()));
+
+			//the flag moves down a bit per tile so the last tile in the run has to still be in the same row of the window
+			assert((run_end_x - 1) <= source_tile_cord.x + static_cast<int32>(overlap_flags::axis_center));
+
+			run_func(run_start, &overlaps.get_ref_to_data(grid_helper.from_xy(run_start)), static_cast<uint32>(run_end_x - run_start_x), first_flag.overlap_flag);
+
+			run_start_x = run_end_x;
+		}
+	}
+}
+
+template<typename TGridDimensions>
+template<bool Iis_adding>
+inline void ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::update_flags_in_run(overlap_flags* run, uint32 run_length, uint64 first_flag)
+{
+	static_assert(sizeof(overlap_flags) == sizeof(uint64), "the flags in a run are worked on as a plain uint64 array");
+
+	uint64* flags = reinterpret_cast<uint64*>(run);
+
+	uint32 i = 0;
+
+#if defined(__AVX2__)
+	{
+		//lane n gets the flag shifted down n more bits
+		const __m256i lane_shift = _mm256_setr_epi64x(0, 1, 2, 3);
+
+		for (; i + 4 <= run_length; i += 4)
+		{
+			__m256i source_flags = _mm256_srlv_epi64(_mm256_set1_epi64x(static_cast<long long>(first_flag >> i)), lane_shift);
+
+			__m256i* address = reinterpret_cast<__m256i*>(flags + i);
+
+			__m256i tile_flags = _mm256_loadu_si256(address);
+
+			tile_flags = Iis_adding ? _mm256_or_si256(tile_flags, source_flags) : _mm256_andnot_si256(source_flags, tile_flags);
+
+			_mm256_storeu_si256(address, tile_flags);
+		}
+	}
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	{
+		for (; i + 2 <= run_length; i += 2)
+		{
+			__m128i source_flags = _mm_set_epi64x(static_cast<long long>(first_flag >> (i + 1)), static_cast<long long>(first_flag >> i));
+
+			__m128i* address = reinterpret_cast<__m128i*>(flags + i);
+
+			__m128i tile_flags = _mm_loadu_si128(address);
+
+			tile_flags = Iis_adding ? _mm_or_si128(tile_flags, source_flags) : _mm_andnot_si128(source_flags, tile_flags);
+
+			_mm_storeu_si128(address, tile_flags);
+		}
+	}
+#endif
+
+	//finish off the tiles that did not fill a whole register
+	for (; i < run_length; ++i)
+	{
+		uint64 source_flag = first_flag >> i;
+
+		flags[i] = Iis_adding ? (flags[i] | source_flag) : (flags[i] & ~source_flag);
 	}
 }
 
+template<typename TGridDimensions>
+inline ContinuousCollisionLibrary::uint32 ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::find_changed_overlap_pairs(
+	const math_2d_util::ivec2d& source_tile_cord,
+	const math_2d_util::irect& area,
+	const math_2d_util::irect& changed_bounds,
+	const math_2d_util::irect& other_bounds,
+	std::array<overlap_grid_index, max_overlap_pairs>& changed_pairs)
+{
+	uint32 changed_pair_count = 0;
+
+	for_each_flag_run(source_tile_cord, area, [&](const math_2d_util::ivec2d& run_start, overlap_flags* run, uint32 run_length, uint64 first_flag)
+		{
+			for (uint32 i = 0; i < run_length; ++i)
+			{
+				math_2d_util::ivec2d target_xy(run_start.x + static_cast<int32>(i), run_start.y);
+
+				//calculate the corner offset for this tile 
+				//this calculates a point 3 tiles up/left from the target tile
+				//the target tile has a uint64 offset flags where each bit represents a tile in the 7 by 7 tile window around it
+				math_2d_util::ivec2d overlap_corner = target_xy - overlap_flags::center<math_2d_util::ivec2d>();
+
+				//every tile bounds that overlaps the target tile apart from the source tile
+				overlap_flags other_tiles_in_tile(run[i].overlap_flag & ~(first_flag >> i));
+
+				for (uint32 flag_index : other_tiles_in_tile)
+				{
+					//calculate the offset for the flag 
+					math_2d_util::ivec2d offset = overlap_flags::calcualte_offset_for_flag_index(flag_index);
+
+					//calculate the coordinate of this overlap flag
+					math_2d_util::ivec2d overlap_tile_coordinate = offset + overlap_corner;
+
+					//calculate the top left corner of the overlap region for that tile
+					math_2d_util::ivec2d overlap_tile_overlap_region_top_left = overlap_tile_coordinate - static_cast<math_2d_util::ivec2d>(tile_local_bounds::vector_type::center());
+
+					//convert from coordinate to sector grid index 
+					auto overlap_index = grid_helper.from_xy(overlap_tile_coordinate);
+
+					//convert bounds of the overlapped tile from local space to world space using the top left corner offset
+					auto world_bounds_of_overlapped_tile = math_2d_util::rect_2d_math::get_offset_rect_as<math_2d_util::irect>(bounds.get_ref_to_data(overlap_index), overlap_tile_overlap_region_top_left);
+
+					//tiles that overlap on the other side of the change have not started or stopped overlapping
+					bool is_overlapping_other_bounds = math_2d_util::rect_2d_math::is_overlapping(world_bounds_of_overlapped_tile, other_bounds);
+
+					//only count the pair in the first tile the two rects overlap
+					bool is_first_overlap_tile = target_xy == math_2d_util::rect_2d_math::get_top_left_corner_of_overlap(changed_bounds, world_bounds_of_overlapped_tile);
+
+					changed_pairs[changed_pair_count] = overlap_index;
+
+					changed_pair_count += is_first_overlap_tile && !is_overlapping_other_bounds;
+				}
+			}
+		});
+
+	return changed_pair_count;
+}
+
 template<typename TGridDimensions>
 inline bool ContinuousCollisionLibrary::overlap_tracking_grid<TGridDimensions>::is_point_in_grid(const math_2d_util::uivec2d& point)
 {
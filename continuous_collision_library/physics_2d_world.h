@@ -0,0 +1,330 @@
+#pragma once
+#include <memory>
+#include <limits>
+#include <span>
+#include <vector>
+#include <assert.h>
+
+#include "base_types_definition.h"
+#include "vector_2d_math_utils/vector_types.h"
+#include "DebugWindowsDrawHelper/debug_draw_interface.h"
+
+#include "continuous_collision_library/2d_physics_main.h"
+
+//runtime sized physics world
+//the world size and object cap are picked when the world is created, under the hood this picks the smallest compiled
+//phyisics_2d_main that fits so the per step code is exactly the same templated code, the only extra cost is one virtual call per function
+//each compiled size allocates all of its storage up front and adds a full copy of the physics code, so only the sizes in the
+//list passed to create are compiled, see physics_2d_world::create for the default list
+
+namespace ContinuousCollisionLibrary
+{
+	//settings for a world picked at load time
+	struct physics_2d_world_settings
+	{
+		//most colliders that can be in the world at once
+		uint32 max_objects = 0;
+
+		//number of sectors on each axis, must be a power of 2
+		uint32 world_sector_x_count = 0;
+	};
+
+	//list of the compiled world sizes create picks from, smallest first
+	//each entry is a physics_2d_world_instance
+	template<typename... Tworld_types>
+	struct physics_2d_world_size_list {};
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count>
+	class physics_2d_world_instance;
+
+	class physics_2d_world
+	{
+	public:
+		//returned when the world is full
+		static constexpr uint32 invalid_collider_id = std::numeric_limits<uint32>::max();
+
+		virtual ~physics_2d_world() = default;
+
+		//try add a collider to the simulation, returns the id of the collider or invalid_collider_id if the world is full
+		virtual uint32 try_queue_item_to_add(math_2d_util::fvec2d position, math_2d_util::fvec2d velocity, float radius) = 0;
+
+		//queue a collider to be removed at the start of the next update, returns false if it is already queued or was already removed
+		//ids returned by try_queue_item_to_add can be removed before the update that adds them
+		virtual bool try_queue_item_to_remove(uint32 collider_id) = 0;
+
+		//queue a new velocity or a one step force for a collider, returns false if the command buffer is full or the collider was removed
+		//the speed limits for colliders are listed on phyisics_2d_main::set_velocity
+		virtual bool queue_velocity_command(uint32 collider_id, math_2d_util::fvec2d velocity) = 0;
+
+		virtual bool queue_force_command(uint32 collider_id, math_2d_util::fvec2d force) = 0;
+
+		//find all colliders touching a circle or rect, returns the number found, only as many as fit are written to out_collider_ids
+		virtual uint32 query_circle(math_2d_util::fvec2d center, float radius, std::span<uint32> out_collider_ids) = 0;
+
+		virtual uint32 query_aabb(const math_2d_util::frect& rect, std::span<uint32> out_collider_ids) = 0;
+
+		//batched circle query, the results for query i start at out_collider_ids[i * max_results_per_query]
+		//and out_result_counts gets the number found for each query, this can be more than max_results_per_query
+		virtual void query_circles(std::span<const math_2d_util::fvec2d> centers, std::span<const float> radii, uint32 max_results_per_query, std::span<uint32> out_collider_ids, std::span<uint32> out_result_counts) = 0;
+
+		//first collider hit by a ray, returns invalid_collider_id if nothing was hit within max_distance
+		virtual uint32 raycast(math_2d_util::fvec2d origin, math_2d_util::fvec2d direction, float max_distance, float& out_distance) = 0;
+
+		//first collider hit by each segment from starts[i] to ends[i], out_collider_ids gets invalid_collider_id for segments that hit nothing
+		virtual void segment_casts(std::span<const math_2d_util::fvec2d> starts, std::span<const math_2d_util::fvec2d> ends, std::span<uint32> out_collider_ids, std::span<float> out_distances) = 0;
+
+		virtual void update_physics() = 0;
+
+		//how many threads to split the per sector work across, 0 = all hardware threads
+		virtual void set_worker_count(uint32 worker_count) = 0;
+
+		virtual uint32 get_worker_count() const = 0;
+
+		virtual void set_solver_iterations(uint32 iterations) = 0;
+
+		//number of steps a collider has to be resting before it goes to sleep, 0 = never sleep
+		virtual void set_sleep_step_count(uint16 step_count) = 0;
+
+		virtual void setup_physics_random(uint32 number_to_spawn, float max_velocity) = 0;
+
+		virtual void draw_debug(debug_draw_interface& draw_interface) = 0;
+
+		//the size of the compiled world that was picked, this can be bigger than what was asked for
+		virtual uint32 get_max_objects() const = 0;
+
+		virtual uint32 get_world_sector_x_count() const = 0;
+
+		//sizes compiled by default, object caps stay under a power of 2 so the handle type still has room for an invalid value
+		//  max objects  sectors  tiles      memory
+		//  4095         4x4      64x64      ~14mb
+		//  16383        8x8      128x128    ~45mb
+		//  65534        16x16    256x256    ~170mb
+		//bigger worlds work but are not in the default list because of their size, a 131070 object 32x32 sector world takes ~660mb
+		using default_size_list = physics_2d_world_size_list<
+			physics_2d_world_instance<4095, 4>,
+			physics_2d_world_instance<16383, 8>,
+			physics_2d_world_instance<std::numeric_limits<uint16>::max() - 1, 16>>;
+
+		//create the smallest world in Tsize_list that fits the settings, returns nullptr if the settings are bigger than all of them
+		//games that know their map sizes can pass their own list so only those sizes get compiled, including sizes past the default list
+		template<typename Tsize_list = default_size_list>
+		static std::unique_ptr<physics_2d_world> create(const physics_2d_world_settings& settings);
+
+	private:
+
+		template<typename... Tworld_types>
+		static std::unique_ptr<physics_2d_world> create_from_list(const physics_2d_world_settings& settings, physics_2d_world_size_list<Tworld_types...>);
+	};
+
+	template<size_t Imax_objects, size_t Iworld_sector_x_count>
+	class physics_2d_world_instance : public physics_2d_world
+	{
+	public:
+		using physics_main_type = phyisics_2d_main<Imax_objects, Iworld_sector_x_count>;
+
+		static constexpr uint32 max_objects = static_cast<uint32>(Imax_objects);
+		static constexpr uint32 world_sector_x_count = static_cast<uint32>(Iworld_sector_x_count);
+
+	private:
+		//this is too big to go on the stack
+		std::unique_ptr<physics_main_type> physics_main = std::make_unique<physics_main_type>();
+
+		using handle_type = typename physics_main_type::handle_type;
+
+		//ids past the end of the world become the invalid handle so the physics rejects them instead of reading out of range
+		static handle_type to_handle(uint32 collider_id)
+		{
+			if (collider_id >= max_objects)
+			{
+				return handle_type::get_invalid_index();
+			}
+
+			return handle_type(static_cast<typename handle_type::handle_index_type>(collider_id));
+		}
+
+		//the handle type is smaller than the ids so queries are run into here then widened
+		std::vector<handle_type> query_handles;
+
+		std::vector<typename physics_main_type::circle_query> circle_queries;
+
+		std::vector<typename physics_main_type::segment_query> segment_queries;
+
+		std::vector<typename physics_main_type::raycast_hit> raycast_hits;
+
+		static uint32 to_collider_id(handle_type handle)
+		{
+			bool is_valid = handle.get_index() != handle_type::get_invalid_index();
+
+			return is_valid ? static_cast<uint32>(handle.get_index()) : invalid_collider_id;
+		}
+
+		void copy_query_results(std::span<uint32> out_collider_ids, uint32 copy_count)
+		{
+			std::transform(query_handles.begin(), query_handles.begin() + copy_count, out_collider_ids.begin(), [](handle_type handle)
+				{
+					return static_cast<uint32>(handle.get_index());
+				});
+		}
+
+	public:
+
+		uint32 try_queue_item_to_add(math_2d_util::fvec2d position, math_2d_util::fvec2d velocity, float radius) override
+		{
+			typename physics_main_type::new_collider_data collider_to_add;
+
+			collider_to_add.position = position;
+			collider_to_add.velocity = velocity;
+			collider_to_add.radius = radius;
+
+			auto handle = physics_main->try_queue_item_to_add(std::move(collider_to_add));
+
+			bool is_valid = handle.get_index() != physics_main_type::handle_type::get_invalid_index();
+
+			return is_valid ? static_cast<uint32>(handle.get_index()) : invalid_collider_id;
+		}
+
+		bool try_queue_item_to_remove(uint32 collider_id) override
+		{
+			return physics_main->try_queue_item_to_remove(to_handle(collider_id));
+		}
+
+		bool queue_velocity_command(uint32 collider_id, math_2d_util::fvec2d velocity) override
+		{
+			return physics_main->queue_velocity_command(to_handle(collider_id), velocity);
+		}
+
+		bool queue_force_command(uint32 collider_id, math_2d_util::fvec2d force) override
+		{
+			return physics_main->queue_force_command(to_handle(collider_id), force);
+		}
+
+		uint32 query_circle(math_2d_util::fvec2d center, float radius, std::span<uint32> out_collider_ids) override
+		{
+			query_handles.resize(out_collider_ids.size());
+
+			uint32 found_count = physics_main->query_circle(center, radius, query_handles);
+
+			copy_query_results(out_collider_ids, std::min(found_count, static_cast<uint32>(out_collider_ids.size())));
+
+			return found_count;
+		}
+
+		uint32 query_aabb(const math_2d_util::frect& rect, std::span<uint32> out_collider_ids) override
+		{
+			query_handles.resize(out_collider_ids.size());
+
+			uint32 found_count = physics_main->query_aabb(rect, query_handles);
+
+			copy_query_results(out_collider_ids, std::min(found_count, static_cast<uint32>(out_collider_ids.size())));
+
+			return found_count;
+		}
+
+		void query_circles(std::span<const math_2d_util::fvec2d> centers, std::span<const float> radii, uint32 max_results_per_query, std::span<uint32> out_collider_ids, std::span<uint32> out_result_counts) override
+		{
+			assert(centers.size() == radii.size());
+
+			circle_queries.resize(centers.size());
+
+			for (size_t iquery = 0; iquery < centers.size(); ++iquery)
+			{
+				circle_queries[iquery] = { centers[iquery], radii[iquery] };
+			}
+
+			query_handles.resize(out_collider_ids.size());
+
+			physics_main->query_circles(circle_queries, max_results_per_query, query_handles, out_result_counts);
+
+			//only the written part of each query slice is valid
+			for (size_t iquery = 0; iquery < centers.size(); ++iquery)
+			{
+				uint32 slice_start = static_cast<uint32>(iquery) * max_results_per_query;
+				uint32 written_count = std::min(out_result_counts[iquery], max_results_per_query);
+
+				std::transform(query_handles.begin() + slice_start, query_handles.begin() + slice_start + written_count, out_collider_ids.begin() + slice_start, [](handle_type handle)
+					{
+						return static_cast<uint32>(handle.get_index());
+					});
+			}
+		}
+
+		uint32 raycast(math_2d_util::fvec2d origin, math_2d_util::fvec2d direction, float max_distance, float& out_distance) override
+		{
+			auto hit = physics_main->raycast(origin, direction, max_distance);
+
+			out_distance = hit.distance;
+
+			return to_collider_id(hit.handle);
+		}
+
+		void segment_casts(std::span<const math_2d_util::fvec2d> starts, std::span<const math_2d_util::fvec2d> ends, std::span<uint32> out_collider_ids, std::span<float> out_distances) override
+		{
+			assert(starts.size() == ends.size());
+			assert(out_collider_ids.size() >= starts.size() && out_distances.size() >= starts.size());
+
+			segment_queries.resize(starts.size());
+			raycast_hits.resize(starts.size());
+
+			for (size_t iquery = 0; iquery < starts.size(); ++iquery)
+			{
+				segment_queries[iquery] = { starts[iquery], ends[iquery] };
+			}
+
+			physics_main->segment_casts(segment_queries, raycast_hits);
+
+			for (size_t iquery = 0; iquery < starts.size(); ++iquery)
+			{
+				out_collider_ids[iquery] = to_collider_id(raycast_hits[iquery].handle);
+				out_distances[iquery] = raycast_hits[iquery].distance;
+			}
+		}
+
+		void update_physics() override { physics_main->update_physics(); }
+
+		void set_worker_count(uint32 worker_count) override { physics_main->set_worker_count(worker_count); }
+
+		uint32 get_worker_count() const override { return physics_main->get_worker_count(); }
+
+		void set_solver_iterations(uint32 iterations) override { physics_main->set_solver_iterations(iterations); }
+
+		void set_sleep_step_count(uint16 step_count) override { physics_main->set_sleep_step_count(step_count); }
+
+		void setup_physics_random(uint32 number_to_spawn, float max_velocity) override { physics_main->setup_physics_random(number_to_spawn, max_velocity); }
+
+		void draw_debug(debug_draw_interface& draw_interface) override { physics_main->draw_debug(draw_interface); }
+
+		uint32 get_max_objects() const override { return max_objects; }
+
+		uint32 get_world_sector_x_count() const override { return world_sector_x_count; }
+	};
+
+	template<typename Tsize_list>
+	inline std::unique_ptr<physics_2d_world> physics_2d_world::create(const physics_2d_world_settings& settings)
+	{
+		return create_from_list(settings, Tsize_list{});
+	}
+
+	template<typename... Tworld_types>
+	inline std::unique_ptr<physics_2d_world> physics_2d_world::create_from_list(const physics_2d_world_settings& settings, physics_2d_world_size_list<Tworld_types...>)
+	{
+		std::unique_ptr<physics_2d_world> world;
+
+		//the first size in the list that fits wins so the list has to be smallest first
+		auto try_create = [&]<typename Tworld_type>()
+			{
+				bool fits = settings.max_objects <= Tworld_type::max_objects && settings.world_sector_x_count <= Tworld_type::world_sector_x_count;
+
+				if (fits)
+				{
+					world = std::make_unique<Tworld_type>();
+				}
+
+				return fits;
+			};
+
+		(try_create.template operator()<Tworld_types>() || ...);
+
+		//nullptr if no size in the list is big enough
+		return world;
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <cmath>
+#include <compare>
+#include <limits>
+#include <algorithm>
+
+#include "base_types_definition.h"
+
+//the number type the physics stores and steps its colliders with, picked at compile time with the policy template argument
+//float is the default, the fixed point policy does all the simulation maths on integers so the same inputs give bit identical
+//results on every x86-64 build no matter what compiler or cpu features it was built with, this is what lockstep multiplayer needs
+
+namespace ContinuousCollisionLibrary
+{
+	//signed fixed point number stored in an int32 with Ifraction_bits bits after the point
+	//products and quotients go through int64 so they only overflow if the result itself does not fit
+	template<uint32 Ifraction_bits>
+	struct fixed_point
+	{
+		static_assert(Ifraction_bits > 0 && Ifraction_bits < 31);
+
+		static constexpr uint32 fraction_bits = Ifraction_bits;
+
+		static constexpr int32 one_raw = int32(1) << Ifraction_bits;
+
+		int32 raw = 0;
+
+		constexpr fixed_point() = default;
+
+		//rounds to the nearest step, only feed this values that are the same on every machine like constants and game inputs
+		explicit constexpr fixed_point(float value) : raw(static_cast<int32>((static_cast<double>(value) * one_raw) + (value < 0.0f ? -0.5 : 0.5))) {}
+
+		explicit constexpr fixed_point(int32 value) : raw(value * one_raw) {}
+
+		static constexpr fixed_point from_raw(int32 raw_value)
+		{
+			fixed_point out;
+			out.raw = raw_value;
+			return out;
+		}
+
+		//truncates towards 0 the same as casting a float does
+		explicit constexpr operator int32() const { return raw / one_raw; }
+
+		explicit constexpr operator uint32() const { return static_cast<uint32>(raw / one_raw); }
+
+		//exact as long as the value fits in the 24 bits of a float mantissa
+		explicit constexpr operator float() const { return static_cast<float>(raw) / static_cast<float>(one_raw); }
+
+		constexpr fixed_point operator+(fixed_point other) const { return from_raw(raw + other.raw); }
+
+		constexpr fixed_point operator-(fixed_point other) const { return from_raw(raw - other.raw); }
+
+		constexpr fixed_point operator-() const { return from_raw(-raw); }
+
+		//the shift rounds towards negative infinity which is fine as long as it does it the same way everywhere
+		constexpr fixed_point operator*(fixed_point other) const { return from_raw(static_cast<int32>((static_cast<int64>(raw) * other.raw) >> Ifraction_bits)); }
+
+		constexpr fixed_point operator/(fixed_point other) const { return from_raw(static_cast<int32>((static_cast<int64>(raw) * one_raw) / other.raw)); }
+
+		constexpr fixed_point& operator+=(fixed_point other) { return *this = *this + other; }
+
+		constexpr fixed_point& operator-=(fixed_point other) { return *this = *this - other; }
+
+		constexpr fixed_point& operator*=(fixed_point other) { return *this = *this * other; }
+
+		constexpr fixed_point& operator/=(fixed_point other) { return *this = *this / other; }
+
+		constexpr auto operator<=>(const fixed_point& other) const = default;
+
+		//largest integer whose square is not more than value, the double sqrt gets close and the fix up makes it exact
+		//so the result does not depend on how the sqrt was rounded
+		static uint64 integer_square_root(uint64 value)
+		{
+			return integer_square_root_from_estimate(value, std::sqrt(static_cast<double>(value)));
+		}
+
+		//the same fix up on a double root the caller has already taken, lets simd code take several roots at once
+		static uint64 integer_square_root_from_estimate(uint64 value, double root_estimate)
+		{
+			uint64 root = static_cast<uint64>(root_estimate);
+
+			//the double can be a little out for big values
+			root = std::min<uint64>(root, 0xffffffffull);
+
+			while (root * root > value)
+			{
+				--root;
+			}
+
+			while ((root + 1) <= 0xffffffffull && (root + 1) * (root + 1) <= value)
+			{
+				++root;
+			}
+
+			return root;
+		}
+	};
+
+	//default policy, plain floats
+	struct float_numeric_policy
+	{
+		using scalar_type = float;
+
+		static constexpr bool is_deterministic = false;
+
+		//smallest length that is safe to divide by
+		static constexpr scalar_type epsilon = std::numeric_limits<float>::epsilon();
+
+		static constexpr scalar_type from_float(float value) { return value; }
+
+		static constexpr float to_float(scalar_type value) { return value; }
+
+		static scalar_type abs(scalar_type value) { return std::abs(value); }
+
+		static scalar_type length(scalar_type x, scalar_type y) { return std::sqrt((x * x) + (y * y)); }
+
+		static bool is_shorter_than(scalar_type x, scalar_type y, scalar_type limit) { return ((x * x) + (y * y)) < (limit * limit); }
+	};
+
+	//deterministic policy, positions velocities and radii are fixed point and lengths are worked out in int64 so squares cant overflow
+	//the default 16 fraction bits covers +-32767 which is plenty for a 256 tile world moving a few tiles a step
+	template<uint32 Ifraction_bits = 16>
+	struct fixed_point_numeric_policy
+	{
+		using scalar_type = fixed_point<Ifraction_bits>;
+
+		static constexpr bool is_deterministic = true;
+
+		//smallest length that is safe to divide by, one over anything shorter than this does not fit in the int32
+		static constexpr scalar_type epsilon = scalar_type::from_raw(int32(1) << (Ifraction_bits / 2));
+
+		static constexpr scalar_type from_float(float value) { return scalar_type(value); }
+
+		static constexpr float to_float(scalar_type value) { return static_cast<float>(value); }
+
+		static constexpr scalar_type abs(scalar_type value) { return scalar_type::from_raw(value.raw < 0 ? -value.raw : value.raw); }
+
+		static scalar_type length(scalar_type x, scalar_type y)
+		{
+			uint64 length_sqr = static_cast<uint64>((static_cast<int64>(x.raw) * x.raw) + (static_cast<int64>(y.raw) * y.raw));
+
+			//the sum has twice the fraction bits so the root comes back with the right number
+			return scalar_type::from_raw(static_cast<int32>(std::min<uint64>(scalar_type::integer_square_root(length_sqr), std::numeric_limits<int32>::max())));
+		}
+
+		static constexpr bool is_shorter_than(scalar_type x, scalar_type y, scalar_type limit)
+		{
+			return ((static_cast<int64>(x.raw) * x.raw) + (static_cast<int64>(y.raw) * y.raw)) < (static_cast<int64>(limit.raw) * limit.raw);
+		}
+	};
+}
+
+//lets fixed point values go in the vector and rect templates
+template<ContinuousCollisionLibrary::uint32 Ifraction_bits>
+class std::numeric_limits<ContinuousCollisionLibrary::fixed_point<Ifraction_bits>>
+{
+	using fixed_point_type = ContinuousCollisionLibrary::fixed_point<Ifraction_bits>;
+
+public:
+	static constexpr bool is_specialized = true;
+	static constexpr bool is_signed = true;
+	static constexpr bool is_integer = false;
+	static constexpr bool is_exact = true;
+
+	static constexpr fixed_point_type min() { return fixed_point_type::from_raw(1); }
+	static constexpr fixed_point_type lowest() { return fixed_point_type::from_raw(std::numeric_limits<ContinuousCollisionLibrary::int32>::lowest()); }
+	static constexpr fixed_point_type max() { return fixed_point_type::from_raw(std::numeric_limits<ContinuousCollisionLibrary::int32>::max()); }
+	static constexpr fixed_point_type epsilon() { return fixed_point_type::from_raw(1); }
+};
@@ -0,0 +1,479 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <bit>
+#include <type_traits>
+
+#include "continuous_collision_library/2d_physics_main.h"
+
+#include <assert.h>
+
+//keeps the last few steps of a physics world so it can be rewound and stepped again for rollback netcode
+//a baseline copy of the state is kept and after each step only the pages that differ from it are saved into a ring of frames
+//so memory grows with how much changed each step, not with the size of the world
+//only the parts of the state a step could have written are compared, the paged containers hand out the pages they wrote,
+//lists are compared up to the longer of their old and new size and per sector blocks only for the sectors in use
+
+namespace ContinuousCollisionLibrary
+{
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	class physics_rollback_buffer
+	{
+	public:
+		//size of the blocks the state is compared and saved in, small enough that a sector with a few moving colliders
+		//only saves the start of each of its collider data pages
+		//pages are lined up with the start of each block so the same bytes always land in the same page
+		static constexpr size_t page_size = 256;
+
+		static constexpr uint32_t max_rollback_frames = Imax_rollback_frames;
+
+		static_assert(Imax_rollback_frames > 0);
+
+		//takes the baseline copy of the physics state, the physics has to outlive this buffer and must not be moved
+		physics_rollback_buffer(Tphysics_type& physics_to_track);
+
+		//forget all the recorded frames and take a new baseline
+		//call this after changing the state in a way that is not a normal step, like loading a snapshot
+		void reset();
+
+		//save the pages that changed since the last recorded frame, call this once after every update_physics
+		//when the ring is full the oldest frame is dropped
+		void record_frame();
+
+		//number of frames that can currently be rolled back
+		uint32_t get_recorded_frame_count() const;
+
+		//put the state back to how it was frames_back records before the last one, only the pages saved in those frames are written
+		//and each page is written once no matter how many of the frames saved it
+		//call this straight after record_frame, anything changed since the last record is not undone
+		//returns false and changes nothing if that many frames have not been recorded
+		bool rollback(uint32_t frames_back);
+
+		//bytes of old page data held by all the recorded frames
+		size_t get_recorded_byte_count() const;
+
+	private:
+
+		using sector_bitmap_type = typename Tphysics_type::sector_bitmap_type;
+
+		using snapshot_block_layout = typename Tphysics_type::snapshot_block_layout;
+
+		static constexpr uint32_t sector_count = Tphysics_type::grid_dimension_type::sector_grid_count;
+
+		//a page that changed during a frame, the old bytes are stored in the frames old data in the same order as the records
+		struct page_record
+		{
+			std::byte* live_data;
+			size_t state_offset;
+			size_t size;
+		};
+
+		struct frame_record
+		{
+			std::vector<page_record> pages;
+			std::vector<std::byte> old_data;
+
+			void clear()
+			{
+				pages.clear();
+				old_data.clear();
+			}
+		};
+
+		Tphysics_type& physics;
+
+		//the state as of the last recorded frame with the blocks laid out one after the other, each block starts on a page
+		std::vector<std::byte> baseline;
+
+		//one bit per page of the baseline, set for pages already written back during a rollback
+		std::vector<uint64_t> restored_page_bits;
+
+		//size of every list in the state at the last record, per sector lists take one entry per sector
+		std::vector<size_t> list_sizes_at_last_record;
+
+		std::array<frame_record, Imax_rollback_frames> frames;
+
+		//the frame the next record is written to
+		uint32_t next_frame = 0;
+
+		uint32_t recorded_frame_count = 0;
+
+		//sectors the state at the last record could write to in the next step
+		sector_bitmap_type baseline_sectors = {};
+
+		//every sector with colliders and their neighbours, these are the only sectors a step can write to
+		sector_bitmap_type get_active_and_neighbouring_sector_bitmap() const;
+
+		//sectors the overlap grid has flagged as having their overlap list changed, the flags are cleared after reading
+		sector_bitmap_type take_changed_overlap_list_bitmap();
+
+		//bytes a block takes up in the baseline
+		static constexpr size_t get_padded_block_size(size_t block_size);
+
+		//lists know how many of their entries are in use so only those need comparing
+		template<typename Tblock>
+		static constexpr bool is_list_block = requires(const Tblock & block) { block.get_byte_ranges(block.size()); };
+
+		//per sector blocks that are a list per sector
+		template<typename Tblock>
+		static constexpr bool is_per_sector_list_block = requires(const Tblock & block) { block[0].get_byte_ranges(block[0].size()); } && !requires(const Tblock & block) { block[0].get_written_byte_ranges(); };
+
+		//read the size of every list in the state into list_sizes_at_last_record
+		void refresh_list_sizes();
+
+		//call func(live_data, state_offset, size) for every page of the state that could have been written since the last call
+		//per sector blocks only visit the sectors in sectors_to_visit and the overlap lists only visit the sectors in overlap_lists_to_visit
+		//this takes the write tracking of the blocks and updates the list sizes so it has to be followed by a record of the visited pages
+		template<typename Tpage_func>
+		void for_each_page(const sector_bitmap_type& sectors_to_visit, const sector_bitmap_type& overlap_lists_to_visit, Tpage_func&& page_func);
+
+		//write the old bytes of a frame back into the state and the baseline, pages already restored by an older frame are skipped
+		void undo_frame(frame_record& frame);
+	};
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::physics_rollback_buffer(Tphysics_type& physics_to_track) :physics(physics_to_track)
+	{
+		reset();
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline void physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::reset()
+	{
+		std::for_each(frames.begin(), frames.end(), [](frame_record& frame) { frame.clear(); });
+
+		next_frame = 0;
+		recorded_frame_count = 0;
+
+		size_t state_size = 0;
+
+		Tphysics_type::for_each_snapshot_block(physics, [&](auto& block, snapshot_block_layout)
+			{
+				state_size += get_padded_block_size(sizeof(block));
+			});
+
+		baseline.assign(state_size, std::byte{});
+
+		restored_page_bits.assign(((state_size / page_size) + 63) / 64, 0);
+
+		refresh_list_sizes();
+
+		//throw away the writes the blocks tracked up to now, everything is copied below
+		sector_bitmap_type all_sectors;
+
+		all_sectors.fill(~uint64_t(0));
+
+		for_each_page(all_sectors, all_sectors, [](std::byte*, size_t, size_t) {});
+
+		take_changed_overlap_list_bitmap();
+
+		//copy every block whole, the pages skipped when recording still have to match the state
+		size_t state_offset = 0;
+
+		Tphysics_type::for_each_snapshot_block(physics, [&](auto& block, snapshot_block_layout)
+			{
+				std::memcpy(baseline.data() + state_offset, &block, sizeof(block));
+
+				state_offset += get_padded_block_size(sizeof(block));
+			});
+
+		baseline_sectors = get_active_and_neighbouring_sector_bitmap();
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline void physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::record_frame()
+	{
+		sector_bitmap_type current_sectors = get_active_and_neighbouring_sector_bitmap();
+
+		//a step writes to the sectors that were active going into it and the ones that are active coming out of it
+		sector_bitmap_type sectors_to_visit;
+
+		for (uint32_t i = 0; i < sectors_to_visit.size(); ++i)
+		{
+			sectors_to_visit[i] = baseline_sectors[i] | current_sectors[i];
+		}
+
+		//the overlap lists are big and most of them dont change each step so only look at the ones the grid says changed
+		sector_bitmap_type overlap_lists_to_visit = take_changed_overlap_list_bitmap();
+
+		frame_record& frame = frames[next_frame];
+
+		//reusing the frame keeps the capacity of its buffers so a steady stream of steps stops allocating
+		frame.clear();
+
+		for_each_page(sectors_to_visit, overlap_lists_to_visit, [&](std::byte* live_data, size_t state_offset, size_t size)
+			{
+				std::byte* baseline_data = baseline.data() + state_offset;
+
+				if (std::memcmp(live_data, baseline_data, size) == 0)
+				{
+					return;
+				}
+
+				frame.pages.push_back(page_record{ live_data, state_offset, size });
+				frame.old_data.insert(frame.old_data.end(), baseline_data, baseline_data + size);
+
+				std::memcpy(baseline_data, live_data, size);
+			});
+
+		next_frame = (next_frame + 1) % Imax_rollback_frames;
+		recorded_frame_count = std::min(recorded_frame_count + 1, Imax_rollback_frames);
+
+		baseline_sectors = current_sectors;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline uint32_t physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::get_recorded_frame_count() const
+	{
+		return recorded_frame_count;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline bool physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::rollback(uint32_t frames_back)
+	{
+		if (frames_back > recorded_frame_count)
+		{
+			return false;
+		}
+
+		uint32_t oldest_frame = (next_frame + Imax_rollback_frames - frames_back) % Imax_rollback_frames;
+
+		//the oldest frame holds the bytes from furthest back so it is undone first and the newer frames skip the pages it wrote
+		for (uint32_t i = 0; i < frames_back; ++i)
+		{
+			undo_frame(frames[(oldest_frame + i) % Imax_rollback_frames]);
+		}
+
+		std::fill(restored_page_bits.begin(), restored_page_bits.end(), 0);
+
+		next_frame = oldest_frame;
+
+		recorded_frame_count -= frames_back;
+
+		//the active sectors and list sizes are part of the restored state
+		baseline_sectors = get_active_and_neighbouring_sector_bitmap();
+
+		refresh_list_sizes();
+
+		//the swept bounds caches are not part of the recorded state
+		physics.mark_all_tile_bounds_dirty();
+
+		return true;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline size_t physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::get_recorded_byte_count() const
+	{
+		size_t byte_count = 0;
+
+		for (const frame_record& frame : frames)
+		{
+			byte_count += frame.old_data.size();
+		}
+
+		return byte_count;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::sector_bitmap_type physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::get_active_and_neighbouring_sector_bitmap() const
+	{
+		sector_bitmap_type bitmap = {};
+
+		for (uint32_t i = 0; i < physics.number_of_active_and_neighbouring_sectors; ++i)
+		{
+			Tphysics_type::set_sector_bit(bitmap, physics.active_and_neighbouring_sectors[i], true);
+		}
+
+		return bitmap;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::sector_bitmap_type physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::take_changed_overlap_list_bitmap()
+	{
+		sector_bitmap_type bitmap = {};
+
+		auto& is_overlap_pair_list_changed = physics.overlap_grid.is_overlap_pair_list_changed;
+
+		for (uint32_t i = 0; i < sector_count; ++i)
+		{
+			Tphysics_type::set_sector_bit(bitmap, i, is_overlap_pair_list_changed[i]);
+		}
+
+		is_overlap_pair_list_changed.fill(false);
+
+		return bitmap;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline constexpr size_t physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::get_padded_block_size(size_t block_size)
+	{
+		//padding every block out to a whole page means a page never holds bytes from two blocks and state_offset / page_size is unique
+		return ((block_size + page_size - 1) / page_size) * page_size;
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline void physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::refresh_list_sizes()
+	{
+		list_sizes_at_last_record.clear();
+
+		Tphysics_type::for_each_snapshot_block(physics, [&](auto& block, snapshot_block_layout layout)
+			{
+				using block_type = std::remove_cvref_t<decltype(block)>;
+
+				if (layout == snapshot_block_layout::WHOLE)
+				{
+					if constexpr (is_list_block<block_type>)
+					{
+						list_sizes_at_last_record.push_back(block.size());
+					}
+				}
+				else if constexpr (is_per_sector_list_block<block_type>)
+				{
+					for (uint32_t sector_index = 0; sector_index < sector_count; ++sector_index)
+					{
+						list_sizes_at_last_record.push_back(block[sector_index].size());
+					}
+				}
+			});
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	template<typename Tpage_func>
+	inline void physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::for_each_page(const sector_bitmap_type& sectors_to_visit, const sector_bitmap_type& overlap_lists_to_visit, Tpage_func&& page_func)
+	{
+		size_t block_state_offset = 0;
+
+		//index into list_sizes_at_last_record of the first list in the current block
+		size_t list_index = 0;
+
+		//visit every page holding part of the range, the range is widened out to whole pages
+		auto visit_range = [&](std::byte* block_data, size_t block_size, size_t range_start, size_t range_size)
+			{
+				size_t range_end = std::min(block_size, range_start + range_size);
+
+				for (size_t offset = range_start - (range_start % page_size); offset < range_end; offset += page_size)
+				{
+					page_func(block_data + offset, block_state_offset + offset, std::min(page_size, block_size - offset));
+				}
+			};
+
+		//entries past the list size can only have been written if the list was longer at the last record
+		auto visit_list = [&](const auto& list, std::byte* block_data, size_t block_size, size_t list_start, size_t& size_at_last_record)
+			{
+				size_t entries_to_visit = std::max<size_t>(list.size(), size_at_last_record);
+
+				size_at_last_record = list.size();
+
+				for (auto range : list.get_byte_ranges(entries_to_visit))
+				{
+					visit_range(block_data, block_size, list_start + range.start, range.size);
+				}
+			};
+
+		Tphysics_type::for_each_snapshot_block(physics, [&](auto& block, snapshot_block_layout layout)
+			{
+				using block_type = std::remove_cvref_t<decltype(block)>;
+
+				std::byte* block_data = reinterpret_cast<std::byte*>(&block);
+
+				if (layout != snapshot_block_layout::WHOLE)
+				{
+					//per sector blocks are an array with one entry per sector
+					assert(sizeof(block) % sector_count == 0);
+
+					size_t sector_size = sizeof(block) / sector_count;
+
+					const sector_bitmap_type& sectors = (layout == snapshot_block_layout::PER_SECTOR) ? sectors_to_visit : overlap_lists_to_visit;
+
+					for (uint32_t word_index = 0; word_index < sectors.size(); ++word_index)
+					{
+						uint64_t word = sectors[word_index];
+
+						while (word)
+						{
+							uint32_t sector_index = (word_index * 64) + std::countr_zero(word);
+
+							word &= word - 1;
+
+							if (sector_index >= sector_count)
+							{
+								continue;
+							}
+
+							//lists that know which of their bytes have been written only need those parts looked at
+							if constexpr (requires { block[sector_index].get_written_byte_ranges(); })
+							{
+								for (auto written_range : block[sector_index].get_written_byte_ranges())
+								{
+									visit_range(block_data, sizeof(block), (sector_index * sector_size) + written_range.start, written_range.size);
+								}
+							}
+							else if constexpr (is_per_sector_list_block<block_type>)
+							{
+								visit_list(block[sector_index], block_data, sizeof(block), sector_index * sector_size, list_sizes_at_last_record[list_index + sector_index]);
+							}
+							else
+							{
+								visit_range(block_data, sizeof(block), sector_index * sector_size, sector_size);
+							}
+						}
+					}
+
+					if constexpr (is_per_sector_list_block<block_type>)
+					{
+						list_index += sector_count;
+					}
+				}
+				else if constexpr (requires { block.take_written_byte_ranges([](const void*, size_t) {}); })
+				{
+					//paged containers track the pages they write to
+					block.take_written_byte_ranges([&](const void* range_data, size_t range_size)
+						{
+							visit_range(block_data, sizeof(block), static_cast<size_t>(static_cast<const std::byte*>(range_data) - block_data), range_size);
+						});
+				}
+				else if constexpr (is_list_block<block_type>)
+				{
+					visit_list(block, block_data, sizeof(block), 0, list_sizes_at_last_record[list_index]);
+
+					++list_index;
+				}
+				else
+				{
+					visit_range(block_data, sizeof(block), 0, sizeof(block));
+				}
+
+				block_state_offset += get_padded_block_size(sizeof(block));
+			});
+
+		assert(list_index == list_sizes_at_last_record.size());
+	}
+
+	template<typename Tphysics_type, uint32_t Imax_rollback_frames>
+	inline void physics_rollback_buffer<Tphysics_type, Imax_rollback_frames>::undo_frame(frame_record& frame)
+	{
+		const std::byte* old_data = frame.old_data.data();
+
+		for (const page_record& page : frame.pages)
+		{
+			size_t page_index = page.state_offset / page_size;
+
+			uint64_t page_bit = uint64_t(1) << (page_index % 64);
+
+			if ((restored_page_bits[page_index / 64] & page_bit) == 0)
+			{
+				restored_page_bits[page_index / 64] |= page_bit;
+
+				std::memcpy(page.live_data, old_data, page.size);
+				std::memcpy(baseline.data() + page.state_offset, old_data, page.size);
+			}
+
+			old_data += page.size;
+		}
+
+		frame.clear();
+	}
+}
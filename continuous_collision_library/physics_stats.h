@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+
+#include "base_types_definition.h"
+#include "misc_utilities/shared_types.h"
+
+//counters for what happened inside one update_physics so a slow step can be explained
+//define CONTINUOUS_COLLISION_DISABLE_STATS to compile every counter out, the stats are then always zero
+
+namespace ContinuousCollisionLibrary
+{
+#if defined(CONTINUOUS_COLLISION_DISABLE_STATS)
+	static constexpr bool is_physics_stats_enabled = false;
+#else
+	static constexpr bool is_physics_stats_enabled = true;
+#endif
+
+	struct physics_stats
+	{
+		static constexpr uint32 direction_count = static_cast<uint32>(MiscUtilities::grid_directions::COUNT);
+
+		//sectors with colliders in them at the end of the step
+		uint32 active_sector_count = 0;
+
+		//colliders in the fullest sector and the mean over the active sectors
+		uint32 max_colliders_in_sector = 0;
+		float mean_colliders_per_active_sector = 0.0f;
+
+		//colliders that moved to another tile in the same sector
+		uint32 tile_changes = 0;
+
+		//colliders that moved into a neighbouring sector, indexed by MiscUtilities::grid_directions
+		std::array<uint32, direction_count> sector_transfers_per_direction = {};
+
+		//sector transfers that found the transfer buffer full and went through the shared spill pool, these are in the counts above too
+		uint32 transfer_spills = 0;
+
+		//colliders moved to a sector that was not next to them through the long range transfer queue
+		uint32 long_range_transfers = 0;
+
+		//movement passes run this step, more than 1 when fast colliders were split into sub steps
+		uint32 integration_passes = 0;
+
+		//sectors moved again by the sub step passes after the first one
+		uint32 sub_stepped_sector_updates = 0;
+
+		//pages taken from and given back to the collider data and tile tracker page pools
+		uint32 pages_allocated = 0;
+		uint32 pages_freed = 0;
+
+		//tiles with more colliders than the pair generation cache holds, these are split into chunks and are slower to pair up
+		uint32 oversized_pair_tiles = 0;
+
+		//dirty tiles that had their colliders walked to work out their bounds, tiles where nothing moved far enough are skipped
+		uint32 tile_bounds_walks = 0;
+
+		//walked tiles with an awake collider that had their bounds worked out again, tiles where everything is asleep keep their old bounds
+		uint32 tile_bounds_updates = 0;
+
+		//tiles that had an overlap flag set or cleared
+		uint32 overlap_flag_writes = 0;
+
+		//tile pairs that started or stopped overlapping, growth is how much the pair lists grew by overall
+		uint32 overlap_pairs_added = 0;
+		uint32 overlap_pairs_removed = 0;
+		int32 overlap_pair_list_growth = 0;
+
+		uint32 get_total_sector_transfers() const
+		{
+			uint32 total = 0;
+
+			for (uint32 transfers : sector_transfers_per_direction)
+			{
+				total += transfers;
+			}
+
+			return total;
+		}
+	};
+}
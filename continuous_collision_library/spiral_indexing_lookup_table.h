@@ -1,6 +1,6 @@
 #pragma once
 #include "base_types_definition.h"
-#include "vector_types.h"
+#include "vector_2d_math_utils/vector_types.h"
 #include <array>
 #include <algorithm>
 
@@ -14,19 +14,21 @@ namespace ContinuousCollisionLibrary
 
 	static constexpr bool is_valid_coordinate(uint32 width, const math_2d_util::ivec2d& coordinate)
 	{
-		return (coordinate.x < width) && (coordinate.x >= 0) && (coordinate.y < width) && (coordinate.y >= 0);
+		return (coordinate.x < static_cast<int32>(width)) && (coordinate.x >= 0) && (coordinate.y < static_cast<int32>(width)) && (coordinate.y >= 0);
 	}
 
-	template<uint32 Iwidth, uint32 IcenterX, uint32 IcenterY>
-	static constexpr std::array<uint32, Iwidth* Iwidth> calculate_spiral_index_lookup()
+	//walk the tiles in square shells around a center, shell 0 is the ring of 8 tiles touching the center
+	//each shell starts at its top left corner and goes right, down, left then up, the center itself is not visited
+	template<typename Tvisit_func>
+	static constexpr void for_each_spiral_coordinate(const math_2d_util::ivec2d& center, uint32 shell_count, Tvisit_func&& visit_func)
 	{
 		//direction enum
 		enum class direction :  uint32
 		{
-			RIGHT, 
-			DOWN, 
-			LEFT, 
-			UP, 
+			RIGHT,
+			DOWN,
+			LEFT,
+			UP,
 			COUNT
 		};
 
@@ -38,45 +40,52 @@ namespace ContinuousCollisionLibrary
 			math_2d_util::ivec2d{0,-1}
 		};
 
-		//create lookup
-		std::array<uint32, Iwidth* Iwidth> spiral_index_lookup = {};
-
-		math_2d_util::ivec2d center = { IcenterX ,IcenterY };
-
-		//set start point to last index 
-		spiral_index_lookup[to_lookup_index(center)] = (Iwidth * Iwidth) - 1;
-
-		//
-		direction itteration_direction = direction::RIGHT;
-		uint32 tiles_per_side = 2;
-		uint32 spiral_index = 0;
-		math_2d_util::ivec2d itteration_cord = center - (math_2d_util::ivec2d(1,1);
-
-		for (int ishell = 0; ishell < Iwidth; ++ishell)
+		for (int32 ishell = 0; ishell < static_cast<int32>(shell_count); ++ishell)
 		{
 			//update the number of tiles per side
-			tiles_per_side = 2 + (ishell * 2);
+			int32 tiles_per_side = 2 + (ishell * 2);
+
+			//move out to the top left corner of this shell
+			math_2d_util::ivec2d itteration_cord = { center.x - (ishell + 1), center.y - (ishell + 1) };
 
-			for (int idirection = 0; idirection < static_cast<uint32>(direction::COUNT); ++idirection)
+			for (uint32 idirection = 0; idirection < static_cast<uint32>(direction::COUNT); ++idirection)
 			{
-				itteration_direction = static_cast<direction>(idirection);
+				const math_2d_util::ivec2d& step = itteration_direction_vec[idirection];
 
-				//itterate over all tiles on a side and set index 
-				for (int iside = 0; iside < tiles_per_side; ++iside)
+				//itterate over all tiles on a side
+				for (int32 iside = 0; iside < tiles_per_side; ++iside)
 				{
-					//check if cord is valid
-					if (is_valid_coordinate(itteration_cord))
-					{
-						uint32 lookup_index = to_lookup_index(itteration_cord);
-
-						spiral_index_lookup[lookup_index] = spiral_index++;
-					}
+					visit_func(itteration_cord, static_cast<uint32>(ishell + 1));
 
 					//advance to the next cord
-					itteration_cord += itteration_direction_vec[static_cast<uint32>(itteration_direction)];
+					itteration_cord.x += step.x;
+					itteration_cord.y += step.y;
 				}
 			}
 		}
+	}
+
+	template<uint32 Iwidth, uint32 IcenterX, uint32 IcenterY>
+	static constexpr std::array<uint32, Iwidth* Iwidth> calculate_spiral_index_lookup()
+	{
+		//create lookup
+		std::array<uint32, Iwidth* Iwidth> spiral_index_lookup = {};
+
+		math_2d_util::ivec2d center = { IcenterX ,IcenterY };
+
+		//set start point to last index
+		spiral_index_lookup[to_lookup_index(Iwidth, center)] = (Iwidth * Iwidth) - 1;
+
+		uint32 spiral_index = 0;
+
+		for_each_spiral_coordinate(center, Iwidth, [&](const math_2d_util::ivec2d& itteration_cord, uint32 ring)
+			{
+				//check if cord is valid
+				if (is_valid_coordinate(Iwidth, itteration_cord))
+				{
+					spiral_index_lookup[to_lookup_index(Iwidth, itteration_cord)] = spiral_index++;
+				}
+			});
 
 		return spiral_index_lookup;
 
@@ -85,17 +94,17 @@ namespace ContinuousCollisionLibrary
 	template<uint32 Iwidth, uint32 IcenterX, uint32 IcenterY>
 	static constexpr std::array<uint8, Iwidth* Iwidth> calculate_afinity_for_tiles()
 	{
-		static constexpr std::array<uint32, Iwidth* Iwidth> spiral_index_lookup = calculate_spiral_index_lookup<Iwidth, IcenterX, IcenterY>();
+		constexpr std::array<uint32, Iwidth* Iwidth> spiral_index_lookup = calculate_spiral_index_lookup<Iwidth, IcenterX, IcenterY>();
 
 		uint32 lowwer_bit_masks = 0b111;
 
 		//create lookup
 		std::array<uint8, Iwidth* Iwidth> spiral_afinity_lookup = {};
 
-		//store only the bottom 3 bits which go from 0 to 1 
-		for (int i = 0; i < spiral_afinity_lookup.size; ++i)
+		//store only the bottom 3 bits which go from 0 to 1
+		for (uint32 i = 0; i < spiral_afinity_lookup.size(); ++i)
 		{
-			spiral_afinity_lookup[i] = spiral_index_lookup[i] & lowwer_bit_masks;
+			spiral_afinity_lookup[i] = static_cast<uint8>(spiral_index_lookup[i] & lowwer_bit_masks);
 		}
 
 		return spiral_afinity_lookup;
@@ -105,7 +114,50 @@ namespace ContinuousCollisionLibrary
 	template<uint32 Iwidth, uint32 IcenterX, uint32 IcenterY>
 	struct spiral_index_lookup_table
 	{
-		//lookup table for converting from byte index in a 16 x 16 grid to a spiral index centered on the given xy value 
+		//lookup table for converting from byte index in a 16 x 16 grid to a spiral index centered on the given xy value
 		static constexpr std::array<uint8, Iwidth* Iwidth> spiral_index_lookup = calculate_afinity_for_tiles<Iwidth, IcenterX,IcenterY>();
 	};
-}
\ No newline at end of file
+
+	//the offsets of all the tiles within Iring_count rings of a center tile in the order the spiral visits them
+	//used to walk outwards from a point one ring at a time
+	template<uint32 Iring_count>
+	struct spiral_offset_lookup_table
+	{
+		static constexpr uint32 ring_count = Iring_count;
+
+		static constexpr uint32 width = (Iring_count * 2) + 1;
+
+		static constexpr uint32 tile_count = width * width;
+
+		//offset from the center tile, the center is the first entry
+		static constexpr std::array<math_2d_util::ivec2d, tile_count> offsets = []()
+			{
+				std::array<math_2d_util::ivec2d, tile_count> out_offsets = {};
+
+				uint32 write_index = 1;
+
+				for_each_spiral_coordinate(math_2d_util::ivec2d{ 0, 0 }, Iring_count, [&](const math_2d_util::ivec2d& offset, uint32 ring)
+					{
+						out_offsets[write_index++] = offset;
+					});
+
+				return out_offsets;
+			}();
+
+		//index of the first offset in each ring, the extra entry is the end of the last ring
+		static constexpr std::array<uint32, Iring_count + 2> ring_start = []()
+			{
+				std::array<uint32, Iring_count + 2> out_ring_start = {};
+
+				//ring n is a square of width 2n + 1 so everything before it is a square of width 2n - 1
+				for (uint32 iring = 1; iring < Iring_count + 2; ++iring)
+				{
+					uint32 inner_width = (iring * 2) - 1;
+
+					out_ring_start[iring] = inner_width * inner_width;
+				}
+
+				return out_ring_start;
+			}();
+	};
+}
@@ -0,0 +1,652 @@
+#pragma once
+#include <span>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <algorithm>
+#include <assert.h>
+#include <type_traits>
+
+#include "base_types_definition.h"
+#include "continuous_collision_library/physics_numeric_policy.h"
+#include "continuous_collision_library/fixed_point_simd.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+//time of impact for pairs of moving circles, used to stop fast colliders tunnelling through each other
+//all times are a fraction of the step, 0 = hit at the start of the step, 1 = no hit this step
+
+namespace ContinuousCollisionLibrary
+{
+	struct swept_circle_time_of_impact
+	{
+		//number of pairs tested at once, avx2 needs /arch:AVX2 otherwise we fall back to sse2 then scalar
+#if defined(__AVX2__)
+		static constexpr uint32 simd_width = 8;
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		static constexpr uint32 simd_width = 4;
+#else
+		static constexpr uint32 simd_width = 1;
+#endif
+
+		static constexpr float no_impact = 1.0f;
+
+		//time of impact for b moving relative to a
+		//offset = b position - a position, move = (b velocity - a velocity) * time step
+		//circles that already overlap and are still closing return 0 so they dont sink any deeper
+		static float calculate(float offset_x, float offset_y, float move_x, float move_y, float combined_radius);
+
+		//time of impact for a batch of pairs
+		//the position, velocity and radius spans are the full collider arrays and index_a / index_b are the addresses of each pair in those arrays
+		static void calculate_for_pairs(
+			std::span<const float> x,
+			std::span<const float> y,
+			std::span<const float> velocity_x,
+			std::span<const float> velocity_y,
+			std::span<const float> radius,
+			std::span<const uint32> index_a,
+			std::span<const uint32> index_b,
+			float time_step,
+			std::span<float> time_of_impact_out);
+
+		//fixed point versions for the deterministic numeric policy, the squared terms are kept in int64 so nothing overflows
+		template<uint32 Ifraction_bits>
+		static fixed_point<Ifraction_bits> calculate(fixed_point<Ifraction_bits> offset_x, fixed_point<Ifraction_bits> offset_y, fixed_point<Ifraction_bits> move_x, fixed_point<Ifraction_bits> move_y, fixed_point<Ifraction_bits> combined_radius);
+
+		//the fraction bits are picked up from the time step
+		//everything is done in simd, the square root and divide are done in double then fixed up to the exact integer results
+		//so the results are bit identical to the single version
+		//avx2 solves every lane in registers, sse2 queues up the pairs closing from outside each other and solves them a register at a time
+		template<uint32 Ifraction_bits>
+		static void calculate_for_pairs(
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> x,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> y,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> velocity_x,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> velocity_y,
+			std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> radius,
+			std::span<const uint32> index_a,
+			std::span<const uint32> index_b,
+			fixed_point<Ifraction_bits> time_step,
+			std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> time_of_impact_out);
+
+	private:
+
+		//the rest of the fixed point solve once the quadratic terms have been worked out, these have twice the fraction bits
+		template<uint32 Ifraction_bits>
+		static fixed_point<Ifraction_bits> solve(int64 c, int64 half_b, int64 a);
+
+		//numerator / denominator rounded towards 0 for positive values, worked out from a double quotient the caller has already taken
+		//and fixed up so it always matches the integer divide, values a double cant hold exactly fall back to the integer divide
+		static int64 divide_from_estimate(int64 numerator, int64 denominator, double quotient_estimate);
+
+		//closing pairs queued by the sse2 batch version waiting for their square root and divide
+		static constexpr uint32 solve_batch_size = 64;
+
+#if defined(__AVX2__)
+		//solve for 4 pairs at once from their int64 terms, the same as solve but worked out in double where every value is an exact integer
+		//out_of_range gets the lanes with terms too big for that, the results for those lanes are garbage and they have to go through solve
+		template<uint32 Ifraction_bits>
+		static __m128i solve_wide(__m256i c, __m256i half_b, __m256i a, __m256i& out_of_range);
+#endif
+	};
+
+	inline float swept_circle_time_of_impact::calculate(float offset_x, float offset_y, float move_x, float move_y, float combined_radius)
+	{
+		//solving |offset + move * t| = combined radius for the smallest t
+		float c = ((offset_x * offset_x) + (offset_y * offset_y)) - (combined_radius * combined_radius);
+		float half_b = (offset_x * move_x) + (offset_y * move_y);
+		float a = (move_x * move_x) + (move_y * move_y);
+
+		float discriminant = (half_b * half_b) - (a * c);
+
+		bool is_overlapping = c <= 0.0f;
+		bool is_closing = half_b < 0.0f;
+
+		if (is_overlapping)
+		{
+			return is_closing ? 0.0f : no_impact;
+		}
+
+		if (!is_closing || discriminant < 0.0f)
+		{
+			return no_impact;
+		}
+
+		//same root as (-b - sqrt(d)) / a but does not blow up when the move is tiny
+		float time_of_impact = c / (std::sqrt(discriminant) - half_b);
+
+		return std::min(time_of_impact, no_impact);
+	}
+
+	inline void swept_circle_time_of_impact::calculate_for_pairs(
+		std::span<const float> x,
+		std::span<const float> y,
+		std::span<const float> velocity_x,
+		std::span<const float> velocity_y,
+		std::span<const float> radius,
+		std::span<const uint32> index_a,
+		std::span<const uint32> index_b,
+		float time_step,
+		std::span<float> time_of_impact_out)
+	{
+		assert(index_a.size() == index_b.size());
+		assert(time_of_impact_out.size() >= index_a.size());
+
+		uint32 pair_count = static_cast<uint32>(index_a.size());
+		uint32 pair_index = 0;
+
+#if defined(__AVX2__)
+		{
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(no_impact);
+			const __m256 step = _mm256_set1_ps(time_step);
+
+			for (; pair_index + simd_width <= pair_count; pair_index += simd_width)
+			{
+				__m256i address_a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index_a.data() + pair_index));
+				__m256i address_b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index_b.data() + pair_index));
+
+				//gather the pair data out of the collider arrays
+				__m256 offset_x = _mm256_sub_ps(_mm256_i32gather_ps(x.data(), address_b, 4), _mm256_i32gather_ps(x.data(), address_a, 4));
+				__m256 offset_y = _mm256_sub_ps(_mm256_i32gather_ps(y.data(), address_b, 4), _mm256_i32gather_ps(y.data(), address_a, 4));
+
+				__m256 move_x = _mm256_mul_ps(_mm256_sub_ps(_mm256_i32gather_ps(velocity_x.data(), address_b, 4), _mm256_i32gather_ps(velocity_x.data(), address_a, 4)), step);
+				__m256 move_y = _mm256_mul_ps(_mm256_sub_ps(_mm256_i32gather_ps(velocity_y.data(), address_b, 4), _mm256_i32gather_ps(velocity_y.data(), address_a, 4)), step);
+
+				__m256 combined_radius = _mm256_add_ps(_mm256_i32gather_ps(radius.data(), address_b, 4), _mm256_i32gather_ps(radius.data(), address_a, 4));
+
+				__m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(offset_x, offset_x), _mm256_mul_ps(offset_y, offset_y)), _mm256_mul_ps(combined_radius, combined_radius));
+				__m256 half_b = _mm256_add_ps(_mm256_mul_ps(offset_x, move_x), _mm256_mul_ps(offset_y, move_y));
+				__m256 a = _mm256_add_ps(_mm256_mul_ps(move_x, move_x), _mm256_mul_ps(move_y, move_y));
+
+				__m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(half_b, half_b), _mm256_mul_ps(a, c));
+
+				__m256 is_overlapping = _mm256_cmp_ps(c, zero, _CMP_LE_OQ);
+				__m256 is_closing = _mm256_cmp_ps(half_b, zero, _CMP_LT_OQ);
+				__m256 is_hit = _mm256_and_ps(is_closing, _mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ));
+
+				//lanes that dont hit may divide by 0 here but they get masked out below
+				__m256 time_of_impact = _mm256_div_ps(c, _mm256_sub_ps(_mm256_sqrt_ps(_mm256_max_ps(discriminant, zero)), half_b));
+				time_of_impact = _mm256_min_ps(time_of_impact, one);
+
+				__m256 result = _mm256_blendv_ps(one, time_of_impact, is_hit);
+				result = _mm256_blendv_ps(result, one, _mm256_andnot_ps(is_closing, is_overlapping));
+				result = _mm256_blendv_ps(result, zero, _mm256_and_ps(is_closing, is_overlapping));
+
+				_mm256_storeu_ps(time_of_impact_out.data() + pair_index, result);
+			}
+		}
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(no_impact);
+			const __m128 step = _mm_set1_ps(time_step);
+
+			//sse2 has no blend so do it with masks
+			auto select = [](__m128 mask, __m128 if_true, __m128 if_false) { return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false)); };
+
+			//sse2 has no gather either
+			auto gather = [&](std::span<const float> values, const uint32* address) { return _mm_set_ps(values[address[3]], values[address[2]], values[address[1]], values[address[0]]); };
+
+			for (; pair_index + simd_width <= pair_count; pair_index += simd_width)
+			{
+				const uint32* address_a = index_a.data() + pair_index;
+				const uint32* address_b = index_b.data() + pair_index;
+
+				__m128 offset_x = _mm_sub_ps(gather(x, address_b), gather(x, address_a));
+				__m128 offset_y = _mm_sub_ps(gather(y, address_b), gather(y, address_a));
+
+				__m128 move_x = _mm_mul_ps(_mm_sub_ps(gather(velocity_x, address_b), gather(velocity_x, address_a)), step);
+				__m128 move_y = _mm_mul_ps(_mm_sub_ps(gather(velocity_y, address_b), gather(velocity_y, address_a)), step);
+
+				__m128 combined_radius = _mm_add_ps(gather(radius, address_b), gather(radius, address_a));
+
+				__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(offset_x, offset_x), _mm_mul_ps(offset_y, offset_y)), _mm_mul_ps(combined_radius, combined_radius));
+				__m128 half_b = _mm_add_ps(_mm_mul_ps(offset_x, move_x), _mm_mul_ps(offset_y, move_y));
+				__m128 a = _mm_add_ps(_mm_mul_ps(move_x, move_x), _mm_mul_ps(move_y, move_y));
+
+				__m128 discriminant = _mm_sub_ps(_mm_mul_ps(half_b, half_b), _mm_mul_ps(a, c));
+
+				__m128 is_overlapping = _mm_cmple_ps(c, zero);
+				__m128 is_closing = _mm_cmplt_ps(half_b, zero);
+				__m128 is_hit = _mm_and_ps(is_closing, _mm_cmpge_ps(discriminant, zero));
+
+				//lanes that dont hit may divide by 0 here but they get masked out below
+				__m128 time_of_impact = _mm_div_ps(c, _mm_sub_ps(_mm_sqrt_ps(_mm_max_ps(discriminant, zero)), half_b));
+				time_of_impact = _mm_min_ps(time_of_impact, one);
+
+				__m128 result = select(is_hit, time_of_impact, one);
+				result = select(_mm_andnot_ps(is_closing, is_overlapping), one, result);
+				result = select(_mm_and_ps(is_closing, is_overlapping), zero, result);
+
+				_mm_storeu_ps(time_of_impact_out.data() + pair_index, result);
+			}
+		}
+#endif
+
+		//finish off the pairs that did not fill a whole register
+		for (; pair_index < pair_count; ++pair_index)
+		{
+			uint32 a = index_a[pair_index];
+			uint32 b = index_b[pair_index];
+
+			time_of_impact_out[pair_index] = calculate(
+				x[b] - x[a],
+				y[b] - y[a],
+				(velocity_x[b] - velocity_x[a]) * time_step,
+				(velocity_y[b] - velocity_y[a]) * time_step,
+				radius[a] + radius[b]);
+		}
+	}
+
+	template<uint32 Ifraction_bits>
+	inline fixed_point<Ifraction_bits> swept_circle_time_of_impact::calculate(fixed_point<Ifraction_bits> offset_x, fixed_point<Ifraction_bits> offset_y, fixed_point<Ifraction_bits> move_x, fixed_point<Ifraction_bits> move_y, fixed_point<Ifraction_bits> combined_radius)
+	{
+		//same as the float version, these have twice the fraction bits
+		int64 c = ((static_cast<int64>(offset_x.raw) * offset_x.raw) + (static_cast<int64>(offset_y.raw) * offset_y.raw)) - (static_cast<int64>(combined_radius.raw) * combined_radius.raw);
+		int64 half_b = (static_cast<int64>(offset_x.raw) * move_x.raw) + (static_cast<int64>(offset_y.raw) * move_y.raw);
+		int64 a = (static_cast<int64>(move_x.raw) * move_x.raw) + (static_cast<int64>(move_y.raw) * move_y.raw);
+
+		return solve<Ifraction_bits>(c, half_b, a);
+	}
+
+	template<uint32 Ifraction_bits>
+	inline fixed_point<Ifraction_bits> swept_circle_time_of_impact::solve(int64 c, int64 half_b, int64 a)
+	{
+		using fixed_type = fixed_point<Ifraction_bits>;
+
+		constexpr fixed_type fixed_no_impact = fixed_type(no_impact);
+
+		bool is_overlapping = c <= 0;
+		bool is_closing = half_b < 0;
+
+		if (is_overlapping)
+		{
+			return is_closing ? fixed_type() : fixed_no_impact;
+		}
+
+		if (!is_closing)
+		{
+			return fixed_no_impact;
+		}
+
+		//drop back to the normal fraction bits before squaring again so the discriminant fits in int64
+		c >>= Ifraction_bits;
+		half_b >>= Ifraction_bits;
+		a >>= Ifraction_bits;
+
+		int64 discriminant = (half_b * half_b) - (a * c);
+
+		if (discriminant < 0)
+		{
+			return fixed_no_impact;
+		}
+
+		//half_b is still negative after the shift so this is always at least 1
+		int64 denominator = static_cast<int64>(fixed_type::integer_square_root(static_cast<uint64>(discriminant))) - half_b;
+
+		int64 numerator = c << Ifraction_bits;
+
+		int64 time_of_impact = divide_from_estimate(numerator, denominator, static_cast<double>(numerator) / static_cast<double>(denominator));
+
+		return fixed_type::from_raw(static_cast<int32>(std::min<int64>(time_of_impact, fixed_no_impact.raw)));
+	}
+
+	inline int64 swept_circle_time_of_impact::divide_from_estimate(int64 numerator, int64 denominator, double quotient_estimate)
+	{
+		constexpr int64 max_exact_double = int64(1) << 53;
+
+		if ((numerator >= max_exact_double) || (denominator >= max_exact_double))
+		{
+			return numerator / denominator;
+		}
+
+		//the double quotient of exact inputs is correctly rounded so it is at most 1 out after truncating
+		int64 quotient = static_cast<int64>(quotient_estimate);
+
+		if (quotient * denominator > numerator)
+		{
+			--quotient;
+		}
+		else if ((quotient + 1) * denominator <= numerator)
+		{
+			++quotient;
+		}
+
+		return quotient;
+	}
+
+#if defined(__AVX2__)
+	template<uint32 Ifraction_bits>
+	inline __m128i swept_circle_time_of_impact::solve_wide(__m256i c, __m256i half_b, __m256i a, __m256i& out_of_range)
+	{
+		//only the lanes closing from outside each other are used so c and a are positive and half_b is negative
+		//avx2 has no 64 bit arithmetic shift so half_b is flipped around a logical one, which rounds down the same way
+		const __m256i all_bits = _mm256_set1_epi64x(-1);
+
+		__m256i flipped_half_b = _mm256_srli_epi64(_mm256_xor_si256(half_b, all_bits), Ifraction_bits);
+
+		c = _mm256_srli_epi64(c, Ifraction_bits);
+		a = _mm256_srli_epi64(a, Ifraction_bits);
+		half_b = _mm256_xor_si256(flipped_half_b, all_bits);
+
+		//no int64 to double convert before avx512, adding to the bits of 2^52 + 2^51 and taking it off again works for anything below 2^51
+		const __m256i magic_bits = _mm256_set1_epi64x(0x4338000000000000);
+		const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+
+		auto to_double = [&](__m256i value) { return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(value, magic_bits)), magic); };
+
+		__m256d c_value = to_double(c);
+		__m256d half_b_value = to_double(half_b);
+		__m256d a_value = to_double(a);
+
+		const __m256d zero_value = _mm256_setzero_pd();
+		const __m256d one_value = _mm256_set1_pd(1.0);
+
+		__m256d half_b_squared = _mm256_mul_pd(half_b_value, half_b_value);
+		__m256d a_times_c = _mm256_mul_pd(a_value, c_value);
+
+		//with both products below 2^52 they are exact and so is everything after them, the numerator is only scaled by a power of 2
+		//a rounded product cant land below 2^52 if the real one is above it so checking the doubles is enough
+		const __m256d max_exact_value = _mm256_set1_pd(4503599627370496.0);
+
+		out_of_range = _mm256_or_si256(
+			_mm256_cmpgt_epi64(_mm256_or_si256(_mm256_or_si256(c, a), flipped_half_b), _mm256_set1_epi64x((int64(1) << 51) - 1)),
+			_mm256_castpd_si256(_mm256_cmp_pd(_mm256_max_pd(half_b_squared, a_times_c), max_exact_value, _CMP_GE_OQ)));
+
+		__m256d discriminant = _mm256_sub_pd(half_b_squared, a_times_c);
+
+		__m256d is_hit = _mm256_cmp_pd(discriminant, zero_value, _CMP_GE_OQ);
+
+		//for integers below 2^52 the sqrt rounded to the nearest double never reaches the next whole number
+		//so truncating it gives the same root as integer_square_root without any fix up
+		__m256d root = _mm256_round_pd(_mm256_sqrt_pd(_mm256_max_pd(discriminant, zero_value)), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+
+		//half_b is still negative after the shift so this is always at least 1
+		__m256d denominator = _mm256_sub_pd(root, half_b_value);
+		__m256d numerator = _mm256_mul_pd(c_value, _mm256_set1_pd(static_cast<double>(int64(1) << Ifraction_bits)));
+
+		//the rounded quotient can only land on the whole number above the real one, never below it
+		//so this is the one sided version of the fix up in divide_from_estimate
+		//the product is exact for anything under no impact and anything over it gets clamped to no impact either way
+		__m256d quotient = _mm256_round_pd(_mm256_div_pd(numerator, denominator), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+
+		quotient = _mm256_sub_pd(quotient, _mm256_and_pd(_mm256_cmp_pd(_mm256_mul_pd(quotient, denominator), numerator, _CMP_GT_OQ), one_value));
+
+		const __m256d no_impact_value = _mm256_set1_pd(static_cast<double>(fixed_point<Ifraction_bits>(no_impact).raw));
+
+		__m256d time_of_impact = _mm256_blendv_pd(no_impact_value, _mm256_min_pd(quotient, no_impact_value), is_hit);
+
+		return _mm256_cvttpd_epi32(time_of_impact);
+	}
+#endif
+
+	template<uint32 Ifraction_bits>
+	inline void swept_circle_time_of_impact::calculate_for_pairs(
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> x,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> y,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> velocity_x,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> velocity_y,
+		std::type_identity_t<std::span<const fixed_point<Ifraction_bits>>> radius,
+		std::span<const uint32> index_a,
+		std::span<const uint32> index_b,
+		fixed_point<Ifraction_bits> time_step,
+		std::type_identity_t<std::span<fixed_point<Ifraction_bits>>> time_of_impact_out)
+	{
+		assert(index_a.size() == index_b.size());
+		assert(time_of_impact_out.size() >= index_a.size());
+
+		using lanes = fixed_point_simd<Ifraction_bits>;
+
+		uint32 pair_count = static_cast<uint32>(index_a.size());
+		uint32 pair_index = 0;
+
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		{
+			using lanes_type = typename lanes::lanes_type;
+
+			//the terms of the even lanes then the odd lanes
+			alignas(sizeof(lanes_type)) std::array<int64, simd_width> c_terms;
+			alignas(sizeof(lanes_type)) std::array<int64, simd_width> half_b_terms;
+			alignas(sizeof(lanes_type)) std::array<int64, simd_width> a_terms;
+
+			constexpr uint32 half_width = simd_width / 2;
+
+#if !defined(__AVX2__)
+			//closing pairs waiting to be solved, a block can add a whole register of pairs after the queue is nearly full
+			constexpr uint32 solve_capacity = solve_batch_size + simd_width;
+
+			alignas(16) std::array<double, solve_capacity> solve_values;
+			alignas(16) std::array<double, solve_capacity> solve_divisors;
+			std::array<int64, solve_capacity> solve_discriminants;
+			std::array<int64, solve_capacity> solve_numerators;
+			std::array<int64, solve_capacity> solve_half_bs;
+			std::array<uint32, solve_capacity> solve_pair_indexes;
+
+			uint32 solve_count = 0;
+
+			constexpr uint32 double_width = 2;
+
+			auto square_root_doubles = [](double* values) { _mm_store_pd(values, _mm_sqrt_pd(_mm_load_pd(values))); };
+			auto divide_doubles = [](double* values, const double* divisors) { _mm_store_pd(values, _mm_div_pd(_mm_load_pd(values), _mm_load_pd(divisors))); };
+
+			//ieee sqrt and divide are correctly rounded so the fix ups land on the same integers as the single version every time
+			auto solve_queued_pairs = [&]()
+				{
+					//pad out to a whole register with values that cant raise any floating point exceptions
+					uint32 padded_count = (solve_count + double_width - 1) & ~(double_width - 1);
+
+					std::fill(solve_values.begin() + solve_count, solve_values.begin() + padded_count, 0.0);
+					std::fill(solve_divisors.begin() + solve_count, solve_divisors.begin() + padded_count, 1.0);
+
+					for (uint32 i = 0; i < solve_count; i += double_width)
+					{
+						square_root_doubles(solve_values.data() + i);
+					}
+
+					for (uint32 i = 0; i < solve_count; ++i)
+					{
+						//half_b is still negative after the shift so this is always at least 1
+						int64 denominator = static_cast<int64>(fixed_point<Ifraction_bits>::integer_square_root_from_estimate(static_cast<uint64>(solve_discriminants[i]), solve_values[i])) - solve_half_bs[i];
+
+						solve_values[i] = static_cast<double>(solve_numerators[i]);
+						solve_divisors[i] = static_cast<double>(denominator);
+
+						//keep the exact denominator for the fix up
+						solve_half_bs[i] = denominator;
+					}
+
+					for (uint32 i = 0; i < solve_count; i += double_width)
+					{
+						divide_doubles(solve_values.data() + i, solve_divisors.data() + i);
+					}
+
+					for (uint32 i = 0; i < solve_count; ++i)
+					{
+						int64 time_of_impact = divide_from_estimate(solve_numerators[i], solve_half_bs[i], solve_values[i]);
+
+						time_of_impact_out[solve_pair_indexes[i]] = fixed_point<Ifraction_bits>::from_raw(static_cast<int32>(std::min<int64>(time_of_impact, fixed_point<Ifraction_bits>(no_impact).raw)));
+					}
+
+					solve_count = 0;
+				};
+#endif
+
+#if defined(__AVX2__)
+			const __m256i step = _mm256_set1_epi32(time_step.raw);
+			const __m256i no_impact_lanes = _mm256_set1_epi32(fixed_point<Ifraction_bits>(no_impact).raw);
+			const __m256i one_wide = _mm256_set1_epi64x(1);
+
+			auto add = [](__m256i a, __m256i b) { return _mm256_add_epi32(a, b); };
+			auto sub = [](__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); };
+			auto add_wide = [](__m256i a, __m256i b) { return _mm256_add_epi64(a, b); };
+			auto sub_wide = [](__m256i a, __m256i b) { return _mm256_sub_epi64(a, b); };
+			auto and_not = [](__m256i mask, __m256i value) { return _mm256_andnot_si256(mask, value); };
+			auto both = [](__m256i a, __m256i b) { return _mm256_and_si256(a, b); };
+			auto store = [](void* out, __m256i value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), value); };
+			auto lane_mask = [](__m256i mask) { return static_cast<uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))); };
+#else
+			const __m128i step = _mm_set1_epi32(time_step.raw);
+			const __m128i no_impact_lanes = _mm_set1_epi32(fixed_point<Ifraction_bits>(no_impact).raw);
+			const __m128i one_wide = _mm_set1_epi64x(1);
+
+			auto add = [](__m128i a, __m128i b) { return _mm_add_epi32(a, b); };
+			auto sub = [](__m128i a, __m128i b) { return _mm_sub_epi32(a, b); };
+			auto add_wide = [](__m128i a, __m128i b) { return _mm_add_epi64(a, b); };
+			auto sub_wide = [](__m128i a, __m128i b) { return _mm_sub_epi64(a, b); };
+			auto and_not = [](__m128i mask, __m128i value) { return _mm_andnot_si128(mask, value); };
+			auto both = [](__m128i a, __m128i b) { return _mm_and_si128(a, b); };
+			auto store = [](void* out, __m128i value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value); };
+			auto lane_mask = [](__m128i mask) { return static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(mask))); };
+#endif
+
+			for (; pair_index + simd_width <= pair_count; pair_index += simd_width)
+			{
+				const uint32* address_a = index_a.data() + pair_index;
+				const uint32* address_b = index_b.data() + pair_index;
+
+#if defined(__AVX2__)
+				__m256i lanes_a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address_a));
+				__m256i lanes_b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address_b));
+
+				auto gather = [](auto values, __m256i address) { return _mm256_i32gather_epi32(reinterpret_cast<const int*>(values.data()), address, 4); };
+#else
+				const uint32* lanes_a = address_a;
+				const uint32* lanes_b = address_b;
+
+				//sse2 has no gather
+				auto gather = [](auto values, const uint32* address) { return _mm_set_epi32(values[address[3]].raw, values[address[2]].raw, values[address[1]].raw, values[address[0]].raw); };
+#endif
+
+				lanes_type offset_x = sub(gather(x, lanes_b), gather(x, lanes_a));
+				lanes_type offset_y = sub(gather(y, lanes_b), gather(y, lanes_a));
+
+				lanes_type move_x = lanes::multiply(sub(gather(velocity_x, lanes_b), gather(velocity_x, lanes_a)), step);
+				lanes_type move_y = lanes::multiply(sub(gather(velocity_y, lanes_b), gather(velocity_y, lanes_a)), step);
+
+				lanes_type combined_radius = add(gather(radius, lanes_a), gather(radius, lanes_b));
+
+				//the terms need 64 bits so the even and odd lanes are worked out separately
+				lanes_type c_even = sub_wide(add_wide(lanes::multiply_wide_even(offset_x, offset_x), lanes::multiply_wide_even(offset_y, offset_y)), lanes::multiply_wide_even(combined_radius, combined_radius));
+				lanes_type c_odd = sub_wide(add_wide(lanes::multiply_wide_odd(offset_x, offset_x), lanes::multiply_wide_odd(offset_y, offset_y)), lanes::multiply_wide_odd(combined_radius, combined_radius));
+
+				lanes_type half_b_even = add_wide(lanes::multiply_wide_even(offset_x, move_x), lanes::multiply_wide_even(offset_y, move_y));
+				lanes_type half_b_odd = add_wide(lanes::multiply_wide_odd(offset_x, move_x), lanes::multiply_wide_odd(offset_y, move_y));
+
+				//c <= 0 is the same as c - 1 < 0, c is never near the bottom of the int64 range so this cant wrap
+				lanes_type is_overlapping = lanes::is_negative_wide(sub_wide(c_even, one_wide), sub_wide(c_odd, one_wide));
+				lanes_type is_closing = lanes::is_negative_wide(half_b_even, half_b_odd);
+
+				//everything but the pairs closing from outside each other is 0 or no impact
+				lanes_type result = and_not(both(is_overlapping, is_closing), no_impact_lanes);
+
+				lanes_type solve_lanes = and_not(is_overlapping, is_closing);
+
+				uint32 solve_mask = lane_mask(solve_lanes);
+
+				if (solve_mask == 0)
+				{
+					store(time_of_impact_out.data() + pair_index, result);
+
+					continue;
+				}
+
+				lanes_type a_even = add_wide(lanes::multiply_wide_even(move_x, move_x), lanes::multiply_wide_even(move_y, move_y));
+				lanes_type a_odd = add_wide(lanes::multiply_wide_odd(move_x, move_x), lanes::multiply_wide_odd(move_y, move_y));
+
+#if defined(__AVX2__)
+				__m256i even_out_of_range;
+				__m256i odd_out_of_range;
+
+				__m128i solved_even = solve_wide<Ifraction_bits>(c_even, half_b_even, a_even, even_out_of_range);
+				__m128i solved_odd = solve_wide<Ifraction_bits>(c_odd, half_b_odd, a_odd, odd_out_of_range);
+
+				//put the even and odd lanes back in order
+				__m256i solved = _mm256_set_m128i(_mm_unpackhi_epi32(solved_even, solved_odd), _mm_unpacklo_epi32(solved_even, solved_odd));
+
+				store(time_of_impact_out.data() + pair_index, _mm256_blendv_epi8(result, solved, solve_lanes));
+
+				//only the lanes with terms too big to be exact in a double are left for the scalar solve
+				solve_mask &= lane_mask(_mm256_blend_epi32(even_out_of_range, odd_out_of_range, 0b10101010));
+
+				if (solve_mask == 0)
+				{
+					continue;
+				}
+#else
+				store(time_of_impact_out.data() + pair_index, result);
+#endif
+
+				store(c_terms.data(), c_even);
+				store(c_terms.data() + half_width, c_odd);
+				store(half_b_terms.data(), half_b_even);
+				store(half_b_terms.data() + half_width, half_b_odd);
+				store(a_terms.data(), a_even);
+				store(a_terms.data() + half_width, a_odd);
+
+				for (; solve_mask != 0; solve_mask &= solve_mask - 1)
+				{
+					uint32 lane = std::countr_zero(solve_mask);
+
+					uint32 term_index = (lane / 2) + ((lane % 2) * half_width);
+
+#if defined(__AVX2__)
+					time_of_impact_out[pair_index + lane] = solve<Ifraction_bits>(c_terms[term_index], half_b_terms[term_index], a_terms[term_index]);
+#else
+					//the same as solve, drop back to the normal fraction bits so the discriminant fits in int64
+					int64 c = c_terms[term_index] >> Ifraction_bits;
+					int64 half_b = half_b_terms[term_index] >> Ifraction_bits;
+					int64 a = a_terms[term_index] >> Ifraction_bits;
+
+					int64 discriminant = (half_b * half_b) - (a * c);
+
+					if (discriminant < 0)
+					{
+						time_of_impact_out[pair_index + lane] = fixed_point<Ifraction_bits>(no_impact);
+
+						continue;
+					}
+
+					solve_values[solve_count] = static_cast<double>(discriminant);
+					solve_discriminants[solve_count] = discriminant;
+					solve_numerators[solve_count] = c << Ifraction_bits;
+					solve_half_bs[solve_count] = half_b;
+					solve_pair_indexes[solve_count] = pair_index + lane;
+
+					++solve_count;
+#endif
+				}
+
+#if !defined(__AVX2__)
+				if (solve_count >= solve_batch_size)
+				{
+					solve_queued_pairs();
+				}
+#endif
+			}
+
+#if !defined(__AVX2__)
+			solve_queued_pairs();
+#endif
+		}
+#endif
+
+		//finish off the pairs that did not fill a whole register
+		for (; pair_index < pair_count; ++pair_index)
+		{
+			uint32 a = index_a[pair_index];
+			uint32 b = index_b[pair_index];
+
+			time_of_impact_out[pair_index] = calculate(
+				x[b] - x[a],
+				y[b] - y[a],
+				(velocity_x[b] - velocity_x[a]) * time_step,
+				(velocity_y[b] - velocity_y[a]) * time_step,
+				radius[a] + radius[b]);
+		}
+	}
+}
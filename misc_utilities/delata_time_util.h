@@ -1,12 +1,11 @@
 #pragma once
-#define NOMINMAX
-#include <Windows.h>
+#include <chrono>
 
 struct delata_time_util
 {
 private:
-    // Global variables
-    DWORD prevTime = 0;
+    //steady_clock is high resolution on every platform, GetTickCount only ticked every 10 to 16 ms
+    std::chrono::steady_clock::time_point prevTime;
     
     float delta_time = 1.0f/60.0f;
 
@@ -14,14 +13,14 @@ public:
 
     delata_time_util()
     {
-        prevTime = GetTickCount();
+        prevTime = std::chrono::steady_clock::now();
     }
 
     // Function to calculate delta time
     float update_delta_time()
     {
-        DWORD currentTime = GetTickCount();
-        float deltaTime = (currentTime - prevTime) / 1000.0f; // Convert milliseconds to seconds
+        std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+        float deltaTime = std::chrono::duration<float>(currentTime - prevTime).count(); // Convert to seconds
         prevTime = currentTime;
         return deltaTime;
     }
@@ -30,4 +29,4 @@ public:
     {
         return delta_time;
     }
-};
\ No newline at end of file
+};
@@ -479,5 +479,57 @@ namespace MiscUtilities
 			grid_func.operator() < on_edge_template< false, false, true, true> > (x_max, y_max);
 
 		}
+
+		//same as above but for a single tile, used when the tiles are being handed out in a custom order (like across threads)
+		static void template_edge_corner_and_fill_function_for_tile(const uint32_t width, const uint32_t height, const uint32_t x, const uint32_t y, auto grid_func)
+		{
+			const bool left = x == 0;
+			const bool up = y == 0;
+			const bool right = x == (width - 1);
+			const bool down = y == (height - 1);
+
+			if (up)
+			{
+				if (left)
+				{
+					grid_func.operator() < on_edge_template< true, true, false, false> > (x, y);
+				}
+				else if (right)
+				{
+					grid_func.operator() < on_edge_template< false, true, true, false> > (x, y);
+				}
+				else
+				{
+					grid_func.operator() < on_edge_template< false, true, false, false> > (x, y);
+				}
+			}
+			else if (down)
+			{
+				if (left)
+				{
+					grid_func.operator() < on_edge_template< true, false, false, true> > (x, y);
+				}
+				else if (right)
+				{
+					grid_func.operator() < on_edge_template< false, false, true, true> > (x, y);
+				}
+				else
+				{
+					grid_func.operator() < on_edge_template< false, false, false, true> > (x, y);
+				}
+			}
+			else if (left)
+			{
+				grid_func.operator() < on_edge_template< true, false, false, false> > (x, y);
+			}
+			else if (right)
+			{
+				grid_func.operator() < on_edge_template< false, false, true, false> > (x, y);
+			}
+			else
+			{
+				grid_func.operator() < on_edge_template< false, false, false, false> > (x, y);
+			}
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <assert.h>
+
+//small persistent worker pool for running the same function over a range of jobs
+//the calling thread always takes part in the work so a pool of 1 worker never starts a thread
+
+namespace MiscUtilities
+{
+	class parallel_job_scheduler
+	{
+	public:
+
+		//0 = use all the hardware threads
+		explicit parallel_job_scheduler(uint32_t worker_count = 1);
+
+		~parallel_job_scheduler();
+
+		parallel_job_scheduler(const parallel_job_scheduler&) = delete;
+		parallel_job_scheduler& operator=(const parallel_job_scheduler&) = delete;
+
+		//stop the current worker threads and start the new number of workers
+		void set_worker_count(uint32_t worker_count);
+
+		//total number of workers including the calling thread
+		uint32_t get_worker_count() const;
+
+		//call job_func(job_index, worker_index) for every job in [0, job_count)
+		//returns once all jobs are done, worker_index is always < get_worker_count()
+		template<typename Tjob_func>
+		void parallel_for(uint32_t job_count, Tjob_func&& job_func);
+
+	private:
+
+		//type erased job so we dont need std::function / heap allocation per dispatch
+		using job_invoke_func_type = void(*)(void* job_context, uint32_t job_index, uint32_t worker_index);
+
+		std::vector<std::thread> worker_threads;
+
+		std::mutex dispatch_mutex;
+		std::condition_variable dispatch_signal;
+
+		//incremented every time new work is handed out
+		uint64_t dispatch_generation = 0;
+		bool is_shutting_down = false;
+
+		//the current batch of work
+		job_invoke_func_type job_invoke = nullptr;
+		void* job_context = nullptr;
+		uint32_t job_count = 0;
+
+		std::atomic<uint32_t> next_job_index = 0;
+		std::atomic<uint32_t> workers_still_running = 0;
+
+		void start_workers(uint32_t worker_count);
+
+		void stop_workers();
+
+		void worker_loop(uint32_t worker_index, uint64_t start_generation);
+
+		//grab jobs until there are none left
+		void run_jobs(uint32_t worker_index);
+	};
+
+	inline parallel_job_scheduler::parallel_job_scheduler(uint32_t worker_count)
+	{
+		start_workers(worker_count);
+	}
+
+	inline parallel_job_scheduler::~parallel_job_scheduler()
+	{
+		stop_workers();
+	}
+
+	inline void parallel_job_scheduler::set_worker_count(uint32_t worker_count)
+	{
+		stop_workers();
+		start_workers(worker_count);
+	}
+
+	inline uint32_t parallel_job_scheduler::get_worker_count() const
+	{
+		//+1 for the calling thread
+		return static_cast<uint32_t>(worker_threads.size()) + 1;
+	}
+
+	inline void parallel_job_scheduler::start_workers(uint32_t worker_count)
+	{
+		if (worker_count == 0)
+		{
+			worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		is_shutting_down = false;
+
+		//the calling thread is worker 0 so only start the extra threads
+		worker_threads.reserve(worker_count - 1);
+
+		for (uint32_t i = 1; i < worker_count; ++i)
+		{
+			worker_threads.emplace_back([this, i, start_generation = dispatch_generation]() { worker_loop(i, start_generation); });
+		}
+	}
+
+	inline void parallel_job_scheduler::stop_workers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(dispatch_mutex);
+			is_shutting_down = true;
+		}
+
+		dispatch_signal.notify_all();
+
+		std::for_each(worker_threads.begin(), worker_threads.end(), [](std::thread& worker) { worker.join(); });
+
+		worker_threads.clear();
+	}
+
+	inline void parallel_job_scheduler::worker_loop(uint32_t worker_index, uint64_t start_generation)
+	{
+		//workers started after a resize should not pick up the last batch again
+		uint64_t last_generation = start_generation;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(dispatch_mutex);
+
+				dispatch_signal.wait(lock, [&]() { return is_shutting_down || dispatch_generation != last_generation; });
+
+				if (is_shutting_down)
+				{
+					return;
+				}
+
+				last_generation = dispatch_generation;
+			}
+
+			run_jobs(worker_index);
+
+			//let the dispatching thread know we are done with this batch
+			workers_still_running.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	inline void parallel_job_scheduler::run_jobs(uint32_t worker_index)
+	{
+		for (uint32_t job_index = next_job_index.fetch_add(1, std::memory_order_relaxed); job_index < job_count; job_index = next_job_index.fetch_add(1, std::memory_order_relaxed))
+		{
+			job_invoke(job_context, job_index, worker_index);
+		}
+	}
+
+	template<typename Tjob_func>
+	inline void parallel_job_scheduler::parallel_for(uint32_t _job_count, Tjob_func&& job_func)
+	{
+		//not worth waking anyone up for
+		if (worker_threads.empty() || _job_count <= 1)
+		{
+			for (uint32_t i = 0; i < _job_count; ++i)
+			{
+				job_func(i, 0);
+			}
+
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(dispatch_mutex);
+
+			job_invoke = [](void* context, uint32_t job_index, uint32_t worker_index)
+				{
+					(*static_cast<std::remove_reference_t<Tjob_func>*>(context))(job_index, worker_index);
+				};
+
+			job_context = const_cast<void*>(static_cast<const void*>(std::addressof(job_func)));
+			job_count = _job_count;
+
+			next_job_index.store(0, std::memory_order_relaxed);
+			workers_still_running.store(static_cast<uint32_t>(worker_threads.size()), std::memory_order_relaxed);
+
+			++dispatch_generation;
+		}
+
+		dispatch_signal.notify_all();
+
+		//help out on the calling thread
+		run_jobs(0);
+
+		//wait for the rest of the workers to finish their last job
+		while (workers_still_running.load(std::memory_order_acquire) != 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
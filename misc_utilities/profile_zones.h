@@ -0,0 +1,231 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+//scoped timing markers for seeing where the time inside a step goes, each thread records into its own ring of events
+//define ENABLE_PROFILE_ZONES to record them, without it PROFILE_ZONE expands to nothing and costs nothing
+//write_chrome_trace dumps the rings as trace_event json that chrome://tracing and perfetto can open
+
+namespace MiscUtilities
+{
+	class profile_zone_recorder
+	{
+	public:
+		//events kept per thread before the oldest get overwritten, a power of 2 so wrapping is a mask
+		static constexpr uint64_t ring_size = 1 << 17;
+
+		struct zone_event
+		{
+			//has to live for the whole run, zones are always named with string literals
+			const char* name;
+			int64_t start_ticks;
+			int64_t duration_ticks;
+		};
+
+		//the cpu timestamp counter where there is one, steady_clock nanoseconds everywhere else
+		//zones around a single tile update are under a microsecond so the timestamp has to be a lot cheaper than steady_clock
+		static int64_t read_ticks();
+
+		//add a finished zone to the calling threads ring, no locks are taken
+		static void record(const char* name, int64_t start_ticks, int64_t end_ticks);
+
+		//write every event still in the rings as chrome trace_event json
+		//call it between steps, zones recorded while writing may be torn
+		//returns false if the file could not be written
+		static bool write_chrome_trace(const std::filesystem::path& path);
+
+		//drop all the recorded events, same rules as write_chrome_trace
+		static void clear();
+
+	private:
+
+		struct thread_ring
+		{
+			uint32_t thread_id = 0;
+
+			//only the owning thread writes, it publishes each event by storing the new count with release
+			std::atomic<uint64_t> write_count = 0;
+
+			std::array<zone_event, ring_size> events;
+		};
+
+		//every ring ever made, rings are kept until exit so threads that have stopped can still be dumped
+		//the lock is only taken the first time a thread records and when dumping
+		struct ring_registry
+		{
+			std::mutex registry_mutex;
+
+			std::vector<std::unique_ptr<thread_ring>> rings;
+
+			//taken together so the ticks can be turned into time when dumping
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			int64_t start_ticks = read_ticks();
+		};
+
+		static ring_registry& get_registry();
+
+		static thread_ring& get_thread_ring();
+	};
+
+	//records the time from construction to destruction as one zone
+	class scoped_profile_zone
+	{
+	private:
+		const char* name;
+		int64_t start_ticks;
+
+	public:
+		explicit scoped_profile_zone(const char* _name) :name(_name), start_ticks(profile_zone_recorder::read_ticks()) {}
+
+		~scoped_profile_zone()
+		{
+			profile_zone_recorder::record(name, start_ticks, profile_zone_recorder::read_ticks());
+		}
+
+		scoped_profile_zone(const scoped_profile_zone&) = delete;
+		scoped_profile_zone& operator=(const scoped_profile_zone&) = delete;
+	};
+
+	inline profile_zone_recorder::ring_registry& profile_zone_recorder::get_registry()
+	{
+		static ring_registry registry;
+
+		return registry;
+	}
+
+	inline profile_zone_recorder::thread_ring& profile_zone_recorder::get_thread_ring()
+	{
+		thread_local thread_ring* ring = []()
+			{
+				ring_registry& registry = get_registry();
+
+				std::scoped_lock lock(registry.registry_mutex);
+
+				//the rings are big so make them on the heap the first time each thread records
+				registry.rings.push_back(std::make_unique<thread_ring>());
+
+				registry.rings.back()->thread_id = static_cast<uint32_t>(registry.rings.size() - 1);
+
+				return registry.rings.back().get();
+			}();
+
+		return *ring;
+	}
+
+	inline int64_t profile_zone_recorder::read_ticks()
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		return static_cast<int64_t>(__rdtsc());
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	inline void profile_zone_recorder::record(const char* name, int64_t start_ticks, int64_t end_ticks)
+	{
+		thread_ring& ring = get_thread_ring();
+
+		uint64_t write_count = ring.write_count.load(std::memory_order_relaxed);
+
+		ring.events[write_count & (ring_size - 1)] = zone_event{ name, start_ticks, end_ticks - start_ticks };
+
+		ring.write_count.store(write_count + 1, std::memory_order_release);
+	}
+
+	inline bool profile_zone_recorder::write_chrome_trace(const std::filesystem::path& path)
+	{
+		std::ofstream file(path, std::ios::trunc);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		ring_registry& registry = get_registry();
+
+		std::scoped_lock lock(registry.registry_mutex);
+
+		//measure the tick rate over the whole recording, modern x86 timestamp counters tick at a fixed rate
+		int64_t elapsed_ticks = read_ticks() - registry.start_ticks;
+		double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - registry.start_time).count();
+
+		double us_per_tick = elapsed_ticks > 0 ? elapsed_us / static_cast<double>(elapsed_ticks) : 0.0;
+
+		//timestamps in trace_event json are in microseconds
+		file << std::fixed << std::setprecision(3);
+		file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+		bool is_first_event = true;
+
+		auto start_event = [&]()
+			{
+				file << (is_first_event ? "" : ",\n");
+
+				is_first_event = false;
+			};
+
+		for (const std::unique_ptr<thread_ring>& ring : registry.rings)
+		{
+			start_event();
+
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << ring->thread_id << ",\"args\":{\"name\":\"thread " << ring->thread_id << "\"}}";
+
+			uint64_t write_count = ring->write_count.load(std::memory_order_acquire);
+
+			//once the ring has wrapped only the newest ring_size events are left
+			uint64_t first_event = write_count > ring_size ? write_count - ring_size : 0;
+
+			for (uint64_t i = first_event; i < write_count; ++i)
+			{
+				const zone_event& event = ring->events[i & (ring_size - 1)];
+
+				start_event();
+
+				file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << ring->thread_id
+					<< ",\"ts\":" << (static_cast<double>(event.start_ticks - registry.start_ticks) * us_per_tick)
+					<< ",\"dur\":" << (static_cast<double>(event.duration_ticks) * us_per_tick) << "}";
+			}
+		}
+
+		file << "\n]}\n";
+
+		return static_cast<bool>(file.flush());
+	}
+
+	inline void profile_zone_recorder::clear()
+	{
+		ring_registry& registry = get_registry();
+
+		std::scoped_lock lock(registry.registry_mutex);
+
+		for (const std::unique_ptr<thread_ring>& ring : registry.rings)
+		{
+			ring->write_count.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+
+#if defined(ENABLE_PROFILE_ZONES)
+#define PROFILE_ZONE(name) MiscUtilities::scoped_profile_zone PROFILE_ZONE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
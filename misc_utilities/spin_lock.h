@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <thread>
+
+namespace MiscUtilities
+{
+	//minimal lock for guarding very short critical sections like handing out memory pages
+	//copying a lock gives you a new unlocked lock so structures holding one can still be copied
+	struct spin_lock
+	{
+	private:
+		std::atomic_flag lock_flag;
+
+	public:
+
+		spin_lock() {};
+
+		spin_lock(const spin_lock&) {};
+
+		spin_lock& operator=(const spin_lock&) { return *this; };
+
+		void lock()
+		{
+			while (lock_flag.test_and_set(std::memory_order_acquire))
+			{
+				//wait on a plain read so we dont keep bouncing the cache line between cores
+				while (lock_flag.test(std::memory_order_relaxed))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void unlock()
+		{
+			lock_flag.clear(std::memory_order_release);
+		}
+	};
+
+	//lock the spin lock for the life of the scope
+	struct scoped_spin_lock
+	{
+	private:
+		spin_lock& target_lock;
+
+	public:
+		scoped_spin_lock(spin_lock& _target_lock) :target_lock(_target_lock)
+		{
+			target_lock.lock();
+		}
+
+		~scoped_spin_lock()
+		{
+			target_lock.unlock();
+		}
+
+		scoped_spin_lock(const scoped_spin_lock&) = delete;
+		scoped_spin_lock& operator=(const scoped_spin_lock&) = delete;
+	};
+}
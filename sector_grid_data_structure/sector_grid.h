@@ -100,6 +100,8 @@ namespace SectorGrid
 		//get a ref to the data at a sector tile index
 		TDataType& get_ref_to_data(const sector_tile_index<TSectorGridDimensions>& index);
 
+		const TDataType& get_ref_to_data(const sector_tile_index<TSectorGridDimensions>& index) const;
+
 		void set_data(const sector_tile_index<TSectorGridDimensions>& index, const TDataType& data_to_set);
 
 		constexpr template_sector_grid() = default;
@@ -123,6 +125,12 @@ namespace SectorGrid
 		return data.tile_data[index.index];
 	}
 
+	template<typename TDataType, sector_grid_dimension_concept TSectorGridDimensions>
+	inline const TDataType& template_sector_grid<TDataType, TSectorGridDimensions>::get_ref_to_data(const sector_tile_index<TSectorGridDimensions>& index) const
+	{
+		return data.tile_data[index.index];
+	}
+
 	template<typename TDataType, sector_grid_dimension_concept TSectorGridDimensions>
 	inline void template_sector_grid<TDataType, TSectorGridDimensions>::set_data(const sector_tile_index<TSectorGridDimensions>& index, const TDataType& data_to_set)
 	{